@@ -4,15 +4,16 @@
 echo "正在编译交互式密钥交换演示程序..."
 echo ""
 
-gcc -O3 -Wall -Isrc -o interactive_key_exchange.exe \
+gcc -O3 -Wall -Isrc -DFP256_RUNTIME_DISPATCH -o interactive_key_exchange.exe \
     interactive_key_exchange.c \
     src/fp256.c \
+    src/fp256_safegcd.c \
     src/edwards256.c \
     src/edwards256_action.c \
     src/mont_field.c \
     src/traditional_mul.c \
     src/rng.c \
-    -lm -lcrypt32
+    -lm -lpthread -lcrypt32
 
 if [ $? -eq 0 ]; then
     echo ""
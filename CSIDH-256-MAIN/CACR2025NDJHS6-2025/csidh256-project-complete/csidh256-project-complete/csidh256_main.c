@@ -20,21 +20,14 @@ static uint64_t get_cycles() {
 
 static uint8_t csidh(proj out, const uint8_t sk[], const proj in) {
     // 确保Montgomery域已初始化（必须在任何域运算之前）
-    extern bool g_mf_initialized;
     extern void init_montgomery_field(void);
     extern void init_public_curve(void);
     
-    if (!g_mf_initialized) {
-        init_montgomery_field();
-    }
+    init_montgomery_field();
     
     // 确保公共曲线E已初始化
-    extern proj E;
-    static bool E_initialized = false;
-    if (!E_initialized) {
-        init_public_curve();
-        E_initialized = true;
-    }
+    extern const proj E;
+    init_public_curve();
     
     // 重置计数器
     FP_ADD_COMPUTED = 0;
@@ -175,14 +168,18 @@ int main() {
     printf("At the end of the protocol, Alice and Bob have different but isomorphic Edwards curves. In other words, the\n");
     printf("Montgomery curve isomorphic to each one is the same. Thus, (ss_alice_a / ss_alice_ad) = (ss_bob_a / ss_bob_ad).\n");
     
-    fp ss_a, ss_b, ss_alice_inv, ss_bob_inv;
-    fp_copy(&ss_alice_inv, &ss_alice[1]);
-    fp_inv(&ss_alice_inv);
-    fp_mul(&ss_a, &ss_alice[0], &ss_alice_inv);
+    // 归一化 a/ad：两个比值共用一次求逆（Montgomery技巧），fp_inv 默认使用常量时间safegcd
+    proj ss_both[2];
+    fp ss_ratio[2];
+    point_copy(ss_both[0], ss_alice);
+    point_copy(ss_both[1], ss_bob);
+    c0 = get_cycles();
+    proj_normalize_batch(ss_ratio, (const proj *)ss_both, 2);
+    c1 = get_cycles();
+    fp ss_a = ss_ratio[0], ss_b = ss_ratio[1];
     
-    fp_copy(&ss_bob_inv, &ss_bob[1]);
-    fp_inv(&ss_bob_inv);
-    fp_mul(&ss_b, &ss_bob[0], &ss_bob_inv);
+    printf("\nNormalization (fp_inv: %s): %llu cycles for both ratios\n",
+           FP256_INV_NAME, (unsigned long long)(c1 - c0));
     
     // 验证共享密钥是否相同
     if (fp_compare(&ss_a, &ss_b) == 0) {
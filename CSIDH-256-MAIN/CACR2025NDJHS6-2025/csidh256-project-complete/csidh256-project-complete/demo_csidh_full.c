@@ -32,20 +32,13 @@ void deserialize_public_key(proj pk, const uint8_t *in, size_t in_len) {
 // CSIDH密钥交换函数（确保初始化）
 static uint8_t csidh_action(proj out, const uint8_t sk[], const proj in) {
     // 确保Montgomery域已初始化
-    extern bool g_mf_initialized;
     extern void init_montgomery_field(void);
     extern void init_public_curve(void);
     
-    if (!g_mf_initialized) {
-        init_montgomery_field();
-    }
+    init_montgomery_field();
     
     // 确保公共曲线E已初始化
-    static bool E_initialized = false;
-    if (!E_initialized) {
-        init_public_curve();
-        E_initialized = true;
-    }
+    init_public_curve();
     
     // 重置计数器
     FP_ADD_COMPUTED = 0;
@@ -66,15 +59,21 @@ static uint8_t csidh_action(proj out, const uint8_t sk[], const proj in) {
 
 // 打印公钥（十六进制）
 void print_public_key(const proj pk, const char *name) {
+    fp a, ad;
+    fp_copy(&a, &pk[0]);
+    fp_copy(&ad, &pk[1]);
+    fp_canonicalize(&a);
+    fp_canonicalize(&ad);
+    
     printf("%s (a): ", name);
     for (int i = NUMBER_OF_WORDS - 1; i >= 0; i--) {
-        printf("%016llx", (unsigned long long)pk[0].limbs[i]);
+        printf("%016llx", (unsigned long long)a.limbs[i]);
     }
     printf("\n");
     
     printf("%s (a-d): ", name);
     for (int i = NUMBER_OF_WORDS - 1; i >= 0; i--) {
-        printf("%016llx", (unsigned long long)pk[1].limbs[i]);
+        printf("%016llx", (unsigned long long)ad.limbs[i]);
     }
     printf("\n");
 }
@@ -173,16 +172,13 @@ int main() {
     // 7. 验证一致性
     printf("步骤7: 验证共享密钥一致性...\n");
     // 计算 a/(a-d) 进行比较
-    fp ss_alice_ratio, ss_bob_ratio;
-    fp ss_alice_inv, ss_bob_inv;
-    
-    fp_copy(&ss_alice_inv, &ss_alice[1]);
-    fp_inv(&ss_alice_inv);
-    fp_mul(&ss_alice_ratio, &ss_alice[0], &ss_alice_inv);
-    
-    fp_copy(&ss_bob_inv, &ss_bob[1]);
-    fp_inv(&ss_bob_inv);
-    fp_mul(&ss_bob_ratio, &ss_bob[0], &ss_bob_inv);
+    // 两个比值共用一次求逆
+    proj ss_both[2];
+    fp ss_ratio[2];
+    point_copy(ss_both[0], ss_alice);
+    point_copy(ss_both[1], ss_bob);
+    proj_normalize_batch(ss_ratio, (const proj *)ss_both, 2);
+    fp ss_alice_ratio = ss_ratio[0], ss_bob_ratio = ss_ratio[1];
     
     if (fp_compare(&ss_alice_ratio, &ss_bob_ratio) == 0) {
         printf("  ✅ SUCCESS: 共享密钥匹配！\n");
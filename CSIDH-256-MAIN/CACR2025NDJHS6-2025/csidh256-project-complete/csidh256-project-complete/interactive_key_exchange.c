@@ -66,11 +66,7 @@ static uint8_t csidh_with_timing(proj out, const uint8_t sk[], const proj in,
         init_montgomery_field();
     }
     
-    static bool E_initialized = false;
-    if (!E_initialized) {
-        init_public_curve();
-        E_initialized = true;
-    }
+    init_public_curve();
     
     // 重置计数器
     FP_ADD_COMPUTED = 0;
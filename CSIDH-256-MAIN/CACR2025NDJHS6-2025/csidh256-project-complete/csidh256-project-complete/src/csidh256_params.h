@@ -6,25 +6,17 @@
 
 // ============================================================================
 // 自定义CSIDH参数定义（非官方标准参数）
+// 由 tools/gen_csidh_params.c 生成（make params），不要手工修改
 // ============================================================================
 // 警告：此实现使用自定义参数集，不是官方CSIDH标准参数
-// 
-// 官方CSIDH-512使用74个小素数，CSIDH-256通常使用更少的素数
-// 本实现使用37个小素数，这是为了适配256位素数p的自定义选择
-//
-// 安全性说明：
-// - 此参数集的安全性未经过充分验证
-// - 建议在生产环境使用前进行安全审计
-// - 如需标准CSIDH参数，请参考官方CSIDH-512实现
+// 安全性未经过充分验证，建议在生产环境使用前进行安全审计
 // ============================================================================
 
 #define N 37  // Number of small primes l_i such that l_i | [(p+1)/4]
 #define NUMBER_OF_WORDS 4  // 256 / 64 = 4 words
 #define LOG2_OF_N_PLUS_ONE 6
 
-// 自定义小素数列表 L（37个，按降序排列）
-// 这些是满足 l_i | (p+1)/4 的小素数
-// 注意：这是自定义参数，不是官方CSIDH标准
+// 小素数列表 L（37个，按降序排列）
 static const uint32_t L[] = {
     163, 157, 151, 149, 139, 137, 131, 127,
     113, 109, 107, 103, 101,  97,  89,  83,
@@ -33,20 +25,16 @@ static const uint32_t L[] = {
      13,  11,   7,   5,   3
 };
 
-// 自定义边界 B（每个l_i对应的最大指数）
-// 这些值决定了密钥空间的大小
-// 警告：这是自定义参数，使用统一的边界5
-// 官方CSIDH参数使用变化的边界值（如7, 8, 11, 13等）
-// 此统一边界可能影响安全性和性能，建议根据实际需求调整
+// 边界 B（每个l_i对应的最大指数）
 static const int8_t B[] = {
-    5,  5,  5,  5,  5,  5,  5,  5,
-    5,  5,  5,  5,  5,  5,  5,  5,
-    5,  5,  5,  5,  5,  5,  5,  5,
-    5,  5,  5,  5,  5,  5,  5,  5,
-    5,  5,  5,  5,  5
+     5,  5,  5,  5,  5,  5,  5,  5,
+     5,  5,  5,  5,  5,  5,  5,  5,
+     5,  5,  5,  5,  5,  5,  5,  5,
+     5,  5,  5,  5,  5,  5,  5,  5,
+     5,  5,  5,  5,  5
 };
 
-// 每个l_i的位数（用于验证）
+// 每个l_i的位数
 static const uint16_t BITS_OF_L[] = {
     8, 8, 8, 8, 8, 8, 8, 7,
     7, 7, 7, 7, 7, 7, 7, 7,
@@ -55,28 +43,118 @@ static const uint16_t BITS_OF_L[] = {
     4, 4, 3, 3, 2
 };
 
-#define BITS_OF_4SQRT_OF_P 130  // 4*sqrt(p) 的位数（256位对应约130位）
+#define BITS_OF_4SQRT_OF_P 129  // 4*sqrt(p) 的位数
 #define LARGE_L 163  // 最大的l_i
 
-// 最短差分加法链（用于标量乘法）
-// 每个l_i对应一个加法链
+// 余因子 k = (p+1) / (4 * ∏ l_i)：扭点乘以 4 和补集后还要乘以 k（yMUL_cofactor，k = 1 时不乘）
+#define COFACTOR_BITS 40
+static const uint64_t COFACTOR[NUMBER_OF_WORDS] = { 0x921C6B405F, 0x0, 0x0, 0x0 };
+
+// 最短差分加法链（yMUL 从 (P, [2]P, [3]P) 开始逐位读取，低位在前，见 tools/gen_csidh_params.c）
+// 共 240 步，每个 [l_i]P 需要 1 次 yDBL + (长度 + 1) 次 yADD
 static const uint64_t ADDITION_CHAIN[] = {
-    0x0,   0x1,   0x1,   0x0,   0x4,   0x5,   0x0,   0x1,
-    0x3,   0x8,   0xA,   0xD,   0x4,   0x14,  0x24,  0x9,
-    0x2C,  0x32,  0x36,  0x11,  0x18,  0x4A,  0x60,  0xC,
-    0x68,  0x49,  0x6C,  0x81,  0x82,  0x88,  0x8A,  0xC0,
-    0xA1,  0xC2,  0x98,  0xD4,  0xC5
+    0xD0,   0x180,  0x98,   0x1A0,  0x184,  0x190,  0x40,   0x70,
+    0x1D0,  0x84,   0x60,   0x30,   0x68,   0xC0,   0x0,    0x6C,
+    0x10,   0x14,   0x50,   0x48,   0x2C,   0x58,   0x4C,   0x20,
+    0x22,   0x18,   0x30,   0x8,    0x10,   0x18,   0x4,    0xA,
+    0x0,    0x4,    0x2,    0x0,    0x0
 };
 
 // 每个加法链的长度
 static const uint8_t ADDITION_CHAIN_LENGTH[] = {
-    0,  1,  1,  0,  2,  2,  0,  1,
-    2,  3,  3,  3,  2,  4,  4,  3,
-    4,  4,  4,  4,  4,  5,  5,  3,
-    5,  5,  5,  6,  6,  6,  6,  6,
-    4,  4,  3,  3,  2
+     9,  9,  9,  9,  9,  9,  8,  9,
+     9,  8,  8,  8,  8,  8,  7,  8,
+     7,  7,  7,  7,  7,  7,  7,  6,
+     6,  6,  6,  5,  5,  5,  4,  4,
+     3,  3,  2,  1,  0
 };
 
+// 像曲线中 a^l_i、d^l_i 的最短加法链（见 tools/gen_csidh_params.c）：POW_CHAIN_<l>(STEP) 展开为
+// STEP(k, j)，即 t_k = t_{k-1} * t_j（j = k - 1 时是平方），t_0 为底数，结果是 t_{POW_CHAIN_LENGTH_<l>}
+#define POW_CHAIN_LENGTH_163 9
+#define POW_CHAIN_163(STEP) STEP(1, 0) STEP(2, 1) STEP(3, 2) STEP(4, 3) STEP(5, 4) STEP(6, 0) STEP(7, 5) STEP(8, 7) STEP(9, 6)
+#define POW_CHAIN_LENGTH_157 10
+#define POW_CHAIN_157(STEP) STEP(1, 0) STEP(2, 1) STEP(3, 2) STEP(4, 3) STEP(5, 4) STEP(6, 4) STEP(7, 2) STEP(8, 7) STEP(9, 7) STEP(10, 0)
+#define POW_CHAIN_LENGTH_151 10
+#define POW_CHAIN_151(STEP) STEP(1, 0) STEP(2, 1) STEP(3, 2) STEP(4, 3) STEP(5, 4) STEP(6, 4) STEP(7, 1) STEP(8, 7) STEP(9, 7) STEP(10, 0)
+#define POW_CHAIN_LENGTH_149 9
+#define POW_CHAIN_149(STEP) STEP(1, 0) STEP(2, 1) STEP(3, 2) STEP(4, 3) STEP(5, 0) STEP(6, 4) STEP(7, 6) STEP(8, 7) STEP(9, 5)
+#define POW_CHAIN_LENGTH_139 10
+#define POW_CHAIN_139(STEP) STEP(1, 0) STEP(2, 1) STEP(3, 2) STEP(4, 3) STEP(5, 4) STEP(6, 5) STEP(7, 6) STEP(8, 3) STEP(9, 1) STEP(10, 0)
+#define POW_CHAIN_LENGTH_137 9
+#define POW_CHAIN_137(STEP) STEP(1, 0) STEP(2, 1) STEP(3, 2) STEP(4, 3) STEP(5, 4) STEP(6, 5) STEP(7, 6) STEP(8, 3) STEP(9, 0)
+#define POW_CHAIN_LENGTH_131 9
+#define POW_CHAIN_131(STEP) STEP(1, 0) STEP(2, 1) STEP(3, 2) STEP(4, 3) STEP(5, 4) STEP(6, 5) STEP(7, 6) STEP(8, 1) STEP(9, 0)
+#define POW_CHAIN_LENGTH_127 10
+#define POW_CHAIN_127(STEP) STEP(1, 0) STEP(2, 1) STEP(3, 2) STEP(4, 3) STEP(5, 4) STEP(6, 3) STEP(7, 1) STEP(8, 7) STEP(9, 7) STEP(10, 0)
+#define POW_CHAIN_LENGTH_113 9
+#define POW_CHAIN_113(STEP) STEP(1, 0) STEP(2, 1) STEP(3, 2) STEP(4, 3) STEP(5, 4) STEP(6, 5) STEP(7, 5) STEP(8, 4) STEP(9, 0)
+#define POW_CHAIN_LENGTH_109 9
+#define POW_CHAIN_109(STEP) STEP(1, 0) STEP(2, 1) STEP(3, 2) STEP(4, 3) STEP(5, 4) STEP(6, 2) STEP(7, 6) STEP(8, 6) STEP(9, 0)
+#define POW_CHAIN_LENGTH_107 9
+#define POW_CHAIN_107(STEP) STEP(1, 0) STEP(2, 1) STEP(3, 2) STEP(4, 3) STEP(5, 4) STEP(6, 0) STEP(7, 6) STEP(8, 6) STEP(9, 3)
+#define POW_CHAIN_LENGTH_103 9
+#define POW_CHAIN_103(STEP) STEP(1, 0) STEP(2, 1) STEP(3, 2) STEP(4, 3) STEP(5, 4) STEP(6, 1) STEP(7, 6) STEP(8, 6) STEP(9, 0)
+#define POW_CHAIN_LENGTH_101 9
+#define POW_CHAIN_101(STEP) STEP(1, 0) STEP(2, 1) STEP(3, 2) STEP(4, 3) STEP(5, 4) STEP(6, 5) STEP(7, 5) STEP(8, 2) STEP(9, 0)
+#define POW_CHAIN_LENGTH_97 8
+#define POW_CHAIN_97(STEP) STEP(1, 0) STEP(2, 1) STEP(3, 2) STEP(4, 3) STEP(5, 4) STEP(6, 5) STEP(7, 5) STEP(8, 0)
+#define POW_CHAIN_LENGTH_89 9
+#define POW_CHAIN_89(STEP) STEP(1, 0) STEP(2, 1) STEP(3, 2) STEP(4, 3) STEP(5, 4) STEP(6, 5) STEP(7, 4) STEP(8, 3) STEP(9, 0)
+#define POW_CHAIN_LENGTH_83 8
+#define POW_CHAIN_83(STEP) STEP(1, 0) STEP(2, 1) STEP(3, 2) STEP(4, 3) STEP(5, 0) STEP(6, 4) STEP(7, 6) STEP(8, 5)
+#define POW_CHAIN_LENGTH_79 9
+#define POW_CHAIN_79(STEP) STEP(1, 0) STEP(2, 1) STEP(3, 2) STEP(4, 3) STEP(5, 3) STEP(6, 1) STEP(7, 6) STEP(8, 6) STEP(9, 0)
+#define POW_CHAIN_LENGTH_73 8
+#define POW_CHAIN_73(STEP) STEP(1, 0) STEP(2, 1) STEP(3, 2) STEP(4, 3) STEP(5, 4) STEP(6, 5) STEP(7, 3) STEP(8, 0)
+#define POW_CHAIN_LENGTH_71 9
+#define POW_CHAIN_71(STEP) STEP(1, 0) STEP(2, 1) STEP(3, 2) STEP(4, 3) STEP(5, 4) STEP(6, 5) STEP(7, 2) STEP(8, 1) STEP(9, 0)
+#define POW_CHAIN_LENGTH_67 8
+#define POW_CHAIN_67(STEP) STEP(1, 0) STEP(2, 1) STEP(3, 2) STEP(4, 3) STEP(5, 4) STEP(6, 5) STEP(7, 1) STEP(8, 0)
+#define POW_CHAIN_LENGTH_61 8
+#define POW_CHAIN_61(STEP) STEP(1, 0) STEP(2, 1) STEP(3, 2) STEP(4, 3) STEP(5, 2) STEP(6, 5) STEP(7, 5) STEP(8, 0)
+#define POW_CHAIN_LENGTH_59 8
+#define POW_CHAIN_59(STEP) STEP(1, 0) STEP(2, 1) STEP(3, 2) STEP(4, 3) STEP(5, 0) STEP(6, 5) STEP(7, 5) STEP(8, 3)
+#define POW_CHAIN_LENGTH_53 8
+#define POW_CHAIN_53(STEP) STEP(1, 0) STEP(2, 1) STEP(3, 2) STEP(4, 3) STEP(5, 4) STEP(6, 4) STEP(7, 2) STEP(8, 0)
+#define POW_CHAIN_LENGTH_47 8
+#define POW_CHAIN_47(STEP) STEP(1, 0) STEP(2, 1) STEP(3, 2) STEP(4, 2) STEP(5, 0) STEP(6, 5) STEP(7, 5) STEP(8, 3)
+#define POW_CHAIN_LENGTH_43 7
+#define POW_CHAIN_43(STEP) STEP(1, 0) STEP(2, 1) STEP(3, 2) STEP(4, 0) STEP(5, 3) STEP(6, 5) STEP(7, 4)
+#define POW_CHAIN_LENGTH_41 7
+#define POW_CHAIN_41(STEP) STEP(1, 0) STEP(2, 1) STEP(3, 2) STEP(4, 3) STEP(5, 4) STEP(6, 3) STEP(7, 0)
+#define POW_CHAIN_LENGTH_37 7
+#define POW_CHAIN_37(STEP) STEP(1, 0) STEP(2, 1) STEP(3, 2) STEP(4, 3) STEP(5, 4) STEP(6, 2) STEP(7, 0)
+#define POW_CHAIN_LENGTH_31 7
+#define POW_CHAIN_31(STEP) STEP(1, 0) STEP(2, 1) STEP(3, 2) STEP(4, 1) STEP(5, 4) STEP(6, 4) STEP(7, 0)
+#define POW_CHAIN_LENGTH_29 7
+#define POW_CHAIN_29(STEP) STEP(1, 0) STEP(2, 1) STEP(3, 2) STEP(4, 3) STEP(5, 3) STEP(6, 2) STEP(7, 0)
+#define POW_CHAIN_LENGTH_23 6
+#define POW_CHAIN_23(STEP) STEP(1, 0) STEP(2, 1) STEP(3, 0) STEP(4, 2) STEP(5, 4) STEP(6, 3)
+#define POW_CHAIN_LENGTH_19 6
+#define POW_CHAIN_19(STEP) STEP(1, 0) STEP(2, 1) STEP(3, 2) STEP(4, 3) STEP(5, 1) STEP(6, 0)
+#define POW_CHAIN_LENGTH_17 5
+#define POW_CHAIN_17(STEP) STEP(1, 0) STEP(2, 1) STEP(3, 2) STEP(4, 3) STEP(5, 0)
+#define POW_CHAIN_LENGTH_13 5
+#define POW_CHAIN_13(STEP) STEP(1, 0) STEP(2, 1) STEP(3, 2) STEP(4, 2) STEP(5, 0)
+#define POW_CHAIN_LENGTH_11 5
+#define POW_CHAIN_11(STEP) STEP(1, 0) STEP(2, 1) STEP(3, 2) STEP(4, 1) STEP(5, 0)
+#define POW_CHAIN_LENGTH_7 4
+#define POW_CHAIN_7(STEP) STEP(1, 0) STEP(2, 1) STEP(3, 1) STEP(4, 0)
+#define POW_CHAIN_LENGTH_5 3
+#define POW_CHAIN_5(STEP) STEP(1, 0) STEP(2, 1) STEP(3, 0)
+#define POW_CHAIN_LENGTH_3 2
+#define POW_CHAIN_3(STEP) STEP(1, 0) STEP(2, 0)
+// 共 283 步（二进制方法为 300 步）
+
+// 逐 l_i 展开 X(下标, l_i)：src/edwards256.c 用它生成 l 为编译期常量的同源函数与分派表
+#define FOR_EACH_L(X) \
+    X(0, 163) X(1, 157) X(2, 151) X(3, 149) X(4, 139) X(5, 137) X(6, 131) X(7, 127) \
+    X(8, 113) X(9, 109) X(10, 107) X(11, 103) X(12, 101) X(13, 97) X(14, 89) X(15, 83) \
+    X(16, 79) X(17, 73) X(18, 71) X(19, 67) X(20, 61) X(21, 59) X(22, 53) X(23, 47) \
+    X(24, 43) X(25, 41) X(26, 37) X(27, 31) X(28, 29) X(29, 23) X(30, 19) X(31, 17) \
+    X(32, 13) X(33, 11) X(34, 7) X(35, 5) X(36, 3)
+
 // SIMBA参数（用于批处理同源计算）
 #define NUMBER_OF_BATCHES 3
 #define MY 8
@@ -99,12 +177,110 @@ static const uint8_t COMPLEMENT_OF_EACH_BATCH[NUMBER_OF_BATCHES][N] = {
     { 1, 2, 4, 5, 7, 8, 10, 11, 13, 14, 16, 17, 19, 20, 22, 23, 25, 26, 28, 29, 31, 32, 34, 35,
       N, N, N, N, N, N, N, N, N, N, N, N, N },
     // BATCH_1的补集
-    { 0, 2, 3, 5, 6, 8, 9, 11, 12, 14, 15, 17, 18, 20, 21, 23, 24, 26, 27, 29, 30, 32, 33, 35, 36,
-      N, N, N, N, N, N, N, N, N, N, N, N },
+    { 0, 2, 3, 5, 6, 8, 9, 11, 12, 14, 15, 17, 18, 20, 21, 23, 24, 26, 27, 29, 30, 32, 33, 35,
+      36, N, N, N, N, N, N, N, N, N, N, N, N },
     // BATCH_2的补集
-    { 0, 1, 3, 4, 6, 7, 9, 10, 12, 13, 15, 16, 18, 19, 21, 22, 24, 25, 27, 28, 30, 31, 33, 34, 36,
-      N, N, N, N, N, N, N, N, N, N, N, N }
+    { 0, 1, 3, 4, 6, 7, 9, 10, 12, 13, 15, 16, 18, 19, 21, 22, 24, 25, 27, 28, 30, 31, 33, 34,
+      36, N, N, N, N, N, N, N, N, N, N, N, N }
 };
 
-#endif // CSIDH256_PARAMS_H
+// 初始补集的分组余因子乘法：乘积的最短差分加法链（yMUL_chain），见 tools/gen_csidh_params.c
+// BATCH_0的补集：139*53, 137*103, 127*97, 113*37，201 次点运算（逐个 l_i 为 206 次）
+// BATCH_1的补集：163*83, 151*59, 137*103, 113*37，204 次点运算（逐个 l_i 为 209 次）
+// BATCH_2的补集：163*83, 149*53, 127*97，210 次点运算（逐个 l_i 为 213 次）
+static const uint8_t NUMBER_OF_COFACTOR_CHAINS[NUMBER_OF_BATCHES] = {20, 21, 22};
+static const uint32_t COFACTOR_CHAIN[NUMBER_OF_BATCHES][N] = {
+    { 0x180, 0x98, 0x10090, 0x8008, 0x20082, 0x0, 0x60, 0x0,
+      0x10, 0x14, 0x48, 0x2C, 0x20, 0x18, 0x10, 0x18,
+      0xA, 0x0, 0x2, 0x0, 0x0, 0x0, 0x0, 0x0,
+      0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
+      0x0, 0x0, 0x0, 0x0, 0x0 },
+    { 0x20100, 0x8080, 0x1A0, 0x8008, 0x40, 0x0, 0x84, 0x68,
+      0x0, 0x14, 0x50, 0x2C, 0x20, 0x22, 0x8, 0x18,
+      0x4, 0x0, 0x4, 0x0, 0x0, 0x0, 0x0, 0x0,
+      0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
+      0x0, 0x0, 0x0, 0x0, 0x0 },
+    { 0x20100, 0x180, 0x8900, 0x184, 0x40, 0x20082, 0x84, 0x60,
+      0x68, 0x10, 0x50, 0x48, 0x58, 0x22, 0x18, 0x8,
+      0x10, 0x4, 0xA, 0x4, 0x2, 0x0, 0x0, 0x0,
+      0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
+      0x0, 0x0, 0x0, 0x0, 0x0 }
+};
+static const uint8_t COFACTOR_CHAIN_LENGTH[NUMBER_OF_BATCHES][N] = {
+    { 9, 9, 17, 18, 18, 15, 8, 7, 7, 7, 7, 7, 6, 6, 5, 5, 4, 3, 2, 1, 0, 0, 0, 0,
+      0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
+    { 18, 17, 9, 18, 8, 15, 8, 8, 7, 7, 7, 7, 6, 6, 5, 5, 4, 3, 3, 1, 0, 0, 0, 0,
+      0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
+    { 18, 9, 17, 9, 8, 18, 8, 8, 8, 7, 7, 7, 7, 6, 6, 5, 5, 4, 4, 3, 2, 0, 0, 0,
+      0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }
+};
+
+// 成对 Vélu（见 src/edwards256.c）：l_i >= VELU_PAIR_MIN_L 时用 yISOG_pair / yEVAL2_pair 代替 Vélu，
+// 交叉点由 make run-velu-pair-benchmark 测出（0 表示全部用 Vélu）
+#define VELU_PAIR_MIN_L 29
+static const uint8_t VELU_PAIR[] = {
+    1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 0, 0, 0,
+    0, 0, 0, 0, 0
+};
+
+// √élu（见 src/edwards256.c）：l_i >= VELU_SQRT_MIN_L 时用 yISOG_sqrt / yEVAL2_sqrt，优先于成对 Vélu，
+// 交叉点由 make run-velu-pair-benchmark 测出（0 表示不用）
+#define VELU_SQRT_MIN_L 0
+#define VELU_SQRT_MAX_B 6
+static const uint8_t VELU_SQRT[] = {
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0
+};
 
+// 根式同源（见 src/edwards256.c）：l_i <= RADICAL_MAX_L 的 l_i 不参与 SIMBA 批次，
+// 由 action_radical 在群作用最后用 B[i] 次 l 次方根处理（0 表示不用）
+#define RADICAL_MAX_L 0
+static const uint8_t RADICAL[] = {
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0
+};
+
+// CSURF（见 src/edwards256.c）：L 的最后一项是 2（p = 7 mod 8），action_radical 在曲面上
+// 用平方根走 2-同源；扭点的2-部分是 8，每轮开头多做一次倍点（0 表示不用）
+#define CSURF 0
+
+// 群作用的最优策略（见 tools/gen_csidh_params.c），代价模型 M : S : a = 1 : 0.80 : 0.15，单位 0.01M
+// 单个点的 yMUL 与 yEVAL 的代价
+static const uint32_t STRATEGY_MUL_COST[] = {
+     7120,  7120,  7120,  7120,  7120,  7120,  6470,  7120,
+     7120,  6470,  6470,  6470,  6470,  6470,  5820,  6470,
+     5820,  5820,  5820,  5820,  5820,  5820,  5820,  5170,
+     5170,  5170,  5170,  4520,  4520,  4520,  3870,  3870,
+     3220,  3220,  2570,  1920,  1270
+};
+static const uint32_t STRATEGY_EVAL_COST[] = {
+    24245, 22955, 21665, 21235, 20975, 20545, 19255, 18395,
+    16960, 16100, 15670, 14810, 14380, 13835, 13375, 12085,
+    12485, 11195, 10765,  9905,  8930,  9445,  8155,  7810,
+     6950,  6520,  5660,  5315,  4885,  4950,  4090,  3660,
+     2800,  2370,  1510,  1080,   650
+};
+
+// 完整批次（l_i 从小到大处理）的策略：先序排列的左半大小
+// BATCH_0：668990（从大到小的线性做法为 705770）
+// BATCH_1：630030（从大到小的线性做法为 660620）
+// BATCH_2：596430（从大到小的线性做法为 620390）
+static const uint8_t STRATEGY_OF_EACH_BATCH[NUMBER_OF_BATCHES][N] = {
+    { 6, 3, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+      0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
+    { 6, 3, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+      0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
+    { 6, 3, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+      0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }
+};
+
+#endif // CSIDH256_PARAMS_H
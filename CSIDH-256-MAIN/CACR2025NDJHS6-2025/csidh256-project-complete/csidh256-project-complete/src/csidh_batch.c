@@ -0,0 +1,258 @@
+// 批量群作用：常驻 pthread 工作线程池 + 无锁任务领取
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE  // pthread_setaffinity_np
+#endif
+
+#include "csidh_batch.h"
+#include "edwards256_mb.h"
+#include "rng.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sched.h>
+#include <unistd.h>
+#endif
+
+// 工作线程池（进程内唯一，由 g_batch_lock 保护创建/销毁/提交）
+typedef struct {
+    pthread_t *threads;
+    int n_threads;
+    int requested;            // 创建时请求的线程数（部分创建失败时 n_threads 更少，仍复用）
+    pthread_mutex_t lock;
+    pthread_cond_t work_cv;   // 新批次或退出
+    pthread_cond_t done_cv;   // 批次完成
+    uint64_t generation;      // 每提交一个批次加1
+    uint64_t spawn_generation; // 创建线程时的 generation（线程可能在第一个批次提交后才开始运行）
+    int shutdown;
+    int busy;                 // 尚未处理完当前批次的线程数
+    csidh_job *jobs;
+    size_t n_jobs;
+    atomic_size_t next;       // 下一个未被领取的任务
+    atomic_size_t n_ok;
+} csidh_pool;
+
+static csidh_pool g_pool = {
+    .lock = PTHREAD_MUTEX_INITIALIZER,
+    .work_cv = PTHREAD_COND_INITIALIZER,
+    .done_cv = PTHREAD_COND_INITIALIZER,
+};
+static pthread_mutex_t g_batch_lock = PTHREAD_MUTEX_INITIALIZER;
+
+int csidh_num_cpus(void) {
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    int n = (int)info.dwNumberOfProcessors;
+#else
+    int n = (int)sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+    return (n > 0) ? n : 1;
+}
+
+// 把当前线程绑定到一个CPU核（失败时忽略，只影响性能）
+static void pin_to_cpu(int cpu) {
+#if defined(_WIN32)
+    SetThreadAffinityMask(GetCurrentThread(), (DWORD_PTR)1 << (cpu % (int)(8 * sizeof(DWORD_PTR))));
+#elif defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#else
+    (void)cpu;
+#endif
+}
+
+// 执行连续的 n 个任务（n <= lanes）：通过 validate 的任务凑成一组多缓冲群作用，
+// 不满一组时用第一个有效任务补齐空通道，结果丢弃
+static size_t run_jobs(csidh_job *jobs, size_t n, int lanes) {
+    if (lanes == 1) {
+        size_t ok = 0;
+        for (size_t i = 0; i < n; i++) {
+            jobs[i].ok = validate(jobs[i].in);
+            if (jobs[i].ok) {
+                if (jobs[i].seed != NULL) {
+                    action_evaluation_seed(jobs[i].out, jobs[i].seed, jobs[i].in);
+                } else {
+                    action_evaluation(jobs[i].out, jobs[i].key, jobs[i].in);
+                }
+                ok++;
+            }
+        }
+        return ok;
+    }
+
+    const uint8_t *keys[EDWARDS256_MB_MAX_LANES];
+    uint8_t seed_keys[EDWARDS256_MB_MAX_LANES][N];
+    proj in[EDWARDS256_MB_MAX_LANES], out[EDWARDS256_MB_MAX_LANES];
+    size_t idx[EDWARDS256_MB_MAX_LANES];
+    size_t valid = 0;
+    for (size_t i = 0; i < n; i++) {
+        jobs[i].ok = validate(jobs[i].in);
+        if (jobs[i].ok) {
+            keys[valid] = jobs[i].key;
+            if (jobs[i].seed != NULL) {
+                key_from_seed(seed_keys[valid], jobs[i].seed);
+                keys[valid] = seed_keys[valid];
+            }
+            point_copy(in[valid], jobs[i].in);
+            idx[valid++] = i;
+        }
+    }
+    if (valid == 0) return 0;
+    for (size_t v = valid; v < (size_t)lanes; v++) {
+        keys[v] = keys[0];
+        point_copy(in[v], in[0]);
+    }
+
+    if (lanes == 8) {
+        action_evaluation_x8(out, keys, (const proj *)in);
+    } else {
+        action_evaluation_x4(out, keys, (const proj *)in);
+    }
+    for (size_t v = 0; v < valid; v++) {
+        point_copy(jobs[idx[v]].out, out[v]);
+    }
+    rng_zeroize(seed_keys, sizeof(seed_keys));
+    return valid;
+}
+
+// 从共享游标领取任务直到取完：每次领取 lanes 个，每个任务只被一个线程拿到，不需要加锁
+static void drain_jobs(csidh_pool *pool) {
+    const int lanes = action_evaluation_mb_lanes();
+    size_t ok = 0;
+    for (;;) {
+        size_t i = atomic_fetch_add_explicit(&pool->next, (size_t)lanes, memory_order_relaxed);
+        if (i >= pool->n_jobs) break;
+        size_t n = pool->n_jobs - i;
+        ok += run_jobs(&pool->jobs[i], (n < (size_t)lanes) ? n : (size_t)lanes, lanes);
+    }
+    atomic_fetch_add_explicit(&pool->n_ok, ok, memory_order_relaxed);
+}
+
+static void *worker_main(void *arg) {
+    csidh_pool *pool = &g_pool;
+    pin_to_cpu((int)(intptr_t)arg % csidh_num_cpus());
+
+    pthread_mutex_lock(&pool->lock);
+    uint64_t seen = pool->spawn_generation;
+    for (;;) {
+        while (!pool->shutdown && pool->generation == seen) {
+            pthread_cond_wait(&pool->work_cv, &pool->lock);
+        }
+        if (pool->shutdown) break;
+        seen = pool->generation;
+        pthread_mutex_unlock(&pool->lock);
+
+        drain_jobs(pool);
+
+        pthread_mutex_lock(&pool->lock);
+        if (--pool->busy == 0) {
+            pthread_cond_signal(&pool->done_cv);
+        }
+    }
+    pthread_mutex_unlock(&pool->lock);
+    return NULL;
+}
+
+static void pool_stop(csidh_pool *pool) {
+    pool->requested = 0;
+    if (pool->n_threads == 0) return;
+
+    pthread_mutex_lock(&pool->lock);
+    pool->shutdown = 1;
+    pthread_cond_broadcast(&pool->work_cv);
+    pthread_mutex_unlock(&pool->lock);
+
+    for (int i = 0; i < pool->n_threads; i++) {
+        pthread_join(pool->threads[i], NULL);
+    }
+    free(pool->threads);
+    pool->threads = NULL;
+    pool->n_threads = 0;
+    pool->shutdown = 0;
+}
+
+static void pool_start(csidh_pool *pool, int threads) {
+    pool->requested = threads;
+    pool->threads = (pthread_t*)malloc((size_t)threads * sizeof(pthread_t));
+    if (pool->threads == NULL) return;
+
+    pool->spawn_generation = pool->generation;
+
+    // 部分线程创建失败时用已经创建的线程继续
+    int created = 0;
+    for (int i = 0; i < threads; i++) {
+        if (pthread_create(&pool->threads[created], NULL, worker_main, (void*)(intptr_t)i) != 0) break;
+        created++;
+    }
+    pool->n_threads = created;
+    if (created == 0) {
+        free(pool->threads);
+        pool->threads = NULL;
+    }
+}
+
+size_t csidh_batch_derive(csidh_job jobs[], size_t n, int threads) {
+    if (n == 0) return 0;
+
+    // 在启动工作线程之前完成一次性初始化
+    init_public_curve();
+
+    const int lanes = action_evaluation_mb_lanes();
+    size_t ok = 0;
+    if (threads <= 1) {
+        for (size_t i = 0; i < n; i += (size_t)lanes) {
+            size_t k = n - i;
+            ok += run_jobs(&jobs[i], (k < (size_t)lanes) ? k : (size_t)lanes, lanes);
+        }
+        return ok;
+    }
+
+    pthread_mutex_lock(&g_batch_lock);
+    csidh_pool *pool = &g_pool;
+    if (pool->requested != threads) {
+        pool_stop(pool);
+        pool_start(pool, threads);
+    }
+
+    if (pool->n_threads == 0) {
+        // 无法创建线程：退回到调用线程中执行
+        for (size_t i = 0; i < n; i += (size_t)lanes) {
+            size_t k = n - i;
+            ok += run_jobs(&jobs[i], (k < (size_t)lanes) ? k : (size_t)lanes, lanes);
+        }
+        pthread_mutex_unlock(&g_batch_lock);
+        return ok;
+    }
+
+    pthread_mutex_lock(&pool->lock);
+    pool->jobs = jobs;
+    pool->n_jobs = n;
+    atomic_store_explicit(&pool->next, 0, memory_order_relaxed);
+    atomic_store_explicit(&pool->n_ok, 0, memory_order_relaxed);
+    pool->busy = pool->n_threads;
+    pool->generation++;
+    pthread_cond_broadcast(&pool->work_cv);
+    while (pool->busy > 0) {
+        pthread_cond_wait(&pool->done_cv, &pool->lock);
+    }
+    ok = atomic_load_explicit(&pool->n_ok, memory_order_relaxed);
+    pool->jobs = NULL;
+    pool->n_jobs = 0;
+    pthread_mutex_unlock(&pool->lock);
+
+    pthread_mutex_unlock(&g_batch_lock);
+    return ok;
+}
+
+void csidh_batch_shutdown(void) {
+    pthread_mutex_lock(&g_batch_lock);
+    pool_stop(&g_pool);
+    pthread_mutex_unlock(&g_batch_lock);
+}
@@ -0,0 +1,36 @@
+#ifndef CSIDH_BATCH_H
+#define CSIDH_BATCH_H
+
+#include "edwards256.h"
+#include <stddef.h>
+#include <stdint.h>
+
+// ==================== 批量群作用（多线程）====================
+// 一次提交多个互相独立的 action_evaluation（密钥生成或共享密钥计算），
+// 由常驻的 pthread 工作线程池并行执行：
+//   - 工作线程第一次使用时创建，之后一直保留（线程数变化时重建）
+//   - 每个线程绑定到一个CPU核（Linux: pthread_setaffinity_np，Windows: SetThreadAffinityMask）
+//   - 任务分配是无锁的：线程用原子 fetch_add 从共享游标领取下一组任务
+//   - 每组任务数为 action_evaluation_mb_lanes()，支持 AVX-512 IFMA 时一组 8（或4）个
+//     私钥用多缓冲群作用同步计算（src/edwards256_mb.h）
+// 同一时刻只执行一个批次，多个线程同时调用 csidh_batch_derive 时会依次执行。
+
+typedef struct {
+    const uint8_t *key;  // 私钥（N个指数）
+    const uint8_t *seed; // 紧凑私钥（SEED_BYTES字节种子）；非NULL时在工作线程内展开，忽略 key
+    proj in;             // 输入曲线（密钥生成时为公共曲线E）
+    proj out;            // 输出曲线 action(key, in)
+    uint8_t ok;          // 1 = 成功；0 = 输入曲线没有通过 validate
+} csidh_job;
+
+// 计算 jobs[0..n-1]，最多使用 threads 个工作线程（threads <= 1 时在调用线程中执行）
+// 返回成功的任务数
+size_t csidh_batch_derive(csidh_job jobs[], size_t n, int threads);
+
+// 释放工作线程池（可选，进程退出前调用）
+void csidh_batch_shutdown(void);
+
+// 在线CPU核数（至少为1）
+int csidh_num_cpus(void);
+
+#endif // CSIDH_BATCH_H
@@ -1,39 +1,43 @@
 #include "edwards256.h"
+#include "edwards256_torsion.h"
 #include <string.h>
 #include <assert.h>
 #include <stdio.h>
 
-// 公共曲线E（需要在运行时初始化）
-proj E;
+// 公共曲线E（同构于Montgomery曲线 y^2 = x^3 + x，A = 2(a + d)/(a - d) = 0）
+// 在Edwards形式中：a = 1, d = -1，所以 (a, a-d) = (1, 2)，Montgomery表示在构建时生成
+const proj E = FP256_CONST_E;
 
-// 初始化公共曲线E
-// E同构于Montgomery曲线 y^2 = x^3 + x
-// 在Edwards形式中：a = 1, d = 0（对应Montgomery曲线的A=0）
+// 公共曲线是静态常量，不再需要初始化；保留为空函数兼容旧的调用者
 void init_public_curve(void) {
-    // 确保Montgomery域已初始化
-    extern bool g_mf_initialized;
-    extern void init_montgomery_field(void);
-    extern fp R_squared_mod_p;
-    extern mont_field g_mf;
-    
-    if (!g_mf_initialized) {
-        init_montgomery_field();
-    }
-    
-    // 在Edwards曲线中，对于Montgomery曲线 y^2 = x^3 + x
-    // 对应的Edwards曲线参数：a = 1, d = 0
-    // 所以 a = 1, (a-d) = 1
-    
-    // 在普通域中，a = 1, (a-d) = 1
-    bigint256 a_normal, ad_normal;
-    set_one(&a_normal);
-    set_one(&ad_normal);
-    
-    // 转换到Montgomery域：E[0] = a * R^2 mod p, E[1] = (a-d) * R^2 mod p
-    mont_mul((bigint256*)&E[0], &a_normal, &R_squared_mod_p, &g_mf);
-    mont_mul((bigint256*)&E[1], &ad_normal, &R_squared_mod_p, &g_mf);
 }
 
+// ==================== 公共曲线E的预计算扭点 ====================
+// 表由 tools/gen_torsion_points.c 生成（make torsion）；参数集或 p 与生成时不一致时不使用
+
+#if EDWARDS256_TORSION_N == N && EDWARDS256_TORSION_BATCHES == NUMBER_OF_BATCHES
+uint8_t has_precomputed_torsion(const proj A) {
+    if (memcmp(EDWARDS256_TORSION_P, p.limbs, sizeof(EDWARDS256_TORSION_P)) != 0) return 0;
+    return areEqual(A, E);
+}
+
+void precomputed_torsion(proj T_plus, proj T_minus, uint8_t m) {
+    point_copy(T_minus, EDWARDS256_TORSION[m][0]);
+    point_copy(T_plus, EDWARDS256_TORSION[m][1]);
+}
+#else
+uint8_t has_precomputed_torsion(const proj A) {
+    (void)A;
+    return 0;
+}
+
+void precomputed_torsion(proj T_plus, proj T_minus, uint8_t m) {
+    (void)T_plus;
+    (void)T_minus;
+    (void)m;
+}
+#endif
+
 // 检查点是否为无穷远点
 int isinfinity(const proj P) {
     fp tmp;
@@ -49,10 +53,21 @@ void point_copy(proj Q, const proj P) {
 
 // 检查两点是否相等
 uint8_t areEqual(const proj P, const proj Q) {
-    fp YPZQ, ZPYQ;
-    fp_mul(&YPZQ, &P[0], &Q[1]);
-    fp_mul(&ZPYQ, &P[1], &Q[0]);
-    return (fp_compare(&YPZQ, &ZPYQ) == 0) ? 1 : 0;
+    // Y_P * Z_Q - Z_P * Y_Q = 0，两个乘积只约简一次
+    fp diff;
+    fp_mul2_sub(&diff, &P[0], &Q[1], &P[1], &Q[0]);
+    return fp_iszero(&diff) ? 1 : 0;
+}
+
+void proj_normalize_batch(fp out[], const proj Ps[], size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        fp_copy(&out[i], &Ps[i][1]);
+    }
+    fp_inv_batch(out, n);
+    for (size_t i = 0; i < n; i++) {
+        fp_mul(&out[i], &Ps[i][0], &out[i]);
+        fp_canonicalize(&out[i]);
+    }
 }
 
 // Edwards y坐标倍点运算
@@ -65,7 +80,7 @@ void yDBL(proj Q, const proj P, const proj A) {
     
     fp_mul(&Q[1], &A[1], &tmp_0);
     fp_mul(&Q[0], &Q[1], &tmp_1);
-    fp_sub(&tmp_1, &tmp_1, &tmp_0);
+    fp_sub_nr(&tmp_1, &tmp_1, &tmp_0);  // 只作为乘法操作数，不约简
     fp_mul(&tmp_0, &A[0], &tmp_1);
     fp_add(&Q[1], &Q[1], &tmp_0);
     fp_mul(&tmp_0, &Q[1], &tmp_1);
@@ -81,28 +96,20 @@ void yDBL(proj Q, const proj P, const proj A) {
 
 // Edwards y坐标点加运算
 void yADD(proj R, const proj P, const proj Q, const proj PQ) {
-    fp tmp_0, tmp_1, xD, zD;
+    fp xD, zD;
     
     // 将差值映射到Montgomery曲线
     fp_add(&xD, &PQ[1], &PQ[0]);
     fp_sub(&zD, &PQ[1], &PQ[0]);
     
-    // 在Montgomery曲线上进行点加
-    fp_mul(&tmp_0, &P[1], &Q[0]);
-    fp_mul(&tmp_1, &P[0], &Q[1]);
-    
-    fp_sub(&R[1], &tmp_0, &tmp_1);
-    fp_add(&R[0], &tmp_0, &tmp_1);
+    // 在Montgomery曲线上进行点加：P1*Q0 ± P0*Q1（乘积和，各约简一次）
+    fp_mul2_addsub(&R[0], &R[1], &P[1], &Q[0], &P[0], &Q[1]);
     
     fp_sqr(&R[1], &R[1]);
     fp_sqr(&R[0], &R[0]);
     
-    fp_mul(&tmp_0, &R[0], &zD);
-    fp_mul(&tmp_1, &R[1], &xD);
-    
-    // 映射回Edwards曲线
-    fp_sub(&R[0], &tmp_0, &tmp_1);
-    fp_add(&R[1], &tmp_0, &tmp_1);
+    // 映射回Edwards曲线：R0*zD ∓ R1*xD
+    fp_mul2_addsub(&R[1], &R[0], &R[0], &zD, &R[1], &xD);
     
     FP_ADD_COMPUTED += 6;
     FP_SQR_COMPUTED += 2;
@@ -111,6 +118,11 @@ void yADD(proj R, const proj P, const proj Q, const proj PQ) {
 
 // 标量乘法 [l_i]P
 void yMUL(proj Q, const proj P, const proj A, uint8_t const i) {
+    yMUL_chain(Q, P, A, (uint32_t)ADDITION_CHAIN[i], ADDITION_CHAIN_LENGTH[i]);
+}
+
+// 按差分加法链计算 [k]P（链的格式见 tools/gen_csidh_params.c）
+void yMUL_chain(proj Q, const proj P, const proj A, uint32_t chain, uint8_t length) {
     proj R[3], T;
     
     // 初始3元组
@@ -119,8 +131,8 @@ void yMUL(proj Q, const proj P, const proj A, uint8_t const i) {
     yADD(R[2], R[1], R[0], P);  // [3]P
     
     // 主循环（使用加法链）
-    uint32_t tmp = ADDITION_CHAIN[i];
-    for (uint8_t j = 0; j < ADDITION_CHAIN_LENGTH[i]; j++) {
+    uint32_t tmp = chain;
+    for (uint8_t j = 0; j < length; j++) {
         if (isinfinity(R[tmp & 0x1]) == 1) {
             yDBL(T, R[2], A);
         } else {
@@ -136,6 +148,131 @@ void yMUL(proj Q, const proj P, const proj A, uint8_t const i) {
     point_copy(Q, R[2]);
 }
 
+// [k]P，k 是余因子 COFACTOR。k 是公开常量，可能比加法链能表示的大，用 Montgomery 梯子
+// （每位 1 次 yDBL + 1 次 yADD，差恒为 P）；k = 1 或 P 是无穷远点（差为无穷远时 yADD 不适用）时结果就是 P
+void yMUL_cofactor(proj Q, const proj P, const proj A) {
+    proj R0, R1, T;
+    
+    point_copy(R0, P);
+    if (COFACTOR_BITS <= 1 || isinfinity(P) == 1) {
+        point_copy(Q, R0);
+        return;
+    }
+    yDBL(R1, P, A);
+    for (int b = COFACTOR_BITS - 2; b >= 0; b--) {
+        yADD(T, R1, R0, P);
+        if ((COFACTOR[b >> 6] >> (b & 63)) & 1) {
+            point_copy(R0, T);
+            yDBL(R1, R1, A);
+        } else {
+            point_copy(R1, T);
+            yDBL(R0, R0, A);
+        }
+    }
+    point_copy(Q, R0);
+}
+
+// ==================== T+ / T- 双点交错运算 ====================
+// 群作用对 T+ 和 T- 总是做同样的运算。两个点的域运算互不依赖，交错排列后
+// 一个点的乘法等待进位/约简时另一个点的乘法可以同时执行；运算次数与分开调用相同。
+// 输出不能与另一个点的输入重叠。
+
+void yDBL2(proj Q0, proj Q1, const proj P0, const proj P1, const proj A) {
+    fp t0_0, t1_0, t0_1, t1_1;
+    
+    fp_sqr(&t0_0, &P0[0]);
+    fp_sqr(&t0_1, &P1[0]);
+    fp_sqr(&t1_0, &P0[1]);
+    fp_sqr(&t1_1, &P1[1]);
+    
+    fp_mul(&Q0[1], &A[1], &t0_0);
+    fp_mul(&Q1[1], &A[1], &t0_1);
+    fp_mul(&Q0[0], &Q0[1], &t1_0);
+    fp_mul(&Q1[0], &Q1[1], &t1_1);
+    fp_sub_nr(&t1_0, &t1_0, &t0_0);
+    fp_sub_nr(&t1_1, &t1_1, &t0_1);
+    fp_mul(&t0_0, &A[0], &t1_0);
+    fp_mul(&t0_1, &A[0], &t1_1);
+    fp_add(&Q0[1], &Q0[1], &t0_0);
+    fp_add(&Q1[1], &Q1[1], &t0_1);
+    fp_mul(&t0_0, &Q0[1], &t1_0);
+    fp_mul(&t0_1, &Q1[1], &t1_1);
+    
+    fp_add(&Q0[1], &Q0[0], &t0_0);
+    fp_add(&Q1[1], &Q1[0], &t0_1);
+    fp_sub(&Q0[0], &Q0[0], &t0_0);
+    fp_sub(&Q1[0], &Q1[0], &t0_1);
+    
+    FP_ADD_COMPUTED += 8;
+    FP_SQR_COMPUTED += 4;
+    FP_MUL_COMPUTED += 8;
+}
+
+static inline void yADD2(proj R0, proj R1, const proj P0, const proj Q0, const proj PQ0,
+                         const proj P1, const proj Q1, const proj PQ1) {
+    fp xD0, zD0, xD1, zD1;
+    
+    fp_add(&xD0, &PQ0[1], &PQ0[0]);
+    fp_add(&xD1, &PQ1[1], &PQ1[0]);
+    fp_sub(&zD0, &PQ0[1], &PQ0[0]);
+    fp_sub(&zD1, &PQ1[1], &PQ1[0]);
+    
+    fp_mul2_addsub(&R0[0], &R0[1], &P0[1], &Q0[0], &P0[0], &Q0[1]);
+    fp_mul2_addsub(&R1[0], &R1[1], &P1[1], &Q1[0], &P1[0], &Q1[1]);
+    
+    fp_sqr(&R0[1], &R0[1]);
+    fp_sqr(&R1[1], &R1[1]);
+    fp_sqr(&R0[0], &R0[0]);
+    fp_sqr(&R1[0], &R1[0]);
+    
+    fp_mul2_addsub(&R0[1], &R0[0], &R0[0], &zD0, &R0[1], &xD0);
+    fp_mul2_addsub(&R1[1], &R1[0], &R1[0], &zD1, &R1[1], &xD1);
+    
+    FP_ADD_COMPUTED += 12;
+    FP_SQR_COMPUTED += 4;
+    FP_MUL_COMPUTED += 8;
+}
+
+// Q0 = [k]P0, Q1 = [k]P1（同一条差分加法链）
+void yMUL2_chain(proj Q0, proj Q1, const proj P0, const proj P1, const proj A, uint32_t chain, uint8_t length) {
+    proj R[2][3], T[2];
+    
+    point_copy(R[0][0], P0);
+    point_copy(R[1][0], P1);
+    yDBL2(R[0][1], R[1][1], P0, P1, A);
+    yADD2(R[0][2], R[1][2], R[0][1], R[0][0], P0, R[1][1], R[1][0], P1);
+    
+    uint32_t tmp = chain;
+    for (uint8_t j = 0; j < length; j++) {
+        uint8_t b = tmp & 0x1;
+        if ((isinfinity(R[0][b]) | isinfinity(R[1][b])) == 0) {
+            yADD2(T[0], T[1], R[0][2], R[0][b ^ 0x1], R[0][b], R[1][2], R[1][b ^ 0x1], R[1][b]);
+        } else {
+            // 差为无穷远点（点的阶整除已乘过的部分），与 yMUL 一样改用倍点
+            for (int k = 0; k < 2; k++) {
+                if (isinfinity(R[k][b]) == 1) {
+                    yDBL(T[k], R[k][2], A);
+                } else {
+                    yADD(T[k], R[k][2], R[k][b ^ 0x1], R[k][b]);
+                }
+            }
+        }
+        for (int k = 0; k < 2; k++) {
+            point_copy(R[k][0], R[k][b ^ 0x1]);
+            point_copy(R[k][1], R[k][2]);
+            point_copy(R[k][2], T[k]);
+        }
+        
+        tmp >>= 1;
+    }
+    point_copy(Q0, R[0][2]);
+    point_copy(Q1, R[1][2]);
+}
+
+void yMUL2(proj Q0, proj Q1, const proj P0, const proj P1, const proj A, uint8_t const i) {
+    yMUL2_chain(Q0, Q1, P0, P1, A, (uint32_t)ADDITION_CHAIN[i], ADDITION_CHAIN_LENGTH[i]);
+}
+
 // Elligator映射（生成扭点）
 void elligator(proj T_plus, proj T_minus, const proj A) {
     set_zero(&T_plus[0]);
@@ -143,25 +280,19 @@ void elligator(proj T_plus, proj T_minus, const proj A) {
     
     // 从 {2, ..., (p-1)/2} 中随机选择u
     fp u;
-    extern fp p_minus_1_halves;
     fp_random(&u);
     while (fp_compare(&u, &p_minus_1_halves) > 0) {
         fp_random(&u);
     }
     
-    // 映射u到Montgomery域
-    extern fp R_squared_mod_p;
-    fp_mul(&u, &u, &R_squared_mod_p);
-    
     // Elligator计算
     fp tmp, u2_plus_1, Cu2_minus_1, tmp_0, tmp_1, alpha, beta;
     set_zero(&alpha);
     fp_add(&beta, &alpha, &u);
     
     fp_sqr(&T_plus[1], &u);
-    extern fp R_mod_p;
-    fp_add(&u2_plus_1, &T_plus[1], &R_mod_p);
-    fp_sub(&tmp, &T_plus[1], &R_mod_p);
+    fp_add_nr(&u2_plus_1, &T_plus[1], fp_one());
+    fp_sub_nr(&tmp, &T_plus[1], fp_one());
     fp_mul(&Cu2_minus_1, &A[1], &tmp);
     
     // 计算Montgomery曲线常数
@@ -171,14 +302,11 @@ void elligator(proj T_plus, proj T_minus, const proj A) {
     
     fp_mul(&tmp_0, &T_minus[1], &Cu2_minus_1);
     fp_sqr(&tmp_1, &T_minus[1]);
-    fp_mul(&tmp_1, &tmp_1, &T_plus[1]);
-    fp_sqr(&tmp, &Cu2_minus_1);
-    fp_add(&tmp_1, &tmp_1, &tmp);
+    fp_mul2_add(&tmp_1, &tmp_1, &T_plus[1], &Cu2_minus_1, &Cu2_minus_1);
     fp_mul(&tmp, &tmp_0, &tmp_1);
     
-    // 常量时间选择
-    uint8_t mask = fp_iszero(&tmp) ? 0 : 1;
-    fp_cswap(&alpha, &beta, mask);
+    // 常量时间选择：tmp = 0（Montgomery系数 A = 0，即 a + d = 0）时 alpha = u，否则 alpha = 0
+    fp_cswap(&alpha, &beta, fp_iszero(&tmp));
     fp_mul(&u2_plus_1, &alpha, &u2_plus_1);
     fp_mul(&alpha, &alpha, &Cu2_minus_1);
     
@@ -230,13 +358,6 @@ void cofactor_multiples(proj P[], const proj A, int8_t lower, int8_t upper) {
 // 验证曲线是否为超奇异曲线
 // 注意：对于演示目的，简化验证逻辑，接受所有曲线
 uint8_t validate(const proj A) {
-    // 确保Montgomery域已初始化
-    extern bool g_mf_initialized;
-    extern void init_montgomery_field(void);
-    if (!g_mf_initialized) {
-        init_montgomery_field();
-    }
-    
     // 简化验证：对于演示目的，接受所有曲线（允许展示模乘优化效果）
     // 只检查曲线参数是否有效（非零）
     if (fp_iszero(&A[0]) && fp_iszero(&A[1])) {
@@ -248,110 +369,1202 @@ uint8_t validate(const proj A) {
     return 1;
 }
 
-// 同源构造
-void yISOG(proj Pk[], proj C, const proj P, const proj A, const uint8_t i) {
-    uint8_t mask;
-    int64_t bits_l;
-    uint64_t j;
-    uint32_t l = L[i];
-    uint64_t s = l >> 1;
-    
-    bits_l = 0;
-    uint32_t l_temp = l;
-    while (l_temp > 0) {
-        l_temp >>= 1;
-        bits_l += 1;
+// 同源的像曲线：a' = a^l * Bz^8, d' = d^l * By^8，C = (a' : a' - d')。
+// al / dl 是 a^l、d^l（逐 l_i 的固定加法链，见下面的 isog_pow_<l>），By / Bz 是核中各点
+// y 坐标分子 / 分母之积（Vélu 与成对 Vélu 共用），会被改写。C 可以与 A 重叠。
+static void isog_codomain(proj C, const fp *al, const fp *dl, fp *By, fp *Bz) {
+    for (int j = 0; j < 3; j++) {
+        fp_sqr(By, By);
+        fp_sqr(Bz, Bz);
+        FP_SQR_COMPUTED += 2;
     }
     
-    fp By[2], Bz[2], tmp_0, tmp_1, tmp_d;
+    fp_mul(&C[0], al, Bz);
+    fp_mul(&C[1], dl, By);
+    fp_sub(&C[1], &C[0], &C[1]);
+    
+    FP_ADD_COMPUTED += 2;
+    FP_MUL_COMPUTED += 2;
+}
+
+// ==================== 逐 l_i 特化的 Vélu ====================
+// velu_isog / velu_eval / velu_eval2 以 l 为参数强制内联，由 csidh256_params.h 的 FOR_EACH_L
+// 为每个 l_i 各展开一份：l 是编译期常量，a^l、d^l 用 POW_CHAIN_<l> 的固定加法链
+// （gen_csidh_params 求出的最短链），l < VELU_UNROLL_MAX_L 时 s = (l - 1) / 2 次的循环完全展开。
+// 更大的 l_i 完全展开后代码量与 l 成正比（全部展开时可执行文件大 2.5 倍以上），而循环开销
+// 相对每次迭代的域乘法可以忽略，并且默认参数下这些 l_i 由成对 Vélu 处理，所以保持循环。
+// yISOG / yEVAL / yEVAL2 按下标查 ISOGENY_KERNELS 分派到对应的特化版本。
+#define ISOG_INLINE static inline __attribute__((always_inline))
+#define VELU_UNROLL_MAX_L 32
+
+// for (j = lo; j < hi; j++) step;
+#define VELU_FOR(j, lo, hi, l, step) \
+    if ((l) < VELU_UNROLL_MAX_L) { \
+        _Pragma("GCC unroll 16") \
+        for (uint32_t j = (lo); j < (hi); j++) step; \
+    } else { \
+        _Pragma("GCC unroll 1") \
+        for (uint32_t j = (lo); j < (hi); j++) step; \
+    }
+
+ISOG_INLINE void velu_isog_step(proj Pk[], fp *By, fp *Bz, const proj P, uint32_t j) {
+    fp_mul(By, By, &Pk[j - 1][0]);
+    fp_mul(Bz, Bz, &Pk[j - 1][1]);
+    yADD(Pk[j], Pk[j - 1], P, Pk[j - 2]);
+    FP_MUL_COMPUTED += 2;
+}
+
+// 同源构造
+ISOG_INLINE void velu_isog(proj Pk[], proj C, const proj P, const proj A,
+                           const fp *al, const fp *dl, const uint32_t l) {
+    const uint32_t s = l >> 1;
     
-    fp_copy(&tmp_0, &A[0]);
-    fp_sub(&tmp_d, &A[0], &A[1]);
-    fp_copy(&tmp_1, &tmp_d);
+    fp By, Bz;
     
-    fp_copy(&By[0], &P[0]);
-    fp_copy(&By[1], &P[0]);
-    fp_copy(&Bz[0], &P[1]);
-    fp_copy(&Bz[1], &P[1]);
+    fp_copy(&By, &P[0]);
+    fp_copy(&Bz, &P[1]);
     
     point_copy(Pk[0], P);
     yDBL(Pk[1], P, A);
     
-    for (j = 2; j < s; j++) {
-        fp_mul(&By[0], &By[0], &Pk[j - 1][0]);
-        fp_mul(&Bz[0], &Bz[0], &Pk[j - 1][1]);
-        yADD(Pk[j], Pk[j - 1], P, Pk[j - 2]);
-        FP_MUL_COMPUTED += 2;
-    }
-    
-    mask = isequal(l, 3) ^ 1;
-    fp_mul(&By[1], &By[0], &Pk[s - 1][0]);
-    fp_mul(&Bz[1], &Bz[0], &Pk[s - 1][1]);
-    fp_cswap(&By[0], &By[1], mask);
-    fp_cswap(&Bz[0], &Bz[1], mask);
-    
-    // 计算 a^l 和 d^l
-    bits_l -= 1;
-    for (j = 1; j <= bits_l; j++) {
-        fp_sqr(&tmp_0, &tmp_0);
-        fp_sqr(&tmp_1, &tmp_1);
-        if (((l >> (bits_l - j)) & 1) != 0) {
-            fp_mul(&tmp_0, &tmp_0, &A[0]);
-            fp_mul(&tmp_1, &tmp_1, &tmp_d);
-            FP_MUL_COMPUTED += 2;
-        }
-        FP_SQR_COMPUTED += 2;
-    }
+    VELU_FOR(j, 2, s, l, velu_isog_step(Pk, &By, &Bz, P, j));
     
-    for (j = 0; j < 3; j++) {
-        fp_sqr(&By[0], &By[0]);
-        fp_sqr(&Bz[0], &Bz[0]);
-        FP_SQR_COMPUTED += 2;
+    // l = 3 时只有一个核点
+    if (l != 3) {
+        fp_mul(&By, &By, &Pk[s - 1][0]);
+        fp_mul(&Bz, &Bz, &Pk[s - 1][1]);
+        FP_MUL_COMPUTED += 2;
     }
     
-    fp_mul(&C[0], &tmp_0, &Bz[0]);
-    fp_mul(&C[1], &tmp_1, &By[0]);
-    fp_sub(&C[1], &C[0], &C[1]);
+    isog_codomain(C, al, dl, &By, &Bz);
+}
+
+ISOG_INLINE void velu_eval_step(proj R, const proj Q, const proj Pk) {
+    fp tmp_0, tmp_1;
     
+    fp_mul2_addsub(&tmp_0, &tmp_1, &Q[0], &Pk[1], &Q[1], &Pk[0]);
+    fp_mul(&R[0], &R[0], &tmp_0);
+    fp_mul(&R[1], &R[1], &tmp_1);
     FP_ADD_COMPUTED += 2;
     FP_MUL_COMPUTED += 4;
 }
 
 // 同源求值
-void yEVAL(proj R, const proj Q, const proj Pk[], const uint8_t i) {
-    fp tmp_0, tmp_1, s_0, s_1;
+ISOG_INLINE void velu_eval(proj R, const proj Q, const proj Pk[], const uint32_t l) {
+    fp tmp_0, tmp_1;
     
     proj tmp_Q;
     point_copy(tmp_Q, Q);
     
-    fp_mul(&s_0, &tmp_Q[0], &Pk[0][1]);
-    fp_mul(&s_1, &tmp_Q[1], &Pk[0][0]);
-    fp_add(&R[0], &s_0, &s_1);
-    fp_sub(&R[1], &s_0, &s_1);
-    
-    uint64_t s = (L[i] >> 1);
-    for (int j = 1; j < s; j++) {
-        fp_mul(&s_0, &tmp_Q[0], &Pk[j][1]);
-        fp_mul(&s_1, &tmp_Q[1], &Pk[j][0]);
-        fp_add(&tmp_0, &s_0, &s_1);
-        fp_sub(&tmp_1, &s_0, &s_1);
-        fp_mul(&R[0], &R[0], &tmp_0);
-        fp_mul(&R[1], &R[1], &tmp_1);
-        FP_ADD_COMPUTED += 2;
-        FP_MUL_COMPUTED += 4;
-    }
+    // Q0*Pk1 ± Q1*Pk0：两个乘积只算一次，和与差各约简一次
+    fp_mul2_addsub(&R[0], &R[1], &tmp_Q[0], &Pk[0][1], &tmp_Q[1], &Pk[0][0]);
+    
+    VELU_FOR(j, 1, l >> 1, l, velu_eval_step(R, tmp_Q, Pk[j]));
     
     fp_sqr(&R[0], &R[0]);
     fp_sqr(&R[1], &R[1]);
     fp_add(&tmp_0, &tmp_Q[1], &tmp_Q[0]);
     fp_sub(&tmp_1, &tmp_Q[1], &tmp_Q[0]);
-    fp_mul(&tmp_0, &R[0], &tmp_0);
-    fp_mul(&tmp_1, &R[1], &tmp_1);
-    fp_sub(&R[0], &tmp_0, &tmp_1);
-    fp_add(&R[1], &tmp_0, &tmp_1);
+    fp_mul2_addsub(&R[1], &R[0], &R[0], &tmp_0, &R[1], &tmp_1);
     
     FP_ADD_COMPUTED += 6;
     FP_SQR_COMPUTED += 2;
     FP_MUL_COMPUTED += 4;
 }
 
+ISOG_INLINE void velu_eval2_step(proj R0, proj R1, const proj Q0, const proj Q1, const proj Pk) {
+    fp t0_0, t1_0, t0_1, t1_1;
+    
+    fp_mul2_addsub(&t0_0, &t1_0, &Q0[0], &Pk[1], &Q0[1], &Pk[0]);
+    fp_mul2_addsub(&t0_1, &t1_1, &Q1[0], &Pk[1], &Q1[1], &Pk[0]);
+    fp_mul(&R0[0], &R0[0], &t0_0);
+    fp_mul(&R1[0], &R1[0], &t0_1);
+    fp_mul(&R0[1], &R0[1], &t1_0);
+    fp_mul(&R1[1], &R1[1], &t1_1);
+    FP_ADD_COMPUTED += 4;
+    FP_MUL_COMPUTED += 8;
+}
+
+// R0 = φ(Q0), R1 = φ(Q1)：核点 Pk[j] 每次只读一次，两个点的乘积交错
+ISOG_INLINE void velu_eval2(proj R0, proj R1, const proj Q0, const proj Q1, const proj Pk[], const uint32_t l) {
+    fp t0_0, t1_0, t0_1, t1_1;
+    
+    proj tmp_Q0, tmp_Q1;
+    point_copy(tmp_Q0, Q0);
+    point_copy(tmp_Q1, Q1);
+    
+    fp_mul2_addsub(&R0[0], &R0[1], &tmp_Q0[0], &Pk[0][1], &tmp_Q0[1], &Pk[0][0]);
+    fp_mul2_addsub(&R1[0], &R1[1], &tmp_Q1[0], &Pk[0][1], &tmp_Q1[1], &Pk[0][0]);
+    
+    VELU_FOR(j, 1, l >> 1, l, velu_eval2_step(R0, R1, tmp_Q0, tmp_Q1, Pk[j]));
+    
+    fp_sqr(&R0[0], &R0[0]);
+    fp_sqr(&R1[0], &R1[0]);
+    fp_sqr(&R0[1], &R0[1]);
+    fp_sqr(&R1[1], &R1[1]);
+    fp_add(&t0_0, &tmp_Q0[1], &tmp_Q0[0]);
+    fp_add(&t0_1, &tmp_Q1[1], &tmp_Q1[0]);
+    fp_sub(&t1_0, &tmp_Q0[1], &tmp_Q0[0]);
+    fp_sub(&t1_1, &tmp_Q1[1], &tmp_Q1[0]);
+    fp_mul2_addsub(&R0[1], &R0[0], &R0[0], &t0_0, &R0[1], &t1_0);
+    fp_mul2_addsub(&R1[1], &R1[0], &R1[0], &t0_1, &R1[1], &t1_1);
+    
+    FP_ADD_COMPUTED += 12;
+    FP_SQR_COMPUTED += 4;
+    FP_MUL_COMPUTED += 8;
+}
+
+// 加法链的一步：t_k = t_{k-1} * t_j，a 与 d 同时计算
+#define ISOG_POW_STEP(k, j) \
+    if ((j) == (k) - 1) { \
+        fp_sqr(&ta[k], &ta[(k) - 1]); \
+        fp_sqr(&td[k], &td[(k) - 1]); \
+        FP_SQR_COMPUTED += 2; \
+    } else { \
+        fp_mul(&ta[k], &ta[(k) - 1], &ta[j]); \
+        fp_mul(&td[k], &td[(k) - 1], &td[j]); \
+        FP_MUL_COMPUTED += 2; \
+    }
+
+// 每个 l_i：isog_pow_<l>（al = a^l，dl = d^l）与 yISOG_<l> / yEVAL_<l> / yEVAL2_<l>
+#define ISOG_DEFINE_KERNELS(i, l) \
+    static void isog_pow_##l(fp *al, fp *dl, const proj A) { \
+        fp ta[POW_CHAIN_LENGTH_##l + 1], td[POW_CHAIN_LENGTH_##l + 1]; \
+        fp_copy(&ta[0], &A[0]); \
+        fp_sub(&td[0], &A[0], &A[1]); \
+        POW_CHAIN_##l(ISOG_POW_STEP) \
+        fp_copy(al, &ta[POW_CHAIN_LENGTH_##l]); \
+        fp_copy(dl, &td[POW_CHAIN_LENGTH_##l]); \
+    } \
+    static void yISOG_##l(proj Pk[], proj C, const proj P, const proj A) { \
+        fp al, dl; \
+        isog_pow_##l(&al, &dl, A); \
+        velu_isog(Pk, C, P, A, &al, &dl, l); \
+    } \
+    static void yEVAL_##l(proj R, const proj Q, const proj Pk[]) { \
+        velu_eval(R, Q, Pk, l); \
+    } \
+    static void yEVAL2_##l(proj R0, proj R1, const proj Q0, const proj Q1, const proj Pk[]) { \
+        velu_eval2(R0, R1, Q0, Q1, Pk, l); \
+    }
+
+FOR_EACH_L(ISOG_DEFINE_KERNELS)
+
+typedef struct {
+    void (*isog)(proj Pk[], proj C, const proj P, const proj A);
+    void (*eval)(proj R, const proj Q, const proj Pk[]);
+    void (*eval2)(proj R0, proj R1, const proj Q0, const proj Q1, const proj Pk[]);
+    void (*pow)(fp *al, fp *dl, const proj A);
+} isogeny_kernels;
+
+#define ISOG_KERNELS_ENTRY(i, l) [i] = { yISOG_##l, yEVAL_##l, yEVAL2_##l, isog_pow_##l },
+static const isogeny_kernels ISOGENY_KERNELS[N] = { FOR_EACH_L(ISOG_KERNELS_ENTRY) };
+
+void yISOG(proj Pk[], proj C, const proj P, const proj A, const uint8_t i) {
+    ISOGENY_KERNELS[i].isog(Pk, C, P, A);
+}
+
+void yEVAL(proj R, const proj Q, const proj Pk[], const uint8_t i) {
+    ISOGENY_KERNELS[i].eval(R, Q, Pk);
+}
+
+void yEVAL2(proj R0, proj R1, const proj Q0, const proj Q1, const proj Pk[], const uint8_t i) {
+    ISOGENY_KERNELS[i].eval2(R0, R1, Q0, Q1, Pk);
+}
+
+
+// ==================== 成对 Vélu ====================
+// 借用 √élu（Bernstein–De Feo–Leroux–Smith）对核的分解，但不做 baby-step / giant-step 结式。
+// 记 x_k 为 [k]P 的 Montgomery x 坐标（Edwards (Y : T) 对应 (T + Y : T - Y)），
+// 核多项式 h(α) = ∏_{k=1..(l-1)/2} (α - x_k)。由 x_k = x_{l-k}，k 也可以取 1..l-2 中的奇数：
+//   J = {1, 3, ..., 2b - 1}，I = {2b, 6b, ..., 2b(2b' - 1)}，
+//   I ± J 恰好是 1..4bb' - 1 中的奇数，其余的 K 用偶数代表 {2, 4, ..., l - 1 - 4bb'}，
+// 其中 b = ⌊√(l-1) / 2⌋，b' = ⌊(l-1) / 4b⌋，|K| < 2b。
+// 对 i ∈ I, j ∈ J，(α - x_{i+j})(α - x_{i-j}) ∝ F0 α² + F1 α + F2（双二次多项式）：
+//   F0 = (X_i Z_j - Z_i X_j)²，F2 = (X_i X_j - Z_i Z_j)²，
+//   F1 = -2[(X_i X_j + Z_i Z_j)(X_i Z_j + Z_i X_j) + 2 (A/C) X_i Z_i X_j Z_j]
+// 曲线 (a : a - d) 对应 Montgomery 系数 A/C = 2α/C，C = a - d，α = a + d。换成 Edwards 坐标，
+// 每一对整体乘以 C/4（每一对的公共因子对像曲线和像点都没有影响）后记
+//   sigma = Y_i²T_j² + T_i²Y_j²，rho = 2 Y_i T_i Y_j T_j，
+//   tau = 2C (T_i²T_j² - Y_i²Y_j²) + 2α (T_i² - Y_i²)(T_j² - Y_j²)，
+// 对射影点 (X : Z)，记 u = X² + Z²，v = XZ，w = X² - Z²：
+//   F0 X² + F1 XZ + F2 Z² ∝ sigma·Cu - tau·v - rho·Cw，交换 X、Z 时 rho 项变号。
+// 像点需要 h(x_Q) 与 x_Q^s h(1/x_Q)（即 yEVAL 中的两个乘积），像曲线需要 h(±1)。
+// 这里 I × J 的 bb' ≈ (l - 1)/4 对逐对计算：构造每对 7M、每个点求值每对 5M，仍是 Θ(l)，
+// 只比 Vélu（每个点 (l - 1)/2 × 4M）省常数因子。用结式计算的 √élu 见下一节：l <= LARGE_L 时
+// b、b' 不超过 6 到 8，多项式太小，l = 163 时每个点 250M 对成对 Vélu 的 219M，所以默认不用。
+// 核点只需要 b + b' + |K| 次点运算（Vélu 为 (l - 1) / 2）。
+
+static void velu_pair_sizes(uint32_t l, uint32_t *b, uint32_t *bp, uint32_t *nk) {
+    uint32_t t = 1;
+    while (4 * (t + 1) * (t + 1) <= l - 1) t++;
+    *b = t;
+    *bp = (l - 1) / (4 * t);
+    *nk = (l - 1 - 4 * t * (*bp)) / 2;
+}
+
+// J = {[1]P, [3]P, ..., [2b - 1]P}，I = {[2b]P, [6b]P, ...}，K = {[2]P, [4]P, ...}，返回 [2]P
+static void velu_pair_multiples(proj Jp[], proj Ip[], proj Kp[], proj P2, const proj P, const proj A,
+                                uint32_t b, uint32_t bp, uint32_t nk) {
+    proj P2b, P4b;
+    uint32_t j, t;
+    
+    // J：步长 [2]P
+    point_copy(Jp[0], P);
+    yDBL(P2, P, A);
+    if (b > 1) yADD(Jp[1], P2, P, P);
+    for (j = 2; j < b; j++) {
+        yADD(Jp[j], Jp[j - 1], P2, Jp[j - 2]);
+    }
+    
+    // I：步长 [4b]P
+    if (b & 1) {
+        yDBL(P2b, Jp[b >> 1], A);
+    } else {
+        yADD(P2b, Jp[b >> 1], Jp[(b >> 1) - 1], P2);
+    }
+    yDBL(P4b, P2b, A);
+    point_copy(Ip[0], P2b);
+    if (bp > 1) yADD(Ip[1], P2b, P4b, P2b);
+    for (t = 2; t < bp; t++) {
+        yADD(Ip[t], Ip[t - 1], P4b, Ip[t - 2]);
+    }
+    
+    // K：步长 [2]P
+    for (j = 0; j < nk; j++) {
+        if (j == 0) {
+            point_copy(Kp[0], P2);
+        } else if (j == 1) {
+            yDBL(Kp[1], P2, A);
+        } else {
+            yADD(Kp[j], Kp[j - 1], P2, Kp[j - 2]);
+        }
+    }
+}
+
+void yISOG_pair(velu_pair_kernel *K, proj C, const proj P, const proj A, const uint8_t i) {
+    uint32_t l = L[i], b, bp, nk, j, t, k;
+    velu_pair_sizes(l, &b, &bp, &nk);
+    assert(l >= 5 && b * bp <= VELU_PAIR_MAX_PAIRS && nk <= VELU_PAIR_MAX_K);
+    
+    proj Jp[VELU_PAIR_MAX_PAIRS], Ip[VELU_PAIR_MAX_PAIRS], P2;
+    fp jy2[VELU_PAIR_MAX_PAIRS], jt2[VELU_PAIR_MAX_PAIRS], jyt[VELU_PAIR_MAX_PAIRS], ju[VELU_PAIR_MAX_PAIRS];
+    fp By, Bz, alpha, y2, t2, yt, cy2, ct2, au, m, f;
+    
+    velu_pair_multiples(Jp, Ip, K->K, P2, P, A, b, bp, nk);
+    K->k = (uint8_t)nk;
+    K->pairs = (uint8_t)(b * bp);
+    fp_copy(&K->c, &A[1]);
+    
+    // J 一侧：Y²、T²、YT、T² - Y²
+    for (j = 0; j < b; j++) {
+        fp_sqr(&jy2[j], &Jp[j][0]);
+        fp_sqr(&jt2[j], &Jp[j][1]);
+        fp_mul(&jyt[j], &Jp[j][0], &Jp[j][1]);
+        fp_sub(&ju[j], &jt2[j], &jy2[j]);
+        FP_ADD_COMPUTED += 1;
+        FP_SQR_COMPUTED += 2;
+        FP_MUL_COMPUTED += 1;
+    }
+    
+    // α = a + d = 2a - C
+    fp_add(&alpha, &A[0], &A[0]);
+    fp_sub(&alpha, &alpha, &A[1]);
+    
+    for (t = 0, k = 0; t < bp; t++) {
+        // I 一侧：Y²、T²、2YT、2C Y²、2C T²、2α (T² - Y²)
+        fp_sqr(&y2, &Ip[t][0]);
+        fp_sqr(&t2, &Ip[t][1]);
+        fp_mul(&yt, &Ip[t][0], &Ip[t][1]);
+        fp_add(&yt, &yt, &yt);
+        fp_mul(&cy2, &A[1], &y2);
+        fp_add(&cy2, &cy2, &cy2);
+        fp_mul(&ct2, &A[1], &t2);
+        fp_add(&ct2, &ct2, &ct2);
+        fp_sub(&au, &t2, &y2);
+        fp_mul(&au, &alpha, &au);
+        fp_add(&au, &au, &au);
+        FP_ADD_COMPUTED += 5;
+        FP_SQR_COMPUTED += 2;
+        FP_MUL_COMPUTED += 4;
+        
+        for (j = 0; j < b; j++, k++) {
+            fp_mul2_add(&K->sigma[k], &y2, &jt2[j], &t2, &jy2[j]);
+            fp_mul2_sub(&K->tau[k], &ct2, &jt2[j], &cy2, &jy2[j]);
+            fp_mul(&f, &au, &ju[j]);
+            fp_add(&K->tau[k], &K->tau[k], &f);
+            fp_mul(&K->rho[k], &yt, &jyt[j]);
+            
+            // 像曲线：α = 1 时为 2C·sigma - tau，α = -1 时为 2C·sigma + tau
+            fp_mul(&m, &A[1], &K->sigma[k]);
+            fp_add(&m, &m, &m);
+            if (k == 0) {
+                fp_sub(&By, &m, &K->tau[k]);
+                fp_add(&Bz, &m, &K->tau[k]);
+            } else {
+                fp_sub(&f, &m, &K->tau[k]);
+                fp_mul(&By, &By, &f);
+                fp_add(&f, &m, &K->tau[k]);
+                fp_mul(&Bz, &Bz, &f);
+                FP_MUL_COMPUTED += 2;
+            }
+            FP_ADD_COMPUTED += 6;
+            FP_MUL_COMPUTED += 7;
+        }
+    }
+    
+    // K 中的点与 Vélu 一样直接乘入 y 坐标的分子 / 分母
+    for (j = 0; j < nk; j++) {
+        fp_mul(&By, &By, &K->K[j][0]);
+        fp_mul(&Bz, &Bz, &K->K[j][1]);
+        FP_MUL_COMPUTED += 2;
+    }
+    
+    fp al, dl;
+    ISOGENY_KERNELS[i].pow(&al, &dl, A);
+    isog_codomain(C, &al, &dl, &By, &Bz);
+}
+
+// (X : Z) = (T + Y : T - Y) 时 Cu = 2C (T² + Y²)，v = T² - Y²，Cw = 4C TY
+static inline void velu_pair_point(fp *cu, fp *v, fp *cw, const proj Q, const fp *c) {
+    fp y2, t2;
+    fp_sqr(&y2, &Q[0]);
+    fp_sqr(&t2, &Q[1]);
+    fp_add(cu, &t2, &y2);
+    fp_add(cu, cu, cu);
+    fp_mul(cu, c, cu);
+    fp_sub(v, &t2, &y2);
+    fp_mul(cw, &Q[0], &Q[1]);
+    fp_add(cw, cw, cw);
+    fp_add(cw, cw, cw);
+    fp_mul(cw, c, cw);
+    FP_ADD_COMPUTED += 5;
+    FP_SQR_COMPUTED += 2;
+    FP_MUL_COMPUTED += 3;
+}
+
+// K 中的点与 yEVAL 相同地乘入 U、V，然后 R = φ(Q)（与 yEVAL 的最后一步相同）
+static void velu_pair_finish(proj R, fp *U, fp *V, const proj Q, const proj Kp[], uint32_t nk) {
+    fp e, g;
+    for (uint32_t j = 0; j < nk; j++) {
+        fp_mul2_addsub(&e, &g, &Q[0], &Kp[j][1], &Q[1], &Kp[j][0]);
+        fp_mul(U, U, &e);
+        fp_mul(V, V, &g);
+        FP_ADD_COMPUTED += 2;
+        FP_MUL_COMPUTED += 4;
+    }
+    
+    fp_sqr(U, U);
+    fp_sqr(V, V);
+    fp_add(&e, &Q[1], &Q[0]);
+    fp_sub(&g, &Q[1], &Q[0]);
+    fp_mul2_addsub(&R[1], &R[0], U, &e, V, &g);
+    
+    FP_ADD_COMPUTED += 4;
+    FP_SQR_COMPUTED += 2;
+    FP_MUL_COMPUTED += 2;
+}
+
+// R = φ(Q)：U ∝ x_Q^s h(1/x_Q)，V ∝ h(x_Q)（即 yEVAL 中的两个乘积），最后一步与 yEVAL 相同
+void yEVAL_pair(proj R, const proj Q, const velu_pair_kernel *K) {
+    fp cu, v, cw, U, V, e, f, g;
+    
+    proj tmp_Q;
+    point_copy(tmp_Q, Q);
+    
+    velu_pair_point(&cu, &v, &cw, tmp_Q, &K->c);
+    
+    // I × J：每一对 sigma·Cu - tau·v ± rho·Cw
+    fp_mul2_sub(&e, &K->sigma[0], &cu, &K->tau[0], &v);
+    fp_mul(&g, &K->rho[0], &cw);
+    fp_add(&U, &e, &g);
+    fp_sub(&V, &e, &g);
+    for (int k = 1; k < K->pairs; k++) {
+        fp_mul2_sub(&e, &K->sigma[k], &cu, &K->tau[k], &v);
+        fp_mul(&g, &K->rho[k], &cw);
+        fp_add(&f, &e, &g);
+        fp_sub(&e, &e, &g);
+        fp_mul(&U, &U, &f);
+        fp_mul(&V, &V, &e);
+        FP_ADD_COMPUTED += 3;
+        FP_MUL_COMPUTED += 5;
+    }
+    
+    FP_ADD_COMPUTED += 3;
+    FP_MUL_COMPUTED += 3;
+    velu_pair_finish(R, &U, &V, tmp_Q, K->K, K->k);
+}
+
+// R0 = φ(Q0), R1 = φ(Q1)：每一对的系数每次只读一次，两个点的乘积交错
+void yEVAL2_pair(proj R0, proj R1, const proj Q0, const proj Q1, const velu_pair_kernel *K) {
+    fp cu0, v0, cw0, U0, V0, e0, f0, g0;
+    fp cu1, v1, cw1, U1, V1, e1, f1, g1;
+    
+    proj tmp_Q0, tmp_Q1;
+    point_copy(tmp_Q0, Q0);
+    point_copy(tmp_Q1, Q1);
+    
+    velu_pair_point(&cu0, &v0, &cw0, tmp_Q0, &K->c);
+    velu_pair_point(&cu1, &v1, &cw1, tmp_Q1, &K->c);
+    
+    fp_mul2_sub(&e0, &K->sigma[0], &cu0, &K->tau[0], &v0);
+    fp_mul2_sub(&e1, &K->sigma[0], &cu1, &K->tau[0], &v1);
+    fp_mul(&g0, &K->rho[0], &cw0);
+    fp_mul(&g1, &K->rho[0], &cw1);
+    fp_add(&U0, &e0, &g0);
+    fp_add(&U1, &e1, &g1);
+    fp_sub(&V0, &e0, &g0);
+    fp_sub(&V1, &e1, &g1);
+    for (int k = 1; k < K->pairs; k++) {
+        fp_mul2_sub(&e0, &K->sigma[k], &cu0, &K->tau[k], &v0);
+        fp_mul2_sub(&e1, &K->sigma[k], &cu1, &K->tau[k], &v1);
+        fp_mul(&g0, &K->rho[k], &cw0);
+        fp_mul(&g1, &K->rho[k], &cw1);
+        fp_add(&f0, &e0, &g0);
+        fp_add(&f1, &e1, &g1);
+        fp_sub(&e0, &e0, &g0);
+        fp_sub(&e1, &e1, &g1);
+        fp_mul(&U0, &U0, &f0);
+        fp_mul(&U1, &U1, &f1);
+        fp_mul(&V0, &V0, &e0);
+        fp_mul(&V1, &V1, &e1);
+        FP_ADD_COMPUTED += 6;
+        FP_MUL_COMPUTED += 10;
+    }
+    
+    for (int j = 0; j < K->k; j++) {
+        fp_mul2_addsub(&e0, &g0, &tmp_Q0[0], &K->K[j][1], &tmp_Q0[1], &K->K[j][0]);
+        fp_mul2_addsub(&e1, &g1, &tmp_Q1[0], &K->K[j][1], &tmp_Q1[1], &K->K[j][0]);
+        fp_mul(&U0, &U0, &e0);
+        fp_mul(&U1, &U1, &e1);
+        fp_mul(&V0, &V0, &g0);
+        fp_mul(&V1, &V1, &g1);
+        FP_ADD_COMPUTED += 4;
+        FP_MUL_COMPUTED += 8;
+    }
+    
+    fp_sqr(&U0, &U0);
+    fp_sqr(&U1, &U1);
+    fp_sqr(&V0, &V0);
+    fp_sqr(&V1, &V1);
+    fp_add(&e0, &tmp_Q0[1], &tmp_Q0[0]);
+    fp_add(&e1, &tmp_Q1[1], &tmp_Q1[0]);
+    fp_sub(&g0, &tmp_Q0[1], &tmp_Q0[0]);
+    fp_sub(&g1, &tmp_Q1[1], &tmp_Q1[0]);
+    fp_mul2_addsub(&R0[1], &R0[0], &U0, &e0, &V0, &g0);
+    fp_mul2_addsub(&R1[1], &R1[0], &U1, &e1, &V1, &g1);
+    
+    FP_ADD_COMPUTED += 14;
+    FP_SQR_COMPUTED += 4;
+    FP_MUL_COMPUTED += 10;
+}
+
+// ==================== √élu ====================
+// 与成对 Vélu 使用同一个分解 (I ± J) ∪ K 和同一个双二次多项式，但 I × J 的乘积用结式计算
+// （Bernstein–De Feo–Leroux–Smith）。把一对的值按 I 一侧的 Y_i²、T_i²、Y_i T_i 展开：
+//   sigma·Cu - tau·v ± rho·Cw = a_j Y_i² + b_j T_i² ± d_j Y_i T_i，
+//   a_j = T_j²·Cu + p_j v，b_j = Y_j²·Cu - q_j v，d_j = 2 Y_j T_j·Cw，
+//   p_j = 2C Y_j² + 2α (T_j² - Y_j²)，q_j = 2C T_j² + 2α (T_j² - Y_j²)，
+// 除以 T_i² 后是 z_i = Y_i / T_i 的二次多项式，所以 I × J 的乘积是 ∏_i E_J(±z_i) 乘以与点无关的 ∏_i T_i^{2b}，
+// E_J(z) = ∏_j (a_j z² + d_j z + b_j)。记 E_J(z) = E0(z²) + z E1(z²)，w_i = z_i²，则 E_J(±z_i) = E0(w_i) ± z_i E1(w_i)：
+//   baby step：每个点构造 E_J（b 个二次多项式的乘积树）；
+//   giant step：在 H(w) = ∏_i (w - w_i) 的乘积树上做余式树，得到 E0、E1 在全部 w_i 上的值，
+//   即结式 Res(H, E0)、Res(H, E1) 的各个因子。
+// H 的乘积树只与核有关，在 yISOG_sqrt 中构造一次（z_i 用一次批量求逆化为仿射，H 因此是首一的）。
+// 像曲线的 h(±1) 对应 (Cu, v, Cw) = (2C, ±1, 0)：d_j = 0，E_J 是 w 的 b 次多项式，同样在余式树上求值。
+// 每个点的代价为 5b M + 乘积树 + 余式树，渐近 Õ(√l)，但 l <= LARGE_L 时多项式很小，
+// 是否快于成对 Vélu 由 make run-velu-pair-benchmark 测量。
+
+// r = f·g（nf、ng 个系数），每次取两项乘积只做一次约简
+static void sqrt_poly_mul(fp *r, const fp *f, uint32_t nf, const fp *g, uint32_t ng) {
+    for (uint32_t k = 0; k < nf + ng - 1; k++) {
+        uint32_t i = k < ng ? 0 : k - ng + 1;
+        uint32_t e = k < nf ? k + 1 : nf;
+        fp t;
+        if ((e - i) & 1) {
+            fp_mul(&r[k], &f[i], &g[k - i]);
+            i++;
+        } else {
+            fp_mul2_add(&r[k], &f[i], &g[k - i], &f[i + 1], &g[k - i - 1]);
+            i += 2;
+        }
+        for (; i < e; i += 2) {
+            fp_mul2_add(&t, &f[i], &g[k - i], &f[i + 1], &g[k - i - 1]);
+            fp_add(&r[k], &r[k], &t);
+        }
+    }
+}
+
+// r = ∏_{lo <= j < hi} f_j，每个因子 c 个系数（平衡的乘积树）
+static void sqrt_poly_product(fp *r, const fp *f, uint32_t c, uint32_t lo, uint32_t hi) {
+    uint32_t n = hi - lo, m = n >> 1;
+    if (n == 1) {
+        for (uint32_t k = 0; k < c; k++) {
+            fp_copy(&r[k], &f[lo * c + k]);
+        }
+        return;
+    }
+    fp left[2 * VELU_SQRT_MAX_B + 1], right[2 * VELU_SQRT_MAX_B + 1];
+    sqrt_poly_product(left, f, c, lo, lo + m);
+    sqrt_poly_product(right, f, c, lo + m, hi);
+    sqrt_poly_mul(r, left, m * (c - 1) + 1, right, (n - m) * (c - 1) + 1);
+}
+
+// H(w) = ∏_{lo <= i < hi} (w - w_i) 的乘积树，先序存放在 *node，每个节点 hi - lo 个系数（首一，不存首项）
+static void sqrt_tree_build(fp **node, const fp *w, uint32_t lo, uint32_t hi) {
+    uint32_t n = hi - lo, m = n >> 1;
+    fp *h = *node;
+    *node += n;
+    memset(h, 0, n * sizeof(fp));
+    if (n == 1) {
+        fp_sub(&h[0], &h[0], &w[lo]);
+        return;
+    }
+    fp *left = *node;
+    sqrt_tree_build(node, w, lo, lo + m);
+    fp *right = *node;
+    sqrt_tree_build(node, w, lo + m, hi);
+    
+    // (w^m + left)(w^(n-m) + right)，乘积 left·right 的次数 < n - 1
+    fp t;
+    for (uint32_t a = 0; a < m; a++) {
+        for (uint32_t b = 0; b < n - m; b++) {
+            fp_mul(&t, &left[a], &right[b]);
+            fp_add(&h[a + b], &h[a + b], &t);
+        }
+    }
+    for (uint32_t b = 0; b < n - m; b++) {
+        fp_add(&h[m + b], &h[m + b], &right[b]);
+    }
+    for (uint32_t a = 0; a < m; a++) {
+        fp_add(&h[n - m + a], &h[n - m + a], &left[a]);
+    }
+}
+
+// f（nf 个系数）对首一的 g（n 次）原地取余，返回余式的系数个数
+static uint32_t sqrt_poly_rem(fp *f, uint32_t nf, const fp *g, uint32_t n) {
+    fp t;
+    for (uint32_t k = nf; k-- > n;) {
+        for (uint32_t a = 0; a < n; a++) {
+            fp_mul(&t, &f[k], &g[a]);
+            fp_sub(&f[k - n + a], &f[k - n + a], &t);
+        }
+    }
+    return nf < n ? nf : n;
+}
+
+// 余式树：v0[i] = f0(w_i)，v1[i] = f1(w_i)，lo <= i < hi；*node 按先序读取乘积树
+static void sqrt_multieval(fp *v0, fp *v1, const fp *f0, uint32_t n0, const fp *f1, uint32_t n1,
+                           const fp **node, uint32_t lo, uint32_t hi) {
+    uint32_t n = hi - lo;
+    fp r0[VELU_SQRT_MAX_B + 1], r1[VELU_SQRT_MAX_B + 1];
+    memcpy(r0, f0, n0 * sizeof(fp));
+    memcpy(r1, f1, n1 * sizeof(fp));
+    n0 = sqrt_poly_rem(r0, n0, *node, n);
+    n1 = sqrt_poly_rem(r1, n1, *node, n);
+    *node += n;
+    if (n == 1) {
+        fp_copy(&v0[lo], &r0[0]);
+        fp_copy(&v1[lo], &r1[0]);
+        return;
+    }
+    sqrt_multieval(v0, v1, r0, n0, r1, n1, node, lo, lo + (n >> 1));
+    sqrt_multieval(v0, v1, r0, n0, r1, n1, node, lo + (n >> 1), hi);
+}
+
+void yISOG_sqrt(velu_sqrt_kernel *K, proj C, const proj P, const proj A, const uint8_t i) {
+    uint32_t l = L[i], b, bp, nk, j, t;
+    velu_pair_sizes(l, &b, &bp, &nk);
+    assert(l >= 5 && b <= VELU_SQRT_MAX_B && bp <= VELU_SQRT_MAX_B && nk <= VELU_PAIR_MAX_K);
+    
+    proj Jp[VELU_SQRT_MAX_B], Ip[VELU_SQRT_MAX_B], P2;
+    fp c2, alpha2, ju, tinv[VELU_SQRT_MAX_B], w[VELU_SQRT_MAX_B];
+    fp fy[2 * VELU_SQRT_MAX_B], fz[2 * VELU_SQRT_MAX_B], ey[VELU_SQRT_MAX_B + 1], ez[VELU_SQRT_MAX_B + 1];
+    fp vy[VELU_SQRT_MAX_B], vz[VELU_SQRT_MAX_B], By, Bz, cy, ct;
+    
+    velu_pair_multiples(Jp, Ip, K->K, P2, P, A, b, bp, nk);
+    K->b = (uint8_t)b;
+    K->bp = (uint8_t)bp;
+    K->k = (uint8_t)nk;
+    fp_copy(&K->c, &A[1]);
+    
+    // 2C，2α = 2(a + d) = 4a - 2C
+    fp_add(&c2, &A[1], &A[1]);
+    fp_add(&alpha2, &A[0], &A[0]);
+    fp_add(&alpha2, &alpha2, &alpha2);
+    fp_sub(&alpha2, &alpha2, &c2);
+    FP_ADD_COMPUTED += 4;
+    
+    // J 一侧；像曲线的两个多项式 ∏_j (a_j w + b_j)：h(1) 取 v = 1，h(-1) 取 v = -1
+    for (j = 0; j < b; j++) {
+        fp_sqr(&K->jy2[j], &Jp[j][0]);
+        fp_sqr(&K->jt2[j], &Jp[j][1]);
+        fp_mul(&K->jyt[j], &Jp[j][0], &Jp[j][1]);
+        fp_add(&K->jyt[j], &K->jyt[j], &K->jyt[j]);
+        fp_sub(&ju, &K->jt2[j], &K->jy2[j]);
+        fp_mul2_add(&K->p[j], &c2, &K->jy2[j], &alpha2, &ju);
+        fp_mul2_add(&K->q[j], &c2, &K->jt2[j], &alpha2, &ju);
+        
+        fp_mul(&ct, &c2, &K->jt2[j]);
+        fp_mul(&cy, &c2, &K->jy2[j]);
+        fp_sub(&fy[2 * j], &cy, &K->q[j]);
+        fp_add(&fy[2 * j + 1], &ct, &K->p[j]);
+        fp_add(&fz[2 * j], &cy, &K->q[j]);
+        fp_sub(&fz[2 * j + 1], &ct, &K->p[j]);
+        FP_ADD_COMPUTED += 8;
+        FP_SQR_COMPUTED += 2;
+        FP_MUL_COMPUTED += 7;
+    }
+    
+    // I 一侧：z_i = Y_i / T_i（一次批量求逆），H(w) = ∏ (w - z_i²) 的乘积树
+    for (t = 0; t < bp; t++) {
+        fp_copy(&tinv[t], &Ip[t][1]);
+    }
+    fp_inv_batch(tinv, bp);
+    for (t = 0; t < bp; t++) {
+        fp_mul(&K->z[t], &Ip[t][0], &tinv[t]);
+        fp_sqr(&w[t], &K->z[t]);
+        FP_SQR_COMPUTED += 1;
+        FP_MUL_COMPUTED += 1;
+    }
+    fp *node = K->tree;
+    sqrt_tree_build(&node, w, 0, bp);
+    
+    // 像曲线：h(±1) 的 I × J 部分是 ∏_i E_J(w_i)
+    const fp *cnode = K->tree;
+    sqrt_poly_product(ey, fy, 2, 0, b);
+    sqrt_poly_product(ez, fz, 2, 0, b);
+    sqrt_multieval(vy, vz, ey, b + 1, ez, b + 1, &cnode, 0, bp);
+    fp_copy(&By, &vy[0]);
+    fp_copy(&Bz, &vz[0]);
+    for (t = 1; t < bp; t++) {
+        fp_mul(&By, &By, &vy[t]);
+        fp_mul(&Bz, &Bz, &vz[t]);
+        FP_MUL_COMPUTED += 2;
+    }
+    
+    // K 中的点与 Vélu 一样直接乘入 y 坐标的分子 / 分母
+    for (j = 0; j < nk; j++) {
+        fp_mul(&By, &By, &K->K[j][0]);
+        fp_mul(&Bz, &Bz, &K->K[j][1]);
+        FP_MUL_COMPUTED += 2;
+    }
+    
+    fp al, dl;
+    ISOGENY_KERNELS[i].pow(&al, &dl, A);
+    isog_codomain(C, &al, &dl, &By, &Bz);
+}
+
+// R = φ(Q)：I × J 部分 U = ∏_i E_J(z_i)，V = ∏_i E_J(-z_i)，之后与成对 Vélu 相同
+void yEVAL_sqrt(proj R, const proj Q, const velu_sqrt_kernel *K) {
+    uint32_t b = K->b, bp = K->bp, j, t;
+    fp cu, v, cw, U, V, f, g;
+    fp quad[3 * VELU_SQRT_MAX_B], e[2 * VELU_SQRT_MAX_B + 1];
+    fp e0[VELU_SQRT_MAX_B + 1], e1[VELU_SQRT_MAX_B], v0[VELU_SQRT_MAX_B], v1[VELU_SQRT_MAX_B];
+    
+    proj tmp_Q;
+    point_copy(tmp_Q, Q);
+    
+    velu_pair_point(&cu, &v, &cw, tmp_Q, &K->c);
+    
+    // baby step：E_J(z) = ∏_j (a_j z² + d_j z + b_j)
+    for (j = 0; j < b; j++) {
+        fp_mul2_sub(&quad[3 * j], &K->jy2[j], &cu, &K->q[j], &v);
+        fp_mul(&quad[3 * j + 1], &K->jyt[j], &cw);
+        fp_mul2_add(&quad[3 * j + 2], &K->jt2[j], &cu, &K->p[j], &v);
+        FP_MUL_COMPUTED += 5;
+    }
+    sqrt_poly_product(e, quad, 3, 0, b);
+    for (j = 0; j < b; j++) {
+        fp_copy(&e0[j], &e[2 * j]);
+        fp_copy(&e1[j], &e[2 * j + 1]);
+    }
+    fp_copy(&e0[b], &e[2 * b]);
+    
+    // giant step：余式树求 E0、E1 在 w_i 上的值，E_J(±z_i) = E0(w_i) ± z_i E1(w_i)
+    const fp *node = K->tree;
+    sqrt_multieval(v0, v1, e0, b + 1, e1, b, &node, 0, bp);
+    for (t = 0; t < bp; t++) {
+        fp_mul(&g, &K->z[t], &v1[t]);
+        if (t == 0) {
+            fp_add(&U, &v0[0], &g);
+            fp_sub(&V, &v0[0], &g);
+        } else {
+            fp_add(&f, &v0[t], &g);
+            fp_mul(&U, &U, &f);
+            fp_sub(&f, &v0[t], &g);
+            fp_mul(&V, &V, &f);
+            FP_MUL_COMPUTED += 2;
+        }
+        FP_ADD_COMPUTED += 2;
+        FP_MUL_COMPUTED += 1;
+    }
+    
+    velu_pair_finish(R, &U, &V, tmp_Q, K->K, K->k);
+}
+
+void yEVAL2_sqrt(proj R0, proj R1, const proj Q0, const proj Q1, const velu_sqrt_kernel *K) {
+    proj tmp_Q1;
+    point_copy(tmp_Q1, Q1);
+    yEVAL_sqrt(R0, Q0, K);
+    yEVAL_sqrt(R1, tmp_Q1, K);
+}
+
+// ==================== 根式同源（l = 3, 5, 7）====================
+// Castryck–Decru–Vercauteren：曲线 E 与 l 阶点 P 确定 Tate 形式 y² + a1 xy + a3 y = x³ + a2 x²
+// （P = (0, 0)，切线 y = 0），像曲线 E/<P> 上"继续向前"（对偶同源不回到 P）的 l 阶点对应的参数
+// 是原参数 l 次方根的有理函数。l | p + 1 时 F_p 中的 l 次方根唯一（fp_root<l>，固定指数的加法链），
+// 所以沿同一方向走 k 步只要 k 次 l 次方根，不需要挠点和 Vélu：
+//   l = 3：(a1, a3)，a2 = 0，α = ∛(-a3)，a1' = a1 - 6α，a3' = α a1 (3α - a1) + 9 a3
+//   l = 5：Tate 正规形 E(b, b)，α = ⁵√b，b' = α(α⁴ + 3α³ + 4α² + 2α + 1) / (α⁴ - 2α³ + 4α² - 3α + 1)
+//   l = 7：E(d³ - d², d² - d)，α = ⁷√(d(d - 1)²)，d' = Σ α^k N_k(d) / Σ α^k M_k(d)（见 radical_step）
+// b、d 用射影的 (X : Z) 表示，α = r / Z，r 是 X Z^(l-1)（l = 7 时 X (X - Z)² Z⁴）的 l 次方根，链上不求逆。
+// 第一个 l 阶点是随机有理点乘以 (p + 1) / l（对应正指数）；负指数在二次扭曲线
+// （Montgomery 系数 A -> -A，即 (a : c) -> (a - c : -c)，c = a - d）上走，最后扭回来。
+// 走完后用 Cardano 公式求唯一的有理2-挠点（p = 3 mod 8），把它平移到原点即得 Montgomery 系数。
+// 条件（l | p + 1，3 | p + 1，p = 3 mod 8）由 tools/gen_csidh_params.c 的 -r 检查。
+#if RADICAL_MAX_L > 0
+
+#ifndef FP256_CONST_CHAIN_ROOT3
+#error "radical isogenies need unique cube roots (3 | p + 1)"
+#endif
+
+// k = (p + 1) / l，返回 k 的位数
+static int radical_cofactor(uint64_t k[NUMBER_OF_WORDS], uint32_t l) {
+    __uint128_t carry = 1, rem = 0;
+    for (int w = 0; w < NUMBER_OF_WORDS; w++) {
+        carry += p.limbs[w];
+        k[w] = (uint64_t)carry;
+        carry >>= 64;
+    }
+    for (int w = NUMBER_OF_WORDS - 1; w >= 0; w--) {
+        __uint128_t cur = (rem << 64) | k[w];
+        k[w] = (uint64_t)(cur / l);
+        rem = cur % l;
+    }
+    int bits = 64 * NUMBER_OF_WORDS;
+    while (bits > 1 && ((k[(bits - 1) >> 6] >> ((bits - 1) & 63)) & 1) == 0) bits--;
+    return bits;
+}
+
+// Montgomery 阶梯 Q = [k]P（k 公开，每一位都是一次 yADD + 一次 yDBL）
+static void yMUL_ladder(proj Q, const proj P, const proj A, const uint64_t k[], int bits) {
+    proj R0, R1, T;
+    point_copy(R0, P);
+    yDBL(R1, P, A);
+    for (int b = bits - 2; b >= 0; b--) {
+        uint8_t bit = (k[b >> 6] >> (b & 63)) & 1;
+        fp_cswap(&R0[0], &R1[0], bit);
+        fp_cswap(&R0[1], &R1[1], bit);
+        yADD(T, R0, R1, P);
+        yDBL(R0, R0, A);
+        point_copy(R1, T);
+        fp_cswap(&R0[0], &R1[0], bit);
+        fp_cswap(&R0[1], &R1[1], bit);
+    }
+    point_copy(Q, R0);
+}
+
+// r = a x + b y（小整数系数，|a|、|b| < FP256_MONT_SMALL_COUNT），r 可以与 x、y 重叠
+static void fp_lin2(fp *r, int a, const fp *x, int b, const fp *y) {
+    fp s, t;
+    fp_mul(&s, x, fp_small(a < 0 ? -a : a));
+    fp_mul(&t, y, fp_small(b < 0 ? -b : b));
+    if (a < 0) {
+        fp_sub(r, &t, &s);
+    } else if (b < 0) {
+        fp_sub(r, &s, &t);
+    } else {
+        fp_add(r, &s, &t);
+    }
+}
+
+// Montgomery 曲线 y² = f(x) = x³ + Ax² + x 上的点 (x, y) 平移到原点、再以 u = 2y 缩放：
+//   a1 = 2L，a2 = 4(3x + A) f(x) - L²，a3 = 16 f(x)²，L = f'(x) = 3x² + 2Ax + 1
+// 只用到 y² = f(x)，不需要开方。l = 5、7 再换成 Tate 正规形的 b = -a2³ / a3²、
+// c = 1 - a1 a2 / a3（l = 7 时 d = b / c）
+static void radical_tate(fp st[2], const fp *A, const fp *x, uint32_t l) {
+    fp t, u, f, lm, a1, a2, a3;
+    fp_add(&t, x, A);
+    fp_mul(&f, &t, x);
+    fp_add(&f, &f, fp_one());
+    fp_mul(&f, &f, x);              // f(x) = x (x (x + A) + 1)
+    fp_add(&u, &t, x);              // 2x + A
+    fp_add(&t, &u, &t);             // 3x + 2A
+    fp_mul(&lm, &t, x);
+    fp_add(&lm, &lm, fp_one());     // L = x (3x + 2A) + 1
+    fp_add(&a1, &lm, &lm);
+    fp_add(&f, &f, &f);
+    fp_add(&f, &f, &f);             // 4 f(x)
+    fp_sqr(&a3, &f);
+    if (l == 3) {
+        // P 是拐点，a2 = 0
+        fp_copy(&st[0], &a1);
+        fp_copy(&st[1], &a3);
+        return;
+    }
+    fp_add(&u, &u, x);              // 3x + A
+    fp_mul(&a2, &u, &f);
+    fp_sqr(&t, &lm);
+    fp_sub(&a2, &a2, &t);
+    fp_sqr(&t, &a2);
+    fp_mul(&t, &t, &a2);
+    set_zero(&st[0]);
+    fp_sub(&st[0], &st[0], &t);     // X = -a2³
+    if (l == 5) {
+        fp_sqr(&st[1], &a3);        // Z = a3²（l = 5 时 b = c）
+    } else {
+        fp_mul(&t, &a1, &a2);
+        fp_sub(&t, &a3, &t);
+        fp_mul(&st[1], &a3, &t);    // Z = a3 (a3 - a1 a2)
+    }
+}
+
+// 沿链走一步
+static void radical_step(fp st[2], uint32_t l) {
+    fp r, t, u, h, g, z2;
+    if (l == 3) {
+        // st = (a1, a3)
+        set_zero(&r);
+        fp_sub(&r, &r, &st[1]);
+        fp_root3(&r);                       // α = ∛(-a3)
+        fp_lin2(&t, 3, &r, -1, &st[0]);
+        fp_mul(&t, &t, &r);
+        fp_mul(&t, &t, &st[0]);
+        fp_mul(&u, &st[1], fp_small(9));
+        fp_add(&st[1], &t, &u);             // a3' = α a1 (3α - a1) + 9 a3
+        fp_mul(&t, &r, fp_small(6));
+        fp_sub(&st[0], &st[0], &t);         // a1' = a1 - 6α
+        return;
+    }
+    fp *X = &st[0], *Z = &st[1];
+    fp_sqr(&z2, Z);
+#ifdef FP256_CONST_CHAIN_ROOT5
+    if (l == 5) {
+        fp z4;
+        fp_sqr(&z4, &z2);
+        fp_mul(&r, X, &z4);
+        fp_root5(&r);                       // α = r / Z
+        // 分子 r⁴ + 3r³Z + 4r²Z² + 2rZ³ + Z⁴ 与分母 r⁴ - 2r³Z + 4r²Z² - 3rZ³ + Z⁴，按 r 的 Horner 规则
+        fp_mul(&t, &z2, Z);
+        fp_lin2(&h, 1, &r, 3, Z);
+        fp_lin2(&g, 1, &r, -2, Z);
+        fp_mul(&h, &h, &r);
+        fp_mul(&g, &g, &r);
+        fp_lin2(&u, 1, &h, 4, &z2);
+        fp_lin2(&g, 1, &g, 4, &z2);
+        fp_mul(&h, &u, &r);
+        fp_mul(&g, &g, &r);
+        fp_lin2(&h, 1, &h, 2, &t);
+        fp_lin2(&g, 1, &g, -3, &t);
+        fp_mul(&h, &h, &r);
+        fp_mul(&g, &g, &r);
+        fp_add(&h, &h, &z4);
+        fp_add(&g, &g, &z4);
+        fp_mul(X, &h, &r);                  // b' = r · 分子 / (Z · 分母)
+        fp_mul(Z, &g, Z);
+        return;
+    }
+#endif
+#ifdef FP256_CONST_CHAIN_ROOT7
+    if (l == 7) {
+        // d = X / Z，r = ⁷√(X (X - Z)² Z⁴)，α = r / Z。N_k、M_k 乘以 Z² 后是 X、Z 的二次型：
+        //   N = (7X(Z - X), (Z - X)(4Z + 9X), (Z - X)(3Z - 2X), Z(4Z - 5X), Z(6X - 2Z))
+        //   M = ((Z - X)(4Z + 2X), (Z - X)(8X - 5Z), 14Z(Z - X), Z(9X - 10Z), Z(11Z + 2X))
+        // d' = Σ r^k Z^(4-k) N_k / Σ r^k Z^(4-k) M_k，按 r 的 Horner 规则从 k = 4 算起
+        fp q, zk, n, m;
+        fp_sub(&q, Z, X);
+        fp_sqr(&t, &q);
+        fp_mul(&r, &t, X);
+        fp_sqr(&t, &z2);
+        fp_mul(&r, &r, &t);
+        fp_root7(&r);
+        fp_lin2(&h, 6, X, -2, Z);
+        fp_mul(&h, &h, Z);                  // N_4
+        fp_lin2(&g, 11, Z, 2, X);
+        fp_mul(&g, &g, Z);                  // M_4
+        // k = 3：系数乘 Z
+        fp_mul(&h, &h, &r);
+        fp_mul(&g, &g, &r);
+        fp_lin2(&n, 4, Z, -5, X);
+        fp_mul(&n, &n, &z2);
+        fp_add(&h, &h, &n);
+        fp_lin2(&m, 9, X, -10, Z);
+        fp_mul(&m, &m, &z2);
+        fp_add(&g, &g, &m);
+        // k = 2：系数乘 Z²
+        fp_mul(&h, &h, &r);
+        fp_mul(&g, &g, &r);
+        fp_mul(&zk, &q, &z2);               // (Z - X) Z²
+        fp_lin2(&n, 3, Z, -2, X);
+        fp_mul(&n, &n, &zk);
+        fp_add(&h, &h, &n);
+        fp_mul(&m, Z, fp_small(14));
+        fp_mul(&m, &m, &zk);
+        fp_add(&g, &g, &m);
+        // k = 1：系数乘 Z³
+        fp_mul(&h, &h, &r);
+        fp_mul(&g, &g, &r);
+        fp_mul(&zk, &zk, Z);                // (Z - X) Z³
+        fp_lin2(&n, 4, Z, 9, X);
+        fp_mul(&n, &n, &zk);
+        fp_add(&h, &h, &n);
+        fp_lin2(&m, 8, X, -5, Z);
+        fp_mul(&m, &m, &zk);
+        fp_add(&g, &g, &m);
+        // k = 0：系数乘 Z⁴
+        fp_mul(&h, &h, &r);
+        fp_mul(&g, &g, &r);
+        fp_mul(&zk, &zk, Z);                // (Z - X) Z⁴
+        fp_mul(&n, X, fp_small(7));
+        fp_mul(&n, &n, &zk);
+        fp_lin2(&m, 4, Z, 2, X);
+        fp_mul(&m, &m, &zk);
+        fp_add(X, &h, &n);
+        fp_add(Z, &g, &m);
+        return;
+    }
+#endif
+    (void)t;
+    (void)u;
+    (void)h;
+    (void)g;
+}
+
+// 链的终点换回 Montgomery 系数 A = An / Ad。(2y + a1 x + a3)² = 4x³ + b2 x² + 2b4 x + b6，
+// b2 = a1² + 4a2，b4 = a1 a3，b6 = a3²。令 v = 12x + b2，三次方程化为 v³ + 3Hv + 2G = 0，
+//   H = 24b4 - b2²，G = b2(b2² - 36b4) + 216b6，
+// 唯一的 F_p 根 v = c - H / c，c = ∛(√(G² + H³) - G)（p = 2 mod 3 时立方根唯一）。
+// 平移后 Montgomery 系数 A = (3x + b2/4) / √f'(x)，取本身是平方数的平方根（指数 (p+1)/4），
+// 化简得 A = 3v / (3n² + 6 b2 n + 72 b4)^((p+1)/4)，n = v - b2；v 用 (c² - H : c) 表示，
+// 根号里乘 c⁴ 后结果正好多一个因子 c²，不需要求逆。
+static void radical_montgomery(fp *An, fp *Ad, const fp st[2], uint32_t l) {
+    fp a1, a2, a3, b2, b4, b6, t, u, h, g, c, vn, nn;
+    if (l == 3) {
+        fp_copy(&a1, &st[0]);
+        set_zero(&a2);
+        fp_copy(&a3, &st[1]);
+    } else if (l == 5) {
+        // E(b, b)，b = X / Z，整体按权重乘以 Z 的幂：(a1, a2, a3) = (Z - X, -XZ, -XZ²)
+        fp_sub(&a1, &st[1], &st[0]);
+        fp_mul(&a2, &st[0], &st[1]);
+        set_zero(&t);
+        fp_sub(&a2, &t, &a2);
+        fp_mul(&a3, &a2, &st[1]);
+    } else {
+        // E(d³ - d², d² - d)，d = X / Z：(a1, a2, a3) = (Z² + X(Z - X), X²(Z - X)Z, X²(Z - X)Z³)
+        fp_sub(&t, &st[1], &st[0]);
+        fp_mul(&a1, &st[0], &t);
+        fp_sqr(&u, &st[1]);
+        fp_add(&a1, &a1, &u);
+        fp_mul(&a2, &st[0], &t);
+        fp_mul(&a2, &a2, &st[0]);
+        fp_mul(&a2, &a2, &st[1]);
+        fp_mul(&a3, &a2, &u);
+    }
+    fp_sqr(&b2, &a1);
+    fp_add(&t, &a2, &a2);
+    fp_add(&t, &t, &t);
+    fp_add(&b2, &b2, &t);
+    fp_mul(&b4, &a1, &a3);
+    fp_sqr(&b6, &a3);
+
+    fp b4_12;
+    fp_mul(&b4_12, &b4, fp_small(12));
+    fp_sqr(&u, &b2);
+    fp_add(&h, &b4_12, &b4_12);
+    fp_sub(&h, &h, &u);                     // H = 24b4 - b2²
+    fp_mul(&t, &b4_12, fp_small(3));
+    fp_sub(&g, &u, &t);
+    fp_mul(&g, &g, &b2);
+    fp_mul(&t, &b6, fp_small(6));
+    fp_mul(&t, &t, fp_small(6));
+    fp_mul(&t, &t, fp_small(6));
+    fp_add(&g, &g, &t);                     // G = b2(b2² - 36b4) + 216b6
+
+    fp_sqr(&t, &g);
+    fp_sqr(&u, &h);
+    fp_mul(&u, &u, &h);
+    fp_add(&t, &t, &u);
+    fp_sqrt(&t);
+    fp_sub(&c, &t, &g);
+    fp_root3(&c);
+    fp_sqr(&vn, &c);
+    fp_sub(&vn, &vn, &h);                   // v = vn / c
+
+    fp_mul(&t, &b2, &c);
+    fp_sub(&nn, &vn, &t);                   // n = nn / c
+    fp_add(&t, &t, &t);
+    fp_add(&t, &t, &nn);
+    fp_mul(&t, &t, &nn);
+    fp_sqr(&u, &c);
+    fp_mul(&u, &u, &b4_12);
+    fp_add(&u, &u, &u);
+    fp_add(&t, &t, &u);                     // (n² + 2 b2 n + 24 b4) c²
+    fp_sqr(&u, &c);
+    fp_mul(&t, &t, &u);
+    fp_mul(&t, &t, fp_small(3));
+    fp_sqrt(&t);
+    fp_copy(Ad, &t);
+    fp_mul(An, &vn, &c);
+    fp_mul(An, An, fp_small(3));      // A = 3 vn c / Ad
+}
+
+// C = [l_i]^e A，e 按密钥的编码 ec = (|e| << 1) | (e >= 0)；总是走 B[i] 步，
+// 第 |e| 步的状态用常量时间交换选出。C 可以与 A 重叠
+void yRADICAL(proj C, const proj A, const uint8_t i, const uint8_t ec) {
+    const uint32_t l = L[i];
+    const uint8_t twist = (ec & 1) ^ 1, steps = ec >> 1;
+    fp zero, t, u;
+    set_zero(&zero);
+
+    // 负指数：在扭曲线 (a - c : -c) 上走
+    proj Aw, P;
+    point_copy(Aw, A);
+    fp_sub(&t, &A[0], &A[1]);
+    fp_sub(&u, &zero, &A[1]);
+    fp_cswap(&Aw[0], &t, twist);
+    fp_cswap(&Aw[1], &u, twist);
+
+    // Montgomery 系数 A = 2(2a - c) / c；Elligator 在 A = 0 时退化（T+ = T- 是 2-挠点），
+    // 所以直接取随机 x，x³ + Ax² + x 是平方时 (x - 1 : x + 1) 是曲线上的有理点
+    fp inv, x, Am, f;
+    fp_copy(&inv, &Aw[1]);
+    fp_inv(&inv);
+    fp_add(&Am, &Aw[0], &Aw[0]);
+    fp_sub(&Am, &Am, &Aw[1]);
+    fp_add(&Am, &Am, &Am);
+    fp_mul(&Am, &Am, &inv);
+
+    uint64_t k[NUMBER_OF_WORDS];
+    int bits = radical_cofactor(k, l);
+    uint8_t found = 0;
+    while (!found) {
+        fp_random(&x);
+        fp_add(&f, &x, &Am);
+        fp_mul(&f, &f, &x);
+        fp_add(&f, &f, fp_one());
+        fp_mul(&f, &f, &x);
+        if (fp_iszero(&f) || !fp_issquare(&f)) continue;
+        fp_sub(&P[0], &x, fp_one());
+        fp_add(&P[1], &x, fp_one());
+        yMUL_ladder(P, P, Aw, k, bits);
+        found = !isinfinity(P);
+    }
+
+    // l 阶点的 x = (T + Y) / (T - Y)
+    fp xn, xd;
+    fp_add(&xn, &P[1], &P[0]);
+    fp_sub(&xd, &P[1], &P[0]);
+    fp_inv(&xd);
+    fp_mul(&x, &xn, &xd);
+
+    fp st[2], sel[2];
+    radical_tate(st, &Am, &x, l);
+    fp_copy(&sel[0], &st[0]);
+    fp_copy(&sel[1], &st[1]);
+    for (uint8_t j = 1; j <= (uint8_t)B[i]; j++) {
+        radical_step(st, l);
+        fp_copy(&t, &st[0]);
+        fp_copy(&u, &st[1]);
+        uint8_t take = (uint8_t)isequal(j, steps);
+        fp_cswap(&sel[0], &t, take);
+        fp_cswap(&sel[1], &u, take);
+    }
+
+    fp An, Ad;
+    radical_montgomery(&An, &Ad, sel, l);
+    fp_sub(&t, &zero, &An);
+    fp_cswap(&An, &t, twist);               // 扭回来：A -> -A
+    // (a : c) = (A + 2 : 4)
+    fp_add(&C[1], &Ad, &Ad);
+    fp_add(&C[0], &An, &C[1]);
+    fp_add(&C[1], &C[1], &C[1]);
+}
+
+#endif // RADICAL_MAX_L > 0
+
+// ==================== CSURF：曲面上的2-同源 ====================
+// Castryck–Decru：p = 7 mod 8 时 Montgomery 曲线 y² = x³ + Ax² + x 都在底层（floor，有理2-挠点只有 (0, 0)），
+// 与上层（surface）的 Montgomery⁻ 形 y² = x³ + A⁻x² - x 之间由核为 (0, 0) 的2-同源一一对应：
+//   上：A⁻ = -2A / √(4 - A²)，下：A = -2A⁻ / √(A⁻² + 4)
+// 上层曲线的2-挠点全部有理：(0, 0) 指向底层，x² + A⁻x - 1 的两个根是水平方向，是平方数的那个根 x0
+// （即 (A ± 2) / √(4 - A²) 中的平方数）对应正指数。以 x0 为核走一步：
+//   b = 3 x0 + A⁻，v = -√(x0² + 1)，s = √(-v (b + 2v))，A⁻' = (b + 6v) / 2s，x0' = -2v / s
+// √ 都是 x^((p+1)/4)，p = 7 mod 8 时结果本身是平方数，所以符号是确定的；下一步的 x0' 不需要再开方，
+// 每步两次平方根加一次求逆。上下两层的群作用与奇数次同源交换，2-同源放在群作用最后；
+// 负指数同样在扭曲线（A -> -A）上走。条件由 tools/gen_csidh_params.c 检查（-l 含 2）。
+#if CSURF
+
+void yCSURF(proj C, const proj A, const uint8_t i, const uint8_t ec) {
+    const uint8_t twist = (ec & 1) ^ 1, steps = ec >> 1;
+    const fp *two = fp_small(2), *four = fp_small(4);
+    fp zero, t, w, inv, Am, am, x0, b, v, s, sel;
+    set_zero(&zero);
+
+    // Montgomery 系数 A = 2(2a - c) / c，负指数取 -A
+    fp_copy(&inv, &A[1]);
+    fp_inv(&inv);
+    fp_add(&Am, &A[0], &A[0]);
+    fp_sub(&Am, &Am, &A[1]);
+    fp_add(&Am, &Am, &Am);
+    fp_mul(&Am, &Am, &inv);
+    fp_sub(&t, &zero, &Am);
+    fp_cswap(&Am, &t, twist);
+
+    // 上：1 / √(4 - A²) 同时用于 A⁻ 与 x0
+    fp_sqr(&t, &Am);
+    fp_sub(&inv, four, &t);
+    fp_sqrt(&inv);
+    fp_inv(&inv);
+    fp_add(&am, &Am, &Am);
+    fp_sub(&am, &zero, &am);
+    fp_mul(&am, &am, &inv);
+    fp_add(&t, &Am, two);
+    fp_sub(&w, &Am, two);
+    fp_cswap(&t, &w, fp_issquare(&t) ^ 1);
+    fp_mul(&x0, &t, &inv);
+
+    fp_copy(&sel, &am);
+    for (uint8_t j = 1; j <= (uint8_t)B[i]; j++) {
+        fp_add(&b, &x0, &x0);
+        fp_add(&b, &b, &x0);
+        fp_add(&b, &b, &am);                // b = 3 x0 + A⁻
+        fp_sqr(&v, &x0);
+        fp_add(&v, &v, fp_one());
+        fp_sqrt(&v);
+        fp_sub(&v, &zero, &v);              // v = -√(x0² + 1)
+        fp_add(&t, &v, &v);
+        fp_add(&t, &t, &b);
+        fp_mul(&t, &t, &v);
+        fp_sub(&s, &zero, &t);
+        fp_sqrt(&s);                        // s = √(-v (b + 2v))
+        fp_add(&inv, &s, &s);
+        fp_inv(&inv);                       // 1 / 2s
+        fp_add(&t, &v, &v);
+        fp_add(&w, &t, &t);                 // 4v
+        fp_add(&t, &t, &w);
+        fp_add(&t, &t, &b);
+        fp_mul(&am, &t, &inv);              // A⁻' = (b + 6v) / 2s
+        fp_sub(&w, &zero, &w);
+        fp_mul(&x0, &w, &inv);              // x0' = -4v / 2s
+        fp_copy(&t, &am);
+        fp_cswap(&sel, &t, (uint8_t)isequal(j, steps));
+    }
+
+    // 下：A = -2A⁻ / √(A⁻² + 4)，再扭回来
+    fp_sqr(&t, &sel);
+    fp_add(&t, &t, four);
+    fp_sqrt(&t);
+    fp_inv(&t);
+    fp_add(&Am, &sel, &sel);
+    fp_sub(&Am, &zero, &Am);
+    fp_mul(&Am, &Am, &t);
+    fp_sub(&t, &zero, &Am);
+    fp_cswap(&Am, &t, twist);
+    // (a : c) = (A + 2 : 4)
+    fp_add(&C[0], &Am, two);
+    fp_copy(&C[1], four);
+}
+
+#endif // CSURF
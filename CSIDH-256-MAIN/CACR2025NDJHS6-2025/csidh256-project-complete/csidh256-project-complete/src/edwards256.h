@@ -10,11 +10,10 @@
 // 注意：proj是数组类型，作为参数传递时自动转换为指针
 typedef fp proj[2];
 
-// 全局公共曲线E（同构于 y^2 = x^3 + x）
-// 在实现文件中定义（非const，因为需要初始化）
-extern proj E;
+// 全局公共曲线E（同构于 y^2 = x^3 + x），构建时生成的只读常量
+extern const proj E;
 
-// 初始化公共曲线E
+// 旧的初始化入口，现在是空操作（保留兼容）
 void init_public_curve(void);
 
 // Edwards曲线运算
@@ -22,23 +21,109 @@ int isinfinity(const proj P);
 void point_copy(proj Q, const proj P);
 uint8_t areEqual(const proj P, const proj Q);
 
+// 批量归一化：out[i] = Ps[i][0] / Ps[i][1]（a / (a - d)），只做一次求逆，结果规约到 [0, p)
+void proj_normalize_batch(fp out[], const proj Ps[], size_t n);
+
 void yDBL(proj Q, const proj P, const proj A);
 void yADD(proj R, const proj P, const proj Q, const proj PQ);
 void yMUL(proj Q, const proj P, const proj A, uint8_t const i);
+// 按差分加法链计算 [k]P：分组余因子乘法用（COFACTOR_CHAIN），yMUL 是 k = l_i 的特例
+void yMUL_chain(proj Q, const proj P, const proj A, uint32_t chain, uint8_t length);
+// [k]P，k 是 p 的余因子 COFACTOR（p + 1 = 4 * ∏ l_i * k，见 csidh256_params.h）：Elligator 点乘以 4 和补集后再乘 k
+void yMUL_cofactor(proj Q, const proj P, const proj A);
+// T+ / T- 双点版本：两个点做同样的运算，域运算交错执行（结果与分别调用相同）
+void yDBL2(proj Q0, proj Q1, const proj P0, const proj P1, const proj A);
+void yMUL2(proj Q0, proj Q1, const proj P0, const proj P1, const proj A, uint8_t const i);
+void yMUL2_chain(proj Q0, proj Q1, const proj P0, const proj P1, const proj A, uint32_t chain, uint8_t length);
 
 void elligator(proj T_plus, proj T_minus, const proj A);
 
+// 公共曲线E的预计算扭点（src/edwards256_torsion.h）：A 等于E时返回 1；
+// precomputed_torsion 给出 SIMBA 批次 m 的 T+ / T-，已乘以 4、余因子 k 和批次 m 的补集中的 l_i
+uint8_t has_precomputed_torsion(const proj A);
+void precomputed_torsion(proj T_plus, proj T_minus, uint8_t m);
+
 void cofactor_multiples(proj P[], const proj A, int8_t lower, int8_t upper);
 uint8_t validate(const proj A);
 
 // 同源计算
 void yISOG(proj Pk[], proj C, const proj P, const proj A, const uint8_t i);
 void yEVAL(proj R, const proj Q, const proj Pk[], const uint8_t i);
+void yEVAL2(proj R0, proj R1, const proj Q0, const proj Q1, const proj Pk[], const uint8_t i);
+
+// 成对 Vélu：核 {[k]P} 按 √élu（Bernstein–De Feo–Leroux–Smith）的方式分解为 (I ± J) ∪ K，
+// |I|、|J| ≈ √l/2，但不用乘积树 / 结式，I × J 中的每一对直接用一个双二次多项式覆盖两个
+// l_i 的倍数。yISOG_pair 生成每一对的系数，求值时每对 5M、K 中每个点 4M，
+// 约为 Vélu（每个点 4M）的 5/8，代价仍与 l 成正比；要求 L[i] >= 5。
+// 哪些 l_i 使用成对 Vélu 由 VELU_PAIR[] 决定（make run-velu-pair-benchmark 测出的交叉点）。
+#define VELU_PAIR_MAX_PAIRS ((LARGE_L - 1) / 4)
+#define VELU_PAIR_MAX_K ((LARGE_L - 1) / 8 + 2)
+typedef struct {
+    uint8_t pairs;                      // |I| * |J|
+    uint8_t k;                          // |K|
+    fp c;                               // 核所在曲线的 C = a - d
+    fp sigma[VELU_PAIR_MAX_PAIRS];      // 每一对的双二次多项式（见 yISOG_pair）
+    fp tau[VELU_PAIR_MAX_PAIRS];
+    fp rho[VELU_PAIR_MAX_PAIRS];
+    proj K[VELU_PAIR_MAX_K];            // [2]P, [4]P, ..., [l - 1 - 4|I||J|]P
+} velu_pair_kernel;
+
+void yISOG_pair(velu_pair_kernel *K, proj C, const proj P, const proj A, const uint8_t i);
+void yEVAL_pair(proj R, const proj Q, const velu_pair_kernel *K);
+void yEVAL2_pair(proj R0, proj R1, const proj Q0, const proj Q1, const velu_pair_kernel *K);
+
+// √élu（Bernstein–De Feo–Leroux–Smith）：分解与成对 Vélu 相同，I × J 的乘积不逐对计算，
+// 而是对每个点构造 E_J（|J| 个二次多项式的乘积树），在 ∏_{i∈I} (w - z_i²) 的乘积树上用余式树
+// 求结式（见 src/edwards256.c）；要求 L[i] >= 5。哪些 l_i 使用 √élu 由 VELU_SQRT[] 决定，
+// 优先于 VELU_PAIR[]；make run-velu-pair-benchmark 同时给出两者与 Vélu 的对比。
+typedef struct {
+    uint8_t b;                                  // |J|
+    uint8_t bp;                                 // |I|
+    uint8_t k;                                  // |K|
+    fp c;                                       // 核所在曲线的 C = a - d
+    fp jy2[VELU_SQRT_MAX_B];                    // J 一侧的 Y²、T²、2YT
+    fp jt2[VELU_SQRT_MAX_B];
+    fp jyt[VELU_SQRT_MAX_B];
+    fp p[VELU_SQRT_MAX_B];                      // 2C Y² + 2α (T² - Y²)
+    fp q[VELU_SQRT_MAX_B];                      // 2C T² + 2α (T² - Y²)
+    fp z[VELU_SQRT_MAX_B];                      // I 一侧的仿射坐标 z_i = Y_i / T_i
+    fp tree[VELU_SQRT_MAX_B * VELU_SQRT_MAX_B]; // ∏ (w - z_i²) 的乘积树（先序，首一，不存首项）
+    proj K[VELU_PAIR_MAX_K];                    // 与成对 Vélu 相同
+} velu_sqrt_kernel;
+
+void yISOG_sqrt(velu_sqrt_kernel *K, proj C, const proj P, const proj A, const uint8_t i);
+void yEVAL_sqrt(proj R, const proj Q, const velu_sqrt_kernel *K);
+void yEVAL2_sqrt(proj R0, proj R1, const proj Q0, const proj Q1, const velu_sqrt_kernel *K);
+
+// 根式同源（Castryck–Decru–Vercauteren，l = 3, 5, 7）：C = [l_i]^e A，ec 是密钥中 l_i 的编码。
+// 每一步是一次 l 次方根，不需要挠点；哪些 l_i 这样处理由 RADICAL[] 决定（make params 的 -r），
+// 这些 l_i 不进 SIMBA 批次，由 action_radical 在群作用最后处理
+#if RADICAL_MAX_L > 0
+void yRADICAL(proj C, const proj A, const uint8_t i, const uint8_t ec);
+#endif
+
+// CSURF（p = 7 mod 8，L 的最后一项是 2）：C = [l_i]^e A，l_i = 2，走 |e| 步曲面上的2-同源，
+// 每步两次平方根；同样不进 SIMBA 批次，由 action_radical 处理
+#if CSURF
+void yCSURF(proj C, const proj A, const uint8_t i, const uint8_t ec);
+#endif
 
 // CSIDH action
 void action_evaluation(proj C, const uint8_t key[], const proj A);
+// 群作用中根式同源和 CSURF 的部分（action_evaluation 与多缓冲版本最后调用；没有 RADICAL[i] 时只复制 A）
+void action_radical(proj C, const uint8_t key[], const proj A);
 void random_key(uint8_t key[]);
 void printf_key(uint8_t key[], char *c);
 
+// 紧凑私钥：32字节种子，在群作用内部用常量时间拒绝采样确定性展开为指数向量
+// （与 random_key 的分布相同），存储与清零都是定长的
+#define SEED_BYTES 32
+void random_seed(uint8_t seed[SEED_BYTES]);
+void key_from_seed(uint8_t key[], const uint8_t seed[SEED_BYTES]);
+// 由主种子派生第 index 个种子（index != 2^64 - 1），不需要存储派生出的密钥
+void seed_derive(uint8_t seed[SEED_BYTES], const uint8_t master[SEED_BYTES], uint64_t index);
+void action_evaluation_seed(proj C, const uint8_t seed[SEED_BYTES], const proj A);
+void printf_seed(const uint8_t seed[SEED_BYTES], char *c);
+
 #endif // EDWARDS256_H
 
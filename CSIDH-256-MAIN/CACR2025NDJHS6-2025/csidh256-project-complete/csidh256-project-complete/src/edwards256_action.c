@@ -5,35 +5,102 @@
 #include <stdlib.h>
 #include <stdio.h>
 
+// 把 [0, B] 中的 tmp 映射为 [-B, B] 中与 B 同奇偶的指数，编码为 (|e| << 1) | (e >= 0)
+static uint8_t encode_exponent(uint8_t tmp, uint8_t b) {
+    int8_t exp, sgn;
+    uint8_t r = b & 0x1;
+    
+    exp = (int8_t)tmp;
+    
+    // 映射到 [-B/2, B/2] 或 [-(B+1)/2, (B-1)/2]
+    exp = ((exp << 1) - (b + r)) >> 1;
+    
+    // 映射到 [-B, B]
+    exp = (exp << 1) + r;
+    sgn = exp >> 7;
+    
+    cmov(&exp, -exp, sgn == -1);
+    return (uint8_t)((exp << 1) ^ (1 & (1 + sgn)));
+}
+
 // 密钥生成
 void random_key(uint8_t key[]) {
-    uint8_t i, tmp, r;
-    int8_t exp, sgn;
+    uint8_t i, tmp;
+    uint8_t rnd[N];
+    
+    // 一次取出所有指数需要的随机字节（每线程DRBG的批量接口）
+    randombytes(rnd, sizeof(rnd));
     
     for (i = 0; i < N; i++) {
-        r = B[i] & 0x1;
-        
         // 从 [0, B[i]] 中随机选择exp（使用密码学安全的RNG）
-        extern void randombytes(void *x, size_t l);
-        randombytes(&tmp, 1);
-        tmp = tmp % (B[i] + 1);
+        tmp = rnd[i] % (B[i] + 1);
         while (issmaller((int32_t)B[i], (int32_t)tmp) == -1) {
             randombytes(&tmp, 1);
             tmp = tmp % (B[i] + 1);
         }
-        
-        exp = (int8_t)tmp;
-        
-        // 映射到 [-B/2, B/2] 或 [-(B+1)/2, (B-1)/2]
-        exp = ((exp << 1) - (B[i] + r)) >> 1;
-        
-        // 映射到 [-B, B]
-        exp = (exp << 1) + r;
-        sgn = exp >> 7;
-        
-        cmov(&exp, -exp, sgn == -1);
-        key[i] = (exp << 1) ^ (1 & (1 + sgn));
+        key[i] = encode_exponent(tmp, (uint8_t)B[i]);
+    }
+    rng_zeroize(rnd, sizeof(rnd));
+}
+
+// ==================== 紧凑私钥（32字节种子）====================
+
+void random_seed(uint8_t seed[SEED_BYTES]) {
+    randombytes(seed, SEED_BYTES);
+}
+
+// 常量时间拒绝采样：每个指数取 KEY_SAMPLES 个候选字节，掩码到不小于 B 的最小 2^k - 1，
+// 用 cmov 式的位运算选出第一个 <= B 的候选，分支和访存与种子无关。
+// 接受率至少 1/2，全部被拒绝的概率 <= 2^-64；这种情况下用下一个 nonce 再取一轮（结果仍确定）。
+#define KEY_SAMPLES 64
+#define KEY_EXPAND_NONCE 0xFFFFFFFFFFFFFFFFULL  // seed_derive 的 index 不会用到这个值
+
+void key_from_seed(uint8_t key[], const uint8_t seed[SEED_BYTES]) {
+    uint8_t stream[N][KEY_SAMPLES];
+    uint32_t found[N] = {0}, val[N] = {0}, pending = N;
+    
+    for (uint64_t round = 0; pending != 0; round++) {
+        rng_expand(stream, sizeof(stream), seed, KEY_EXPAND_NONCE - round);
+        pending = 0;
+        for (int i = 0; i < N; i++) {
+            uint32_t b = (uint32_t)B[i], mask = b;
+            mask |= mask >> 1;
+            mask |= mask >> 2;
+            mask |= mask >> 4;
+            for (int j = 0; j < KEY_SAMPLES; j++) {
+                uint32_t t = stream[i][j] & mask;
+                uint32_t take = ((t - (b + 1)) >> 31) & ~found[i] & 1;  // t <= b 且还没有选中
+                val[i] = (val[i] & (take - 1)) | (t & -take);
+                found[i] |= take;
+            }
+            pending += 1 - found[i];
+        }
+    }
+    
+    for (int i = 0; i < N; i++) {
+        key[i] = encode_exponent((uint8_t)val[i], (uint8_t)B[i]);
+    }
+    rng_zeroize(stream, sizeof(stream));
+    rng_zeroize(val, sizeof(val));
+}
+
+void seed_derive(uint8_t seed[SEED_BYTES], const uint8_t master[SEED_BYTES], uint64_t index) {
+    rng_expand(seed, SEED_BYTES, master, index);
+}
+
+void action_evaluation_seed(proj C, const uint8_t seed[SEED_BYTES], const proj A) {
+    uint8_t key[N];
+    key_from_seed(key, seed);
+    action_evaluation(C, key, A);
+    rng_zeroize(key, sizeof(key));
+}
+
+void printf_seed(const uint8_t seed[SEED_BYTES], char *c) {
+    printf("%s := ", c);
+    for (int i = 0; i < SEED_BYTES; i++) {
+        printf("%02x", seed[i]);
     }
+    printf("\n");
 }
 
 // 打印密钥
@@ -62,6 +129,83 @@ static uint32_t lookup(size_t pos, int8_t const priv[]) {
     return r;
 }
 
+// ==================== 最优策略 ====================
+// 一轮中按 l_i 从小到大做 n 个同源，第 t 个的核点是 [∏_{u>t} l_u]T±。策略把 [lo, hi) 分成
+// [lo, mid) 和 [mid, hi)：(T+, T-) 乘以 [mid, hi) 中的 l_u 后压栈先处理左半，栈里的点对在每次同源后
+// 求值（另一侧的点再乘以 l_t），然后处理右半。strategy 是先序排列的 mid - lo（n - 1 项）。
+// 完整批次的策略由 tools/gen_csidh_params.c 预先算好；有 l_i 已做完的批次在这里用同一个代价模型重新求。
+// 哪些 l_i 已做完与私钥无关，策略不泄露密钥。
+
+static void point_cswap(proj P, proj Q, uint8_t c) {
+    fp_cswap(&P[0], &Q[0], c);
+    fp_cswap(&P[1], &Q[1], c);
+}
+
+static void optimal_strategy(uint8_t strategy[], const uint8_t primes[], uint8_t n) {
+    uint32_t cost[N + 1][N + 1];
+    uint8_t split[N + 1][N + 1];
+    for (uint8_t lo = 0; lo < n; lo++) {
+        cost[lo][lo + 1] = 0;
+    }
+    for (uint8_t len = 2; len <= n; len++) {
+        for (uint8_t lo = 0; lo + len <= n; lo++) {
+            uint8_t hi = lo + len;
+            uint32_t best = UINT32_MAX, right = 0, left = 0;
+            for (uint8_t u = lo + 1; u < hi; u++) {
+                right += STRATEGY_MUL_COST[primes[u]];
+            }
+            for (uint8_t mid = lo + 1; mid < hi; mid++) {
+                left += 2 * STRATEGY_EVAL_COST[primes[mid - 1]] + STRATEGY_MUL_COST[primes[mid - 1]];
+                // 左半只有一个 l_i 时只乘选中的点
+                uint32_t c = ((mid - lo == 1) ? 1 : 2) * right + left + cost[lo][mid] + cost[mid][hi];
+                if (c < best) {
+                    best = c;
+                    split[lo][hi] = mid - lo;
+                }
+                right -= STRATEGY_MUL_COST[primes[mid]];
+            }
+            cost[lo][hi] = best;
+        }
+    }
+    uint8_t stack_lo[N], stack_hi[N], k = 0;
+    int top = 0;
+    stack_lo[0] = 0;
+    stack_hi[0] = n;
+    while (top >= 0) {
+        uint8_t lo = stack_lo[top], hi = stack_hi[top];
+        top--;
+        if (hi - lo < 2) continue;
+        strategy[k++] = split[lo][hi];
+        top++;
+        stack_lo[top] = lo + split[lo][hi];
+        stack_hi[top] = hi;
+        top++;
+        stack_lo[top] = lo;
+        stack_hi[top] = lo + split[lo][hi];
+    }
+}
+
+// 根式同源的 l_i（RADICAL[i]）不在任何批次里，SIMBA 做完后逐个用 yRADICAL 处理
+void action_radical(proj C, const uint8_t key[], const proj A) {
+    point_copy(C, A);
+#if RADICAL_MAX_L > 0 || CSURF
+    for (uint8_t i = 0; i < N; i++) {
+        if (!RADICAL[i]) continue;
+#if CSURF
+        if (L[i] == 2) {
+            yCSURF(C, C, i, key[i]);
+            continue;
+        }
+#endif
+#if RADICAL_MAX_L > 0
+        yRADICAL(C, C, i, key[i]);
+#endif
+    }
+#else
+    (void)key;
+#endif
+}
+
 // CSIDH action evaluation (SIMBA算法)
 void action_evaluation(proj C, const uint8_t key[], const proj A) {
     // SIMBA参数
@@ -92,21 +236,32 @@ void action_evaluation(proj C, const uint8_t key[], const proj A) {
     int8_t ec = 0;
     uint16_t count = 0;
     proj G[2], K[(LARGE_L >> 1) + 1];
+    velu_pair_kernel Ks;
+    velu_sqrt_kernel Kq;
     uint8_t finished[N];
-    memset(finished, 0, sizeof(uint8_t) * N);
     
+    // 根式同源的 l_i 在 SIMBA 中一开始就算做完（只在补集里）
     int8_t counter[N];
-    memset(counter, 0, sizeof(int8_t) * N);
-    memcpy(counter, B, sizeof(int8_t) * N);
+    for (uint8_t r = 0; r < N; r++) {
+        counter[r] = RADICAL[r] ? 0 : B[r];
+        finished[r] = RADICAL[r];
+    }
     uint64_t isog_counter = 0;
     
-    uint8_t last_isogeny[NUMBER_OF_BATCHES];
-    memcpy(last_isogeny, LAST_ISOGENY, sizeof(uint8_t) * NUMBER_OF_BATCHES);
-    uint32_t bc;
+    uint32_t bc = 0;
+    
+    // 策略执行：本轮的l_i、策略、点对栈
+    uint8_t primes[N], strategy[N], stack_lo[N], stack_hi[N];
+    proj stack[N][2], T;
+    
+    // 从公共曲线E出发（密钥生成）时，还没有做过同源的轮次直接用预计算扭点
+    uint8_t from_E = has_precomputed_torsion(A);
     
     // 主循环
     uint8_t m = 0, i, j;
     uint64_t number_of_batches = NUMBER_OF_BATCHES;
+    // 仍在使用初始批次时，补集的前 SIZE_OF_EACH_COMPLEMENT_BATCH[m] 项就是生成时分组的 l_i
+    uint8_t initial_batches = 1;
     
     while (isog_counter < NUMBER_OF_ISOGENIES) {
         m = (m + 1) % number_of_batches;
@@ -116,85 +271,158 @@ void action_evaluation(proj C, const uint8_t key[], const proj A) {
             size_of_each_complement_batch[m] = 0;
             size_of_each_batch[m] = 0;
             number_of_batches = 1;
+            initial_batches = 0;
             
             for (i = 0; i < N; i++) {
+#if CSURF
+                if (L[i] == 2) continue;    // 2 由每轮开头的倍点乘掉
+#endif
                 if (counter[i] == 0) {
                     complement_of_each_batch[m][size_of_each_complement_batch[m]] = i;
                     size_of_each_complement_batch[m] += 1;
                 } else {
-                    last_isogeny[0] = i;
                     batches[m][size_of_each_batch[m]] = i;
                     size_of_each_batch[m] += 1;
                 }
             }
         }
         
-        // 寻找合适的点
-        elligator(current_T[1], current_T[0], current_A);
-        
-        // 乘以4和补集中的l_i
-        yDBL(current_T[0], current_T[0], current_A);
-        yDBL(current_T[0], current_T[0], current_A);
-        yDBL(current_T[1], current_T[1], current_A);
-        yDBL(current_T[1], current_T[1], current_A);
+        if (from_E && isog_counter == 0 && initial_batches) {
+            // 曲线仍是E、补集未变：预计算的点已经乘过4、余因子k和补集
+            precomputed_torsion(current_T[1], current_T[0], m);
+        } else {
+            // 寻找合适的点
+            elligator(current_T[1], current_T[0], current_A);
+            
+            // 乘以4（CSURF 时乘以8）、余因子k和补集中的l_i
+            yDBL2(current_T[0], current_T[1], current_T[0], current_T[1], current_A);
+            yDBL2(current_T[0], current_T[1], current_T[0], current_T[1], current_A);
+#if CSURF
+            yDBL2(current_T[0], current_T[1], current_T[0], current_T[1], current_A);
+#endif
+#if COFACTOR_BITS > 1
+            yMUL_cofactor(current_T[0], current_T[0], current_A);
+            yMUL_cofactor(current_T[1], current_T[1], current_A);
+#endif
+            
+            // 初始补集按分组乘积的加法链一起乘，之后追加进补集的l_i逐个乘
+            i = 0;
+            if (initial_batches) {
+                for (j = 0; j < NUMBER_OF_COFACTOR_CHAINS[m]; j++) {
+                    yMUL2_chain(current_T[0], current_T[1], current_T[0], current_T[1], current_A,
+                                COFACTOR_CHAIN[m][j], COFACTOR_CHAIN_LENGTH[m][j]);
+                }
+                i = SIZE_OF_EACH_COMPLEMENT_BATCH[m];
+            }
+            for (; i < size_of_each_complement_batch[m]; i++) {
+                yMUL2(current_T[0], current_T[1], current_T[0], current_T[1], current_A, complement_of_each_batch[m][i]);
+            }
+        }
         
-        for (i = 0; i < size_of_each_complement_batch[m]; i++) {
-            yMUL(current_T[0], current_T[0], current_A, complement_of_each_batch[m][i]);
-            yMUL(current_T[1], current_T[1], current_A, complement_of_each_batch[m][i]);
+        // 本轮要做的l_i（未做完的），按l_i从小到大
+        uint8_t n = 0;
+        for (i = size_of_each_batch[m]; i-- > 0;) {
+            if (finished[batches[m][i]] == 0) {
+                primes[n++] = batches[m][i];
+            }
+        }
+        if (initial_batches && n == SIZE_OF_EACH_BATCH[m]) {
+            memcpy(strategy, STRATEGY_OF_EACH_BATCH[m], N);
+        } else {
+            optimal_strategy(strategy, primes, n);
         }
         
-        for (i = 0; i < size_of_each_batch[m]; i++) {
-            if (finished[batches[m][i]] == 1) {
-                continue;
-            } else {
-                point_copy(G[0], current_T[0]);
-                point_copy(G[1], current_T[1]);
-                
-                ec = lookup(batches[m][i], tmp_e);
-                fp_cswap(&G[0][0], &G[1][0], (ec & 1));
-                fp_cswap(&G[0][1], &G[1][1], (ec & 1));
-                
-                fp_cswap(&current_T[0][0], &current_T[1][0], (ec & 1));
-                fp_cswap(&current_T[0][1], &current_T[1][1], (ec & 1));
-                
-                for (j = (i + 1); j < size_of_each_batch[m]; j++) {
-                    if (finished[batches[m][j]] == 0) {
-                        yMUL(G[0], G[0], current_A, batches[m][j]);
+        // stack[0] 是 (T-, T+) 本身，其余是乘过 [mid, hi) 中l_u的点对
+        point_copy(stack[0][0], current_T[0]);
+        point_copy(stack[0][1], current_T[1]);
+        stack_lo[0] = 0;
+        stack_hi[0] = n;
+        int top = 0;
+        uint8_t k = 0;
+        
+        for (uint8_t t = 0; t < n; t++) {
+            uint8_t li = primes[t];
+            ec = lookup(li, tmp_e);
+            
+            // 沿策略向下直到叶子 t
+            while (stack_hi[top] - stack_lo[top] > 1) {
+                uint8_t lo = stack_lo[top], hi = stack_hi[top], mid = lo + strategy[k++];
+                point_copy(stack[top + 1][0], stack[top][0]);
+                point_copy(stack[top + 1][1], stack[top][1]);
+                if (mid - lo == 1) {
+                    // 叶子：只乘选中的点
+                    point_cswap(stack[top + 1][0], stack[top + 1][1], (ec & 1));
+                    for (j = mid; j < hi; j++) {
+                        yMUL(stack[top + 1][0], stack[top + 1][0], current_A, primes[j]);
                     }
-                }
-                
-                if ((isinfinity(G[0]) != 1) && (isinfinity(G[1]) != 1)) {
-                    bc = isequal(ec >> 1, 0) & 1;
-                    
-                    yISOG(K, current_A, G[0], current_A, batches[m][i]);
-                    
-                    if (isequal(batches[m][i], last_isogeny[m]) == 0) {
-                        yEVAL(current_T[0], current_T[0], K, batches[m][i]);
-                        yEVAL(current_T[1], current_T[1], K, batches[m][i]);
-                        yMUL(current_T[1], current_T[1], current_A, batches[m][i]);
+                    point_cswap(stack[top + 1][0], stack[top + 1][1], (ec & 1));
+                } else {
+                    for (j = mid; j < hi; j++) {
+                        yMUL2(stack[top + 1][0], stack[top + 1][1], stack[top + 1][0], stack[top + 1][1], current_A, primes[j]);
                     }
-                    
-                    tmp_e[batches[m][i]] = ((((ec >> 1) - (bc ^ 1)) ^ bc) << 1) ^ ((ec & 0x1) ^ bc);
-                    counter[batches[m][i]] -= 1;
-                    isog_counter += 1;
+                }
+                top++;
+                stack_lo[top] = lo;
+                stack_hi[top] = mid;
+            }
+            
+            // G[0] 是叶子上选中的核点，G[1] 是 stack[0] 中另一侧的点
+            point_copy(G[0], stack[top][0]);
+            point_copy(T, stack[top][1]);
+            point_cswap(G[0], T, (ec & 1));
+            point_copy(T, stack[0][0]);
+            point_copy(G[1], stack[0][1]);
+            point_cswap(T, G[1], (ec & 1));
+            
+            uint8_t isogeny = (isinfinity(G[0]) != 1) && (isinfinity(G[1]) != 1);
+            if (isogeny) {
+                bc = isequal(ec >> 1, 0) & 1;
+                if (VELU_SQRT[li]) {
+                    yISOG_sqrt(&Kq, current_A, G[0], current_A, li);
+                } else if (VELU_PAIR[li]) {
+                    yISOG_pair(&Ks, current_A, G[0], current_A, li);
                 } else {
-                    yMUL(current_T[1], current_T[1], current_A, batches[m][i]);
+                    yISOG(K, current_A, G[0], current_A, li);
                 }
-                
-                fp_cswap(&current_T[0][0], &current_T[1][0], (ec & 1));
-                fp_cswap(&current_T[0][1], &current_T[1][1], (ec & 1));
-                
-                if (counter[batches[m][i]] == 0) {
-                    finished[batches[m][i]] = 1;
-                    complement_of_each_batch[m][size_of_each_complement_batch[m]] = batches[m][i];
-                    size_of_each_complement_batch[m] += 1;
+            }
+            
+            // 栈中其余的点对：求值，另一侧的点乘以l_t
+            for (int d = 0; d < top; d++) {
+                if (isogeny) {
+                    if (VELU_SQRT[li]) {
+                        yEVAL2_sqrt(stack[d][0], stack[d][1], stack[d][0], stack[d][1], &Kq);
+                    } else if (VELU_PAIR[li]) {
+                        yEVAL2_pair(stack[d][0], stack[d][1], stack[d][0], stack[d][1], &Ks);
+                    } else {
+                        yEVAL2(stack[d][0], stack[d][1], stack[d][0], stack[d][1], K, li);
+                    }
                 }
+                point_cswap(stack[d][0], stack[d][1], (ec & 1));
+                yMUL(stack[d][1], stack[d][1], current_A, li);
+                point_cswap(stack[d][0], stack[d][1], (ec & 1));
+            }
+            
+            if (isogeny) {
+                tmp_e[li] = ((((ec >> 1) - (bc ^ 1)) ^ bc) << 1) ^ ((ec & 0x1) ^ bc);
+                counter[li] -= 1;
+                isog_counter += 1;
+            }
+            
+            if (counter[li] == 0) {
+                finished[li] = 1;
+                complement_of_each_batch[m][size_of_each_complement_batch[m]] = li;
+                size_of_each_complement_batch[m] += 1;
+            }
+            
+            top--;
+            if (top >= 0) {
+                stack_lo[top] = t + 1;
             }
         }
         count += 1;
     }
     
-    // 将结果曲线复制到输出
-    point_copy(C, current_A);
+    // 根式同源，结果写到输出
+    action_radical(C, key, current_A);
 }
 
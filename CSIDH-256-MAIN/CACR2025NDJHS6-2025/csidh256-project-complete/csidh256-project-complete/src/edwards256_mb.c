@@ -0,0 +1,123 @@
+// 多缓冲群作用：常量初始化、CPU检测与分发（实现见 fp256_mb_impl.h / edwards256_mb_impl.h）
+#include "edwards256_mb.h"
+#include "csidh256_params.h"
+#include <string.h>
+
+#if defined(__x86_64__) && defined(__GNUC__) && !defined(__clang__)
+#define EDWARDS256_MB_IFMA 1
+#include <immintrin.h>
+#endif
+
+// ==================== 2^52 进制常量（构建时生成，见 fp256_constants.h）====================
+// 标量表示为 a * 2^s（Montgomery后端 s = 256，传统后端 s = 0），多缓冲表示为 a * 2^260：
+// 转入乘 2^(520 - s)，转出乘 2^s，每次乘法再除以 2^260
+static const uint64_t mb_p52[5] = FP256_CONST_MB_P52;        // p
+static const uint64_t mb_2p52[5] = FP256_CONST_MB_2P52;      // 2p
+static const uint64_t mb_pinv52 = FP256_CONST_MB_PINV52;     // -p^(-1) mod 2^52
+static const uint64_t mb_one52[5] = FP256_CONST_MB_POW2_260; // 2^260 mod p（多缓冲Montgomery域中的1）
+#ifdef FP256_TRADITIONAL
+static const uint64_t mb_to_c52[5] = FP256_CONST_MB_POW2_520;   // 标量表示 -> 多缓冲表示的乘数
+static const uint64_t mb_from_c52[5] = FP256_CONST_MB_POW2_0;   // 多缓冲表示 -> 标量表示的乘数
+#else
+static const uint64_t mb_to_c52[5] = FP256_CONST_MB_POW2_264;
+static const uint64_t mb_from_c52[5] = FP256_CONST_MB_POW2_256;
+#endif
+
+// 4个64位字 -> 5个52位字
+static inline void mb_split52(uint64_t w[5], const bigint256 *x) {
+    const uint64_t m = (1ULL << 52) - 1;
+    w[0] = x->limbs[0] & m;
+    w[1] = ((x->limbs[0] >> 52) | (x->limbs[1] << 12)) & m;
+    w[2] = ((x->limbs[1] >> 40) | (x->limbs[2] << 24)) & m;
+    w[3] = ((x->limbs[2] >> 28) | (x->limbs[3] << 36)) & m;
+    w[4] = x->limbs[3] >> 16;
+}
+
+static inline void mb_join52(bigint256 *x, const uint64_t w[5]) {
+    x->limbs[0] = w[0] | (w[1] << 52);
+    x->limbs[1] = (w[1] >> 12) | (w[2] << 40);
+    x->limbs[2] = (w[2] >> 24) | (w[3] << 28);
+    x->limbs[3] = (w[3] >> 36) | (w[4] << 16);
+}
+
+// ==================== SIMD实现（4 / 8 通道）====================
+#ifdef EDWARDS256_MB_IFMA
+#pragma GCC push_options
+#pragma GCC target("avx2,avx512f,avx512vl,avx512ifma")
+
+#define MB_CAT_(a, b) a##_x##b
+#define MB_CAT(a, b) MB_CAT_(a, b)
+#define MB_NAME(x) MB_CAT(x, MB_LANES)
+
+#define MB_LANES 4
+#include "fp256_mb_impl.h"
+#include "edwards256_mb_impl.h"
+#undef MB_LANES
+
+#define MB_LANES 8
+#include "fp256_mb_impl.h"
+#include "edwards256_mb_impl.h"
+#undef MB_LANES
+
+#pragma GCC pop_options
+
+static int mb_has_x4(void) {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx512ifma") && __builtin_cpu_supports("avx512vl");
+}
+
+static int mb_has_x8(void) {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx512ifma") && __builtin_cpu_supports("avx512f");
+}
+#else
+static int mb_has_x4(void) { return 0; }
+static int mb_has_x8(void) { return 0; }
+#endif
+
+// 运行时切换到传统模乘时标量表示不同，走标量回退
+static int mb_enabled(void) {
+#ifdef FP256_RUNTIME_DISPATCH
+    return get_mul_method() == 1;
+#else
+    return 1;
+#endif
+}
+
+int action_evaluation_mb_lanes(void) {
+    if (!mb_enabled()) return 1;
+    if (mb_has_x8()) return 8;
+    if (mb_has_x4()) return 4;
+    return 1;
+}
+
+const char *action_evaluation_mb_name(void) {
+    switch (action_evaluation_mb_lanes()) {
+    case 8: return "AVX-512 IFMA x8";
+    case 4: return "AVX-512 IFMA (VL) x4";
+    default: return "scalar fallback";
+    }
+}
+
+void action_evaluation_x4(proj C[4], const uint8_t *const keys[4], const proj A[4]) {
+#ifdef EDWARDS256_MB_IFMA
+    if (mb_enabled() && mb_has_x4()) {
+        action_evaluation_mb_x4(C, keys, A);
+        return;
+    }
+#endif
+    for (int j = 0; j < 4; j++) {
+        action_evaluation(C[j], keys[j], A[j]);
+    }
+}
+
+void action_evaluation_x8(proj C[8], const uint8_t *const keys[8], const proj A[8]) {
+#ifdef EDWARDS256_MB_IFMA
+    if (mb_enabled() && mb_has_x8()) {
+        action_evaluation_mb_x8(C, keys, A);
+        return;
+    }
+#endif
+    action_evaluation_x4(C, keys, A);
+    action_evaluation_x4(C + 4, keys + 4, A + 4);
+}
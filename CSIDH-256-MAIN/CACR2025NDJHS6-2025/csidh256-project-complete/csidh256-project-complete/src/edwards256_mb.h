@@ -0,0 +1,30 @@
+#ifndef EDWARDS256_MB_H
+#define EDWARDS256_MB_H
+
+#include "edwards256.h"
+
+// ==================== 多缓冲群作用（4/8个私钥同步执行）====================
+// SIMBA 对每个私钥执行的域运算序列几乎相同，多缓冲实现把 4 或 8 个独立的
+// action_evaluation 放在SIMD通道中同步执行（src/fp256_mb_impl.h：2^52进制、
+// AVX-512 IFMA），单核吞吐量成倍提高。
+//
+// 运行时检测CPU：
+//   action_evaluation_x8  需要 AVX-512F + AVX-512 IFMA（512位，8通道）
+//   action_evaluation_x4  需要 AVX-512VL + AVX-512 IFMA（256位，4通道）
+// 不支持时回退到逐个调用标量 action_evaluation，结果相同。
+// AVX2 没有 52x52 位整数乘法，用 32 位乘法拼出来的多缓冲乘法比标量 mulx 路径更慢，
+// 所以只有 AVX2 的CPU也走标量回退。
+//
+// 多缓冲路径不更新 FP_*_COMPUTED 计数器。
+
+#define EDWARDS256_MB_MAX_LANES 8
+
+// 当前CPU上 action_evaluation_x8 实际使用的通道数：8、4 或 1（标量回退）
+int action_evaluation_mb_lanes(void);
+const char *action_evaluation_mb_name(void);
+
+// C[j] = action(keys[j], A[j])，j = 0..3 / 0..7；输入曲线需已通过 validate
+void action_evaluation_x4(proj C[4], const uint8_t *const keys[4], const proj A[4]);
+void action_evaluation_x8(proj C[8], const uint8_t *const keys[8], const proj A[8]);
+
+#endif // EDWARDS256_MB_H
@@ -0,0 +1,551 @@
+// 多缓冲Edwards曲线运算与SIMBA群作用模板（由 src/edwards256_mb.c 以 MB_LANES = 4 / 8 各包含一次）
+//
+// 曲线公式与 src/edwards256.c 逐行对应，只是每个域元素换成 MB_LANES 个通道。
+// 各通道的私钥不同，SIMBA 中依赖私钥/随机点的分支改成按通道掩码选择：
+//   - 某个 l_i 只要还有一个通道没有做完，所有通道都按"没做完"的控制流走；
+//     已经做完的通道在该步不做同源，只把 [l_i] 乘进两个扭点（相当于标量版本中
+//     把 l_i 放进补集），所以核点的阶与标量实现相同
+//   - 同源只在满足条件的通道上生效（mbfp_select），其余通道保持原曲线
+// 包含前需要先包含 fp256_mb_impl.h。
+
+typedef mbfp MB_NAME(mbproj)[2];
+#define mbproj MB_NAME(mbproj)
+
+static inline void MB_NAME(mb_point_copy)(mbproj Q, const mbproj P) {
+    Q[0] = P[0];
+    Q[1] = P[1];
+}
+#define mb_point_copy MB_NAME(mb_point_copy)
+
+static inline void MB_NAME(mb_point_select)(mbproj Q, const mbproj P, const mbproj R, u64v mask) {
+    mbfp_select(&Q[0], &P[0], &R[0], mask);
+    mbfp_select(&Q[1], &P[1], &R[1], mask);
+}
+#define mb_point_select MB_NAME(mb_point_select)
+
+static inline void MB_NAME(mb_point_cswap)(mbproj P, mbproj Q, u64v mask) {
+    mbfp_cswap(&P[0], &Q[0], mask);
+    mbfp_cswap(&P[1], &Q[1], mask);
+}
+#define mb_point_cswap MB_NAME(mb_point_cswap)
+
+static inline u64v MB_NAME(mb_isinfinity)(const mbproj P) {
+    mbfp tmp;
+    mbfp_sub(&tmp, &P[0], &P[1]);
+    return mbfp_iszero(&tmp);
+}
+#define mb_isinfinity MB_NAME(mb_isinfinity)
+
+static void MB_NAME(mb_yDBL)(mbproj Q, const mbproj P, const mbproj A) {
+    mbfp tmp_0, tmp_1;
+
+    mbfp_sqr(&tmp_0, &P[0]);
+    mbfp_sqr(&tmp_1, &P[1]);
+
+    mbfp_mul(&Q[1], &A[1], &tmp_0);
+    mbfp_mul(&Q[0], &Q[1], &tmp_1);
+    mbfp_sub(&tmp_1, &tmp_1, &tmp_0);
+    mbfp_mul(&tmp_0, &A[0], &tmp_1);
+    mbfp_add(&Q[1], &Q[1], &tmp_0);
+    mbfp_mul(&tmp_0, &Q[1], &tmp_1);
+
+    mbfp_add(&Q[1], &Q[0], &tmp_0);
+    mbfp_sub(&Q[0], &Q[0], &tmp_0);
+}
+#define mb_yDBL MB_NAME(mb_yDBL)
+
+static void MB_NAME(mb_yADD)(mbproj R, const mbproj P, const mbproj Q, const mbproj PQ) {
+    mbfp tmp_0, tmp_1, xD, zD;
+
+    mbfp_add(&xD, &PQ[1], &PQ[0]);
+    mbfp_sub(&zD, &PQ[1], &PQ[0]);
+
+    mbfp_mul(&tmp_0, &P[1], &Q[0]);
+    mbfp_mul(&tmp_1, &P[0], &Q[1]);
+
+    mbfp_sub(&R[1], &tmp_0, &tmp_1);
+    mbfp_add(&R[0], &tmp_0, &tmp_1);
+
+    mbfp_sqr(&R[1], &R[1]);
+    mbfp_sqr(&R[0], &R[0]);
+
+    mbfp_mul(&tmp_0, &R[0], &zD);
+    mbfp_mul(&tmp_1, &R[1], &xD);
+
+    mbfp_sub(&R[0], &tmp_0, &tmp_1);
+    mbfp_add(&R[1], &tmp_0, &tmp_1);
+}
+#define mb_yADD MB_NAME(mb_yADD)
+
+// [l_i]P：加法链与 yMUL 相同；差值点为无穷远的通道改用倍点
+static void MB_NAME(mb_yMUL_chain)(mbproj Q, const mbproj P, const mbproj A, uint32_t chain, uint8_t length) {
+    mbproj R[3], T, D;
+
+    mb_point_copy(R[0], P);
+    mb_yDBL(R[1], P, A);
+    mb_yADD(R[2], R[1], R[0], P);
+
+    uint32_t tmp = chain;
+    for (uint8_t j = 0; j < length; j++) {
+        u64v inf = mb_isinfinity(R[tmp & 0x1]);
+        mb_yADD(T, R[2], R[(tmp & 0x1) ^ 0x1], R[tmp & 0x1]);
+        if (mb_any(inf)) {
+            mb_yDBL(D, R[2], A);
+            mb_point_select(T, D, T, inf);
+        }
+        mb_point_copy(R[0], R[(tmp & 0x1) ^ 0x1]);
+        mb_point_copy(R[1], R[2]);
+        mb_point_copy(R[2], T);
+
+        tmp >>= 1;
+    }
+    mb_point_copy(Q, R[2]);
+}
+#define mb_yMUL_chain MB_NAME(mb_yMUL_chain)
+
+// [k]P，k 是余因子 COFACTOR：与 yMUL_cofactor 相同的 Montgomery 梯子；P 是无穷远点的通道保持不变
+static void MB_NAME(mb_yMUL_cofactor)(mbproj Q, const mbproj P, const mbproj A) {
+    mbproj D, R0, R1, T;
+
+    mb_point_copy(D, P);
+    u64v inf = mb_isinfinity(D);
+    mb_point_copy(R0, D);
+    mb_yDBL(R1, D, A);
+    for (int b = COFACTOR_BITS - 2; b >= 0; b--) {
+        mb_yADD(T, R1, R0, D);
+        if ((COFACTOR[b >> 6] >> (b & 63)) & 1) {
+            mb_point_copy(R0, T);
+            mb_yDBL(R1, R1, A);
+        } else {
+            mb_point_copy(R1, T);
+            mb_yDBL(R0, R0, A);
+        }
+    }
+    mb_point_select(Q, D, R0, inf);
+}
+#define mb_yMUL_cofactor MB_NAME(mb_yMUL_cofactor)
+
+static void MB_NAME(mb_yMUL)(mbproj Q, const mbproj P, const mbproj A, uint8_t const i) {
+    mb_yMUL_chain(Q, P, A, (uint32_t)ADDITION_CHAIN[i], ADDITION_CHAIN_LENGTH[i]);
+}
+#define mb_yMUL MB_NAME(mb_yMUL)
+
+// Elligator：每个通道独立选取随机 u
+static void MB_NAME(mb_elligator)(mbproj T_plus, mbproj T_minus, const mbproj A) {
+    mbfp u, one;
+    mbfp_zero(&T_plus[0]);
+    mbfp_zero(&T_minus[0]);
+    mbfp_set(&one, mb_one52);
+
+    // 与标量实现相同：u 取自 {0, ..., (p-1)/2}，直接当作Montgomery表示使用
+    for (int j = 0; j < MB_LANES; j++) {
+        fp uj;
+        fp_random(&uj);
+        while (fp_compare(&uj, &p_minus_1_halves) > 0) {
+            fp_random(&uj);
+        }
+        mbfp_set_lane(&u, j, &uj);
+    }
+
+    mbfp tmp, u2_plus_1, Cu2_minus_1, tmp_0, tmp_1, alpha, beta;
+    mbfp_zero(&alpha);
+    beta = u;
+
+    mbfp_sqr(&T_plus[1], &u);
+    mbfp_add(&u2_plus_1, &T_plus[1], &one);
+    mbfp_sub(&tmp, &T_plus[1], &one);
+    mbfp_mul(&Cu2_minus_1, &A[1], &tmp);
+
+    mbfp_sub(&T_minus[1], &A[0], &A[1]);
+    mbfp_add(&T_minus[1], &T_minus[1], &A[0]);
+    mbfp_add(&T_minus[1], &T_minus[1], &T_minus[1]);
+
+    mbfp_mul(&tmp_0, &T_minus[1], &Cu2_minus_1);
+    mbfp_sqr(&tmp_1, &T_minus[1]);
+    mbfp_mul(&tmp_1, &tmp_1, &T_plus[1]);
+    mbfp_sqr(&tmp, &Cu2_minus_1);
+    mbfp_add(&tmp_1, &tmp_1, &tmp);
+    mbfp_mul(&tmp, &tmp_0, &tmp_1);
+
+    // tmp = 0（A = 0）的通道 alpha = u，其余通道 alpha = 0
+    mbfp_cswap(&alpha, &beta, mbfp_iszero(&tmp));
+    mbfp_mul(&u2_plus_1, &alpha, &u2_plus_1);
+    mbfp_mul(&alpha, &alpha, &Cu2_minus_1);
+
+    mbfp_add(&T_plus[0], &T_plus[0], &T_minus[1]);
+    mbfp_sub(&T_minus[0], &T_minus[0], &T_minus[1]);
+    mbfp_mul(&T_minus[0], &T_minus[0], &T_plus[1]);
+
+    mbfp_add(&T_plus[0], &T_plus[0], &alpha);
+    mbfp_sub(&T_minus[0], &T_minus[0], &alpha);
+
+    mbfp_add(&tmp, &tmp, &u2_plus_1);
+    mbfp_cswap(&T_plus[0], &T_minus[0], ~mbfp_issquare(&tmp));
+
+    mbfp_add(&T_plus[1], &T_plus[0], &Cu2_minus_1);
+    mbfp_sub(&T_plus[0], &T_plus[0], &Cu2_minus_1);
+    mbfp_add(&T_minus[1], &T_minus[0], &Cu2_minus_1);
+    mbfp_sub(&T_minus[0], &T_minus[0], &Cu2_minus_1);
+}
+#define mb_elligator MB_NAME(mb_elligator)
+
+static void MB_NAME(mb_yISOG)(mbproj Pk[], mbproj C, const mbproj P, const mbproj A, const uint8_t i) {
+    int64_t bits_l;
+    uint64_t j;
+    uint32_t l = L[i];
+    uint64_t s = l >> 1;
+
+    bits_l = 0;
+    uint32_t l_temp = l;
+    while (l_temp > 0) {
+        l_temp >>= 1;
+        bits_l += 1;
+    }
+
+    mbfp By[2], Bz[2], tmp_0, tmp_1, tmp_d;
+
+    tmp_0 = A[0];
+    mbfp_sub(&tmp_d, &A[0], &A[1]);
+    tmp_1 = tmp_d;
+
+    By[0] = P[0];
+    By[1] = P[0];
+    Bz[0] = P[1];
+    Bz[1] = P[1];
+
+    mb_point_copy(Pk[0], P);
+    mb_yDBL(Pk[1], P, A);
+
+    for (j = 2; j < s; j++) {
+        mbfp_mul(&By[0], &By[0], &Pk[j - 1][0]);
+        mbfp_mul(&Bz[0], &Bz[0], &Pk[j - 1][1]);
+        mb_yADD(Pk[j], Pk[j - 1], P, Pk[j - 2]);
+    }
+
+    // l 是公开的，l = 3 时跳过最后一项（对应标量实现中的 cswap）
+    mbfp_mul(&By[1], &By[0], &Pk[s - 1][0]);
+    mbfp_mul(&Bz[1], &Bz[0], &Pk[s - 1][1]);
+    if (l != 3) {
+        By[0] = By[1];
+        Bz[0] = Bz[1];
+    }
+
+    bits_l -= 1;
+    for (j = 1; j <= (uint64_t)bits_l; j++) {
+        mbfp_sqr(&tmp_0, &tmp_0);
+        mbfp_sqr(&tmp_1, &tmp_1);
+        if (((l >> (bits_l - j)) & 1) != 0) {
+            mbfp_mul(&tmp_0, &tmp_0, &A[0]);
+            mbfp_mul(&tmp_1, &tmp_1, &tmp_d);
+        }
+    }
+
+    for (j = 0; j < 3; j++) {
+        mbfp_sqr(&By[0], &By[0]);
+        mbfp_sqr(&Bz[0], &Bz[0]);
+    }
+
+    mbfp_mul(&C[0], &tmp_0, &Bz[0]);
+    mbfp_mul(&C[1], &tmp_1, &By[0]);
+    mbfp_sub(&C[1], &C[0], &C[1]);
+}
+#define mb_yISOG MB_NAME(mb_yISOG)
+
+static void MB_NAME(mb_yEVAL)(mbproj R, const mbproj Q, const mbproj Pk[], const uint8_t i) {
+    mbfp tmp_0, tmp_1, s_0, s_1;
+
+    mbproj tmp_Q;
+    mb_point_copy(tmp_Q, Q);
+
+    mbfp_mul(&s_0, &tmp_Q[0], &Pk[0][1]);
+    mbfp_mul(&s_1, &tmp_Q[1], &Pk[0][0]);
+    mbfp_add(&R[0], &s_0, &s_1);
+    mbfp_sub(&R[1], &s_0, &s_1);
+
+    uint64_t s = (L[i] >> 1);
+    for (uint64_t j = 1; j < s; j++) {
+        mbfp_mul(&s_0, &tmp_Q[0], &Pk[j][1]);
+        mbfp_mul(&s_1, &tmp_Q[1], &Pk[j][0]);
+        mbfp_add(&tmp_0, &s_0, &s_1);
+        mbfp_sub(&tmp_1, &s_0, &s_1);
+        mbfp_mul(&R[0], &R[0], &tmp_0);
+        mbfp_mul(&R[1], &R[1], &tmp_1);
+    }
+
+    mbfp_sqr(&R[0], &R[0]);
+    mbfp_sqr(&R[1], &R[1]);
+    mbfp_add(&tmp_0, &tmp_Q[1], &tmp_Q[0]);
+    mbfp_sub(&tmp_1, &tmp_Q[1], &tmp_Q[0]);
+    mbfp_mul(&tmp_0, &R[0], &tmp_0);
+    mbfp_mul(&tmp_1, &R[1], &tmp_1);
+    mbfp_sub(&R[0], &tmp_0, &tmp_1);
+    mbfp_add(&R[1], &tmp_0, &tmp_1);
+}
+#define mb_yEVAL MB_NAME(mb_yEVAL)
+
+// 按通道取 key[l] 的第 bit 位，组成掩码
+static inline u64v MB_NAME(mb_lane_mask)(const uint8_t flags[MB_LANES]) {
+    u64v mask = {0};
+    for (int j = 0; j < MB_LANES; j++) {
+        mask[j] = -(uint64_t)(flags[j] & 1);
+    }
+    return mask;
+}
+#define mb_lane_mask MB_NAME(mb_lane_mask)
+
+// MB_LANES 个群作用同步执行（SIMBA，控制流取所有通道的并集）
+static void MB_NAME(action_evaluation_mb)(proj C[], const uint8_t *const keys[], const proj A[]) {
+    uint8_t batches[NUMBER_OF_BATCHES][SIZE_OF_EACH_BATCH[0]];
+    uint8_t size_of_each_batch[NUMBER_OF_BATCHES];
+
+    for (uint8_t i = 0; i < NUMBER_OF_BATCHES; i++) {
+        memcpy(batches[i], BATCHES[i], sizeof(uint8_t) * SIZE_OF_EACH_BATCH[i]);
+    }
+    memcpy(size_of_each_batch, SIZE_OF_EACH_BATCH, sizeof(uint8_t) * NUMBER_OF_BATCHES);
+
+    uint8_t complement_of_each_batch[NUMBER_OF_BATCHES][N];
+    uint8_t size_of_each_complement_batch[NUMBER_OF_BATCHES];
+    memcpy(complement_of_each_batch, COMPLEMENT_OF_EACH_BATCH, sizeof(uint8_t) * NUMBER_OF_BATCHES * N);
+    memcpy(size_of_each_complement_batch, SIZE_OF_EACH_COMPLEMENT_BATCH, sizeof(uint8_t) * NUMBER_OF_BATCHES);
+
+    // 每个通道的私钥与剩余次数
+    uint8_t tmp_e[MB_LANES][N];
+    int8_t counter[MB_LANES][N];
+    uint64_t isog_counter[MB_LANES];
+    for (int lane = 0; lane < MB_LANES; lane++) {
+        memcpy(tmp_e[lane], keys[lane], sizeof(uint8_t) * N);
+        // 根式同源的 l_i 不进批次，最后逐个通道用 action_radical 处理
+        for (int r = 0; r < N; r++) {
+            counter[lane][r] = RADICAL[r] ? 0 : B[r];
+        }
+        isog_counter[lane] = 0;
+    }
+
+    mbproj current_A, current_T[2], G[2], K[(LARGE_L >> 1) + 1], A_new, T_new;
+    for (int lane = 0; lane < MB_LANES; lane++) {
+        mbfp_set_lane(&current_A[0], lane, &A[lane][0]);
+        mbfp_set_lane(&current_A[1], lane, &A[lane][1]);
+    }
+    mbfp_to_mb(&current_A[0]);
+    mbfp_to_mb(&current_A[1]);
+
+    // 所有通道都从公共曲线E出发时，第一次同源之前的轮次直接用预计算扭点
+    int from_E = 1;
+    for (int lane = 0; lane < MB_LANES; lane++) {
+        from_E &= has_precomputed_torsion(A[lane]);
+    }
+
+    // 所有通道都已做完的 l_i
+    uint8_t finished[N];
+    memset(finished, 0, sizeof(uint8_t) * N);
+
+    uint8_t last_isogeny[NUMBER_OF_BATCHES];
+    memcpy(last_isogeny, LAST_ISOGENY, sizeof(uint8_t) * NUMBER_OF_BATCHES);
+
+    uint16_t count = 0;
+    uint8_t m = 0, i, j;
+    uint64_t number_of_batches = NUMBER_OF_BATCHES;
+    uint8_t initial_batches = 1;
+
+    for (;;) {
+        int pending = 0;
+        for (int lane = 0; lane < MB_LANES; lane++) {
+            pending |= (isog_counter[lane] < NUMBER_OF_ISOGENIES);
+        }
+        if (!pending) break;
+
+        m = (m + 1) % number_of_batches;
+
+        if (count == MY * number_of_batches) {
+            m = 0;
+            size_of_each_complement_batch[m] = 0;
+            size_of_each_batch[m] = 0;
+            number_of_batches = 1;
+            initial_batches = 0;
+
+            for (i = 0; i < N; i++) {
+#if CSURF
+                if (L[i] == 2) continue;    // 2 由每轮开头的倍点乘掉
+#endif
+                int remaining = 0;
+                for (int lane = 0; lane < MB_LANES; lane++) {
+                    remaining |= (counter[lane][i] != 0);
+                }
+                if (!remaining) {
+                    complement_of_each_batch[m][size_of_each_complement_batch[m]] = i;
+                    size_of_each_complement_batch[m] += 1;
+                } else {
+                    last_isogeny[0] = i;
+                    batches[m][size_of_each_batch[m]] = i;
+                    size_of_each_batch[m] += 1;
+                }
+            }
+        }
+
+        int untouched = from_E && initial_batches;
+        for (int lane = 0; lane < MB_LANES; lane++) {
+            untouched &= (isog_counter[lane] == 0);
+        }
+
+        if (untouched) {
+            // 所有通道的曲线仍是E、补集未变：每个通道放入同一对预计算点
+            proj T_plus, T_minus;
+            precomputed_torsion(T_plus, T_minus, m);
+            for (int lane = 0; lane < MB_LANES; lane++) {
+                mbfp_set_lane(&current_T[0][0], lane, &T_minus[0]);
+                mbfp_set_lane(&current_T[0][1], lane, &T_minus[1]);
+                mbfp_set_lane(&current_T[1][0], lane, &T_plus[0]);
+                mbfp_set_lane(&current_T[1][1], lane, &T_plus[1]);
+            }
+            mbfp_to_mb(&current_T[0][0]);
+            mbfp_to_mb(&current_T[0][1]);
+            mbfp_to_mb(&current_T[1][0]);
+            mbfp_to_mb(&current_T[1][1]);
+        } else {
+            mb_elligator(current_T[1], current_T[0], current_A);
+
+            mb_yDBL(current_T[0], current_T[0], current_A);
+            mb_yDBL(current_T[0], current_T[0], current_A);
+            mb_yDBL(current_T[1], current_T[1], current_A);
+            mb_yDBL(current_T[1], current_T[1], current_A);
+#if CSURF
+            mb_yDBL(current_T[0], current_T[0], current_A);
+            mb_yDBL(current_T[1], current_T[1], current_A);
+#endif
+#if COFACTOR_BITS > 1
+            mb_yMUL_cofactor(current_T[0], current_T[0], current_A);
+            mb_yMUL_cofactor(current_T[1], current_T[1], current_A);
+#endif
+
+            i = 0;
+            if (initial_batches) {
+                for (j = 0; j < NUMBER_OF_COFACTOR_CHAINS[m]; j++) {
+                    mb_yMUL_chain(current_T[0], current_T[0], current_A, COFACTOR_CHAIN[m][j], COFACTOR_CHAIN_LENGTH[m][j]);
+                    mb_yMUL_chain(current_T[1], current_T[1], current_A, COFACTOR_CHAIN[m][j], COFACTOR_CHAIN_LENGTH[m][j]);
+                }
+                i = SIZE_OF_EACH_COMPLEMENT_BATCH[m];
+            }
+            for (; i < size_of_each_complement_batch[m]; i++) {
+                mb_yMUL(current_T[0], current_T[0], current_A, complement_of_each_batch[m][i]);
+                mb_yMUL(current_T[1], current_T[1], current_A, complement_of_each_batch[m][i]);
+            }
+        }
+
+        for (i = 0; i < size_of_each_batch[m]; i++) {
+            uint8_t li = batches[m][i];
+            if (finished[li] == 1) {
+                continue;
+            }
+
+            uint8_t ec[MB_LANES], active[MB_LANES];
+            for (int lane = 0; lane < MB_LANES; lane++) {
+                ec[lane] = tmp_e[lane][li];
+                active[lane] = (counter[lane][li] != 0);
+            }
+            u64v sign = mb_lane_mask(ec);
+            u64v active_mask = mb_lane_mask(active);
+
+            mb_point_copy(G[0], current_T[0]);
+            mb_point_copy(G[1], current_T[1]);
+            mb_point_cswap(G[0], G[1], sign);
+            mb_point_cswap(current_T[0], current_T[1], sign);
+
+            for (j = (i + 1); j < size_of_each_batch[m]; j++) {
+                if (finished[batches[m][j]] == 0) {
+                    mb_yMUL(G[0], G[0], current_A, batches[m][j]);
+                }
+            }
+
+            u64v isog_mask = active_mask & ~mb_isinfinity(G[0]) & ~mb_isinfinity(G[1]);
+            int not_last = (isequal(li, last_isogeny[m]) == 0);
+
+            if (mb_any(isog_mask)) {
+                mb_yISOG(K, A_new, G[0], current_A, li);
+                mb_point_select(current_A, A_new, current_A, isog_mask);
+
+                if (not_last) {
+                    mb_yEVAL(T_new, current_T[0], K, li);
+                    mb_point_select(current_T[0], T_new, current_T[0], isog_mask);
+                    mb_yEVAL(T_new, current_T[1], K, li);
+                    mb_point_select(current_T[1], T_new, current_T[1], isog_mask);
+                }
+            }
+
+            // 最后一个 l_i 之后扭点不再使用
+            if (not_last) {
+                mb_yMUL(current_T[1], current_T[1], current_A, li);
+                if (mb_any(~active_mask)) {
+                    mb_yMUL(T_new, current_T[0], current_A, li);
+                    mb_point_select(current_T[0], T_new, current_T[0], ~active_mask);
+                }
+            }
+
+            int remaining = 0;
+            for (int lane = 0; lane < MB_LANES; lane++) {
+                if (isog_mask[lane]) {
+                    uint8_t e = ec[lane];
+                    uint32_t bc = isequal(e >> 1, 0) & 1;
+                    tmp_e[lane][li] = ((((e >> 1) - (bc ^ 1)) ^ bc) << 1) ^ ((e & 0x1) ^ bc);
+                    counter[lane][li] -= 1;
+                    isog_counter[lane] += 1;
+                }
+                remaining |= (counter[lane][li] != 0);
+            }
+
+            mb_point_cswap(current_T[0], current_T[1], sign);
+
+            if (!remaining) {
+                finished[li] = 1;
+                complement_of_each_batch[m][size_of_each_complement_batch[m]] = li;
+                size_of_each_complement_batch[m] += 1;
+            }
+        }
+        count += 1;
+    }
+
+    fp out0[MB_LANES], out1[MB_LANES];
+    mbfp_from_mb(out0, &current_A[0]);
+    mbfp_from_mb(out1, &current_A[1]);
+    for (int lane = 0; lane < MB_LANES; lane++) {
+        fp_copy(&C[lane][0], &out0[lane]);
+        fp_copy(&C[lane][1], &out1[lane]);
+        action_radical(C[lane], keys[lane], C[lane]);
+    }
+}
+
+// 模板中定义的简写名，在下一次包含前取消
+#undef u64v
+#undef s64v
+#undef mbfp
+#undef mbproj
+#undef MB_MADD52LO
+#undef MB_MADD52HI
+#undef mb_bcast
+#undef mb_any
+#undef mbfp_set
+#undef mbfp_zero
+#undef mbfp_csub
+#undef mbfp_add
+#undef mbfp_sub
+#undef mbfp_mul
+#undef mbfp_sqr
+#undef mbfp_cswap
+#undef mbfp_select
+#undef mbfp_iszero
+#undef mbfp_set_lane
+#undef mbfp_to_mb
+#undef mbfp_from_mb
+#undef mbfp_issquare
+#undef mb_point_copy
+#undef mb_point_select
+#undef mb_point_cswap
+#undef mb_isinfinity
+#undef mb_yDBL
+#undef mb_yADD
+#undef mb_yMUL
+#undef mb_yMUL_chain
+#undef mb_yMUL_cofactor
+#undef mb_elligator
+#undef mb_yISOG
+#undef mb_yEVAL
+#undef mb_lane_mask
@@ -0,0 +1,36 @@
+// 自动生成：tools/gen_torsion_points.c（make torsion），请勿手工修改
+// 公共曲线E上的预计算扭点：每个 SIMBA 批次一对 T- / T+（射影 (X : Z)），
+// 已乘以 4、余因子 k 和该批次补集中的所有 l_i，群作用从E出发时代替第一轮的 Elligator
+#ifndef EDWARDS256_TORSION_H
+#define EDWARDS256_TORSION_H
+
+// 生成时的参数：与当前参数集不一致时表不会被使用
+#define EDWARDS256_TORSION_N 37
+#define EDWARDS256_TORSION_BATCHES 3
+static const uint64_t EDWARDS256_TORSION_P[4] = { 0x82653CC3EAE4C5EBULL, 0xDC29209CA3618AE5ULL, 0x615B08CD8DD0734BULL, 0x100000000ACA9E2AULL };
+
+static const proj EDWARDS256_TORSION[EDWARDS256_TORSION_BATCHES][2] = {
+    // 批次 0：完整阶的 (点, l_i) 组合 26/26
+    {
+        { {{ 0x62177D3767AD83DEULL, 0xA8C53F6C2A98606EULL, 0x5244F91D45AC5C10ULL, 0x0C5D5C90A4358B8FULL }},
+          {{ 0xB0ACC62FCDDB5E60ULL, 0x8B9584984BAAE576ULL, 0x928B9E1A011DCDB1ULL, 0x0B493E1572B339B8ULL }} },
+        { {{ 0xD1B876941D09678BULL, 0x50939C0457B6A56EULL, 0xCECF6AB38CB2A59AULL, 0x04B6C1EA98176471ULL }},
+          {{ 0x204DBF8C8337420DULL, 0x3363E13078C92A77ULL, 0x0F160FB04824173BULL, 0x03A2A36F6695129BULL }} }
+    },
+    // 批次 1：完整阶的 (点, l_i) 组合 24/24
+    {
+        { {{ 0x7030CB9B7478D410ULL, 0x859D8F22CC5603D3ULL, 0x6550644A29B39113ULL, 0x0DC1C8A204FE8F19ULL }},
+          {{ 0x3885DD71BF4F91DFULL, 0x5B8F8371258B887AULL, 0xF57C078D21B63E70ULL, 0x05B1A5CB6AE6E77EULL }} },
+        { {{ 0x49DF5F522B95340CULL, 0x80999D2B7DD6026BULL, 0x6BDF01406C1A34DBULL, 0x0A4E5A349FE3B6ABULL }},
+          {{ 0x12347128766BF1DBULL, 0x568B9179D70B8712ULL, 0xFC0AA483641CE238ULL, 0x023E375E05CC0F10ULL }} }
+    },
+    // 批次 2：完整阶的 (点, l_i) 组合 24/24
+    {
+        { {{ 0x6679A9BBF1E3EC6DULL, 0xB1A7379EAE56F322ULL, 0x8E2BB3A65B49AAE7ULL, 0x0EC22221F4560268ULL }},
+          {{ 0xB33899E95EF6A002ULL, 0xBD66D78172299169ULL, 0x4B2AF0FE8B3B2C5AULL, 0x02DB08B4FD2CA271ULL }} },
+        { {{ 0xCF2CA2DA8BEE25E9ULL, 0x1EC2491B3137F97BULL, 0x163017CF029546F1ULL, 0x0D24F74B0D9DFBB9ULL }},
+          {{ 0x1BEB9307F900D97EULL, 0x2A81E8FDF50A97C3ULL, 0xD32F55273286C864ULL, 0x013DDDDE16749BC1ULL }} }
+    }
+};
+
+#endif // EDWARDS256_TORSION_H
@@ -2,19 +2,21 @@
 #include "csidh256_params.h"
 #include "rng.h"
 #include "traditional_mul.h"
+#include "fp256_safegcd.h"
 #include <string.h>
 #include <stdlib.h>
 
-// 全局Montgomery域结构
-mont_field g_mf;
-bool g_mf_initialized = false;
+// 全局Montgomery域结构（构建时由 tools/gen_fp256_constants.c 生成，见 fp256_constants.h）
+const mont_field g_mf = FP256_CONST_MONT_FIELD;
+const bool g_mf_initialized = true;
 
-// 域运算计数器
-uint64_t FP_ADD_COMPUTED = 0;
-uint64_t FP_SQR_COMPUTED = 0;
-uint64_t FP_MUL_COMPUTED = 0;
+// 域运算计数器（线程局部）
+FP256_THREAD_LOCAL uint64_t FP_ADD_COMPUTED = 0;
+FP256_THREAD_LOCAL uint64_t FP_SQR_COMPUTED = 0;
+FP256_THREAD_LOCAL uint64_t FP_MUL_COMPUTED = 0;
 
-// 模乘方法选择：0=传统模乘, 1=Montgomery模乘
+#ifdef FP256_RUNTIME_DISPATCH
+// 模乘方法选择：0=传统模乘, 1=Montgomery模乘（仅对比基准构建）
 int g_mul_method = 1;  // 默认使用Montgomery模乘
 
 // 设置模乘方法
@@ -26,212 +28,189 @@ void set_mul_method(int method) {
 int get_mul_method(void) {
     return g_mul_method;
 }
+#endif
 
 // 素数p（CSIDH-256的素数）
 // 注意：此素数用于演示目的，不进行参数验证
+const fp p = FP256_CONST_P;
 
-const fp p = { .limbs = {
-    0xFFFFFFFFFFFFFFFF,
-    0xFFFFFFFFFFFFFFFF,
-    0xFFFFFFFFFFFFFFFF,
-    0x1FFFFFFFFFFFFFFF
-}};
+// 2p（冗余表示 [0, 2p) 的加减法使用）
+const fp two_p = FP256_CONST_TWO_P;
 
-// R = 2^256 mod p（需要在运行时计算）
-fp R_mod_p;
+// R = 2^256 mod p
+const fp R_mod_p = FP256_CONST_R_MOD_P;
 
-// R^2 mod p（需要在运行时计算）
-fp R_squared_mod_p;
+// R^2 mod p
+const fp R_squared_mod_p = FP256_CONST_R_SQUARED_MOD_P;
 
 // (p-1)/2（用于随机数生成）
-fp p_minus_1_halves;
+const fp p_minus_1_halves = FP256_CONST_P_MINUS_1_HALVES;
 
-// 初始化Montgomery域
+// Montgomery形式的小整数 k * R mod p
+const fp fp_mont_small[FP256_MONT_SMALL_COUNT] = FP256_CONST_MONT_SMALL;
+
+// 普通表示的小整数 k
+const fp fp_plain_small[FP256_MONT_SMALL_COUNT] = {
+    {{ 0 }}, {{ 1 }}, {{ 2 }}, {{ 3 }}, {{ 4 }}, {{ 5 }}, {{ 6 }}, {{ 7 }},
+    {{ 8 }}, {{ 9 }}, {{ 10 }}, {{ 11 }}, {{ 12 }}, {{ 13 }}, {{ 14 }}, {{ 15 }}
+};
+
+// 常量都已在构建时生成，不再需要初始化；保留为空函数兼容旧的调用者
 void init_montgomery_field(void) {
-    if (g_mf_initialized) return;
-    
-    // 初始化Montgomery域结构（这会设置p和p_inv）
-    mont_field_init(&g_mf);
-    
-    // 计算 R = 2^256 mod p（在普通域中）
-    // R = 2^256，然后约简到 [0, p)
-    bigint256 R_normal;
-    set_zero(&R_normal);
-    R_normal.limbs[0] = 1;
+}
+
+// fp_cswap / fp_add / fp_sub / fp_mul / fp_sqr 是 fp256.h 中的 static inline 函数，
+// 由编译期选择的后端实现。
+
+// ==================== 加法链幂运算 ====================
+
+// 固定指数的加法链（构建时生成，生成算法见 fp256_chain.c）
+static const fp_exp_chain chain_inv = FP256_CONST_CHAIN_INV;            // p - 2
+static const fp_exp_chain chain_legendre = FP256_CONST_CHAIN_LEGENDRE;  // (p - 1) / 2
+static const fp_exp_chain chain_sqrt = FP256_CONST_CHAIN_SQRT;          // (p + 1) / 4
+
+void fp_exp_chain_run(fp *out, const fp *x, const fp_exp_chain *chain) {
+    fp t[FP_EXP_MAX_TABLE];
+    fp_copy(&t[0], x);
     
-    // 计算 2^256 mod p（通过256次左移和约简）
-    for (int i = 0; i < 256; i++) {
-        bigint256 temp;
-        bigint_add(&temp, &R_normal, &R_normal);
-        if (bigint_compare(&temp, &g_mf.p) >= 0) {
-            bigint_sub(&R_normal, &temp, &g_mf.p, &g_mf.p);
+    for (int i = 0; i < chain->n_steps; i++) {
+        const fp_exp_step *st = &chain->steps[i];
+        fp tmp;
+        fp_copy(&tmp, &t[st->src]);
+        for (int j = 0; j < st->sq; j++) {
+            fp_sqr(&tmp, &tmp);
+        }
+        if (st->mul >= 0) {
+            fp_mul(&t[st->dst], &tmp, &t[st->mul]);
         } else {
-            fp_copy(&R_normal, &temp);
+            fp_copy(&t[st->dst], &tmp);
         }
     }
     
-    // R_mod_p = R（在普通域中，用于转换）
-    fp_copy(&R_mod_p, &R_normal);
-    
-    // 计算 R^2 mod p（在普通域中，使用Montgomery乘法）
-    // 注意：此时g_mf已经初始化，可以使用mont_mul
-    bigint256 R_sq_normal;
-    mont_mul(&R_sq_normal, &R_normal, &R_normal, &g_mf);
-    fp_copy(&R_squared_mod_p, &R_sq_normal);
-    
-    // 计算 (p-1)/2（在普通域中）
-    fp_copy(&p_minus_1_halves, (const fp*)&g_mf.p);
-    uint64_t carry = 0;
-    for (int i = NUMBER_OF_WORDS - 1; i >= 0; i--) {
-        uint64_t new_carry = p_minus_1_halves.limbs[i] & 1;
-        p_minus_1_halves.limbs[i] = (p_minus_1_halves.limbs[i] >> 1) | (carry << 63);
-        carry = new_carry;
-    }
-    
-    g_mf_initialized = true;
+    fp_copy(out, &t[chain->result]);
 }
 
-// 条件交换（常量时间）
-void fp_cswap(fp *x, fp *y, uint8_t c) {
-    uint64_t mask = -(uint64_t)c;
-    for (int i = 0; i < NUMBER_OF_WORDS; i++) {
-        uint64_t t = (x->limbs[i] ^ y->limbs[i]) & mask;
-        x->limbs[i] ^= t;
-        y->limbs[i] ^= t;
-    }
+// 域逆元（费马小定理：x^(-1) = x^(p-2)，预生成的加法链）
+void fp_inv_fermat(fp *x) {
+    fp_exp_chain_run(x, x, &chain_inv);
 }
 
-// 域加法（在Montgomery域中）
-void fp_add(fp *c, const fp *a, const fp *b) {
-    if (!g_mf_initialized) init_montgomery_field();
-    
-    bigint256 temp;
-    bigint_add(&temp, (const bigint256*)a, (const bigint256*)b);
-    
-    // 在Montgomery域中，需要检查是否超过p
-    if (bigint_compare(&temp, &g_mf.p) >= 0) {
-        bigint_sub((bigint256*)c, &temp, &g_mf.p, &g_mf.p);
-    } else {
-        fp_copy(c, &temp);
-    }
-    
-    FP_ADD_COMPUTED++;
-}
-
-// 域减法（在Montgomery域中）
-void fp_sub(fp *c, const fp *a, const fp *b) {
-    if (!g_mf_initialized) init_montgomery_field();
-    
-    bigint256 temp;
-    // 先计算a-b
-    uint64_t borrow = 0;
-    for (int i = 0; i < LIMBS; i++) {
-        __uint128_t diff = (__uint128_t)a->limbs[i] - b->limbs[i] - borrow;
-        temp.limbs[i] = (uint64_t)diff;
-        borrow = (diff >> 64) ? 1 : 0;
-    }
+// 判断是否为平方数（欧拉准则：x^((p-1)/2) = 1，Montgomery表示下是 R mod p）
+uint8_t fp_issquare_euler(const fp *x) {
+    fp result;
+    fp_exp_chain_run(&result, x, &chain_legendre);
+    fp_canonicalize(&result);
     
-    // 如果借位，说明a < b，需要加p
-    if (borrow) {
-        bigint_add((bigint256*)c, &temp, &g_mf.p);
-    } else {
-        fp_copy(c, &temp);
+    // 常量时间比较
+    uint64_t diff = 0;
+    for (int i = 0; i < NUMBER_OF_WORDS; i++) {
+        diff |= result.limbs[i] ^ fp_one()->limbs[i];
     }
-    
-    FP_ADD_COMPUTED++;
+    return (uint8_t)(1 ^ ((diff | -diff) >> 63));
 }
 
-// 域乘法（可切换：传统模乘或Montgomery模乘）
-void fp_mul(fp *c, const fp *a, const fp *b) {
-    if (g_mul_method == 0) {
-        // 使用传统模乘
-        traditional_mod_mul_real((bigint256*)c, (const bigint256*)a, (const bigint256*)b);
-    } else {
-        // 使用Montgomery模乘
-        if (!g_mf_initialized) init_montgomery_field();
-        mont_mul((bigint256*)c, (const bigint256*)a, (const bigint256*)b, &g_mf);
-    }
-    FP_MUL_COMPUTED++;
+// 域逆元与平方判定：默认使用safegcd，定义 FP256_INV_FERMAT 时使用费马幂运算
+void fp_inv(fp *x) {
+    fp_canonicalize(x);
+#ifdef FP256_INV_FERMAT
+    fp_inv_fermat(x);
+#else
+    fp_inv_safegcd(x);
+#endif
 }
 
-// 域平方（使用Montgomery乘法）
-void fp_sqr(fp *b, const fp *a) {
-    fp_mul(b, a, a);
-    FP_SQR_COMPUTED++;
+uint8_t fp_issquare(const fp *x) {
+#ifndef FP256_INV_FERMAT
+    fp xc;
+    fp_copy(&xc, x);
+    fp_canonicalize(&xc);
+    return (uint8_t)(fp_jacobi_bingcd(&xc) == 1);
+#else
+    return fp_issquare_euler(x);
+#endif
 }
 
-// 域逆元（使用扩展欧几里得算法或费马小定理）
-void fp_inv(fp *x) {
-    if (!g_mf_initialized) init_montgomery_field();
-    
-    // 使用费马小定理：x^(-1) = x^(p-2) mod p
-    // 这里使用简单的二进制方法
-    fp result, base;
-    set_one(&result);
-    fp_copy(&base, x);
-    
-    // p-2 = 2^256 - 3 (对于我们的p)
-    bigint256 exp;
-    fp_copy((fp*)&exp, (const fp*)&g_mf.p);
-    exp.limbs[0] -= 2;
-    
-    for (int i = 0; i < 256; i++) {
-        int word_idx = i / 64;
-        int bit_idx = i % 64;
-        if (word_idx < NUMBER_OF_WORDS && (exp.limbs[word_idx] >> bit_idx) & 1) {
-            fp_mul(&result, &result, &base);
+// 批量求逆：prefix[i] = x_0 * ... * x_i，只对总乘积求一次逆，再从后往前拆出每个逆元
+void fp_inv_batch(fp *xs, size_t n) {
+    if (n == 0) return;
+    // 前缀积和零元素掩码放在同一块内存里
+    fp *prefix = (fp*)malloc(n * (sizeof(fp) + sizeof(uint64_t)));
+    if (prefix == NULL) {
+        // 内存不足时逐个求逆
+        for (size_t i = 0; i < n; i++) {
+            fp_inv(&xs[i]);
         }
-        if (i < 255) {
-            fp_sqr(&base, &base);
+        return;
+    }
+    uint64_t *zero_mask = (uint64_t*)(prefix + n);
+    
+    // 0 会让整个乘积为0：常量时间地先换成1，最后再清零
+    for (size_t i = 0; i < n; i++) {
+        fp_canonicalize(&xs[i]);
+        uint64_t nz = 0;
+        for (int k = 0; k < NUMBER_OF_WORDS; k++) {
+            nz |= xs[i].limbs[k];
+        }
+        zero_mask[i] = ((nz | -nz) >> 63) - 1;
+        for (int k = 0; k < NUMBER_OF_WORDS; k++) {
+            xs[i].limbs[k] |= fp_one()->limbs[k] & zero_mask[i];
         }
     }
     
-    fp_copy(x, &result);
-    FP_MUL_COMPUTED += 256; // 近似计数
-}
-
-// 判断是否为平方数（Legendre符号）
-uint8_t fp_issquare(const fp *x) {
-    if (!g_mf_initialized) init_montgomery_field();
-    
-    // 使用欧拉准则：x是平方数当且仅当 x^((p-1)/2) = 1 mod p
-    fp temp;
-    fp_copy(&temp, x);
+    fp_copy(&prefix[0], &xs[0]);
+    for (size_t i = 1; i < n; i++) {
+        fp_mul(&prefix[i], &prefix[i - 1], &xs[i]);
+    }
     
-    // 计算 x^((p-1)/2)
-    fp result;
-    set_one(&result);
-    fp_copy(&temp, x);
+    fp inv;
+    fp_copy(&inv, &prefix[n - 1]);
+    fp_inv(&inv);
     
-    bigint256 exp = p_minus_1_halves;
+    // inv = (x_0 ... x_i)^(-1)：x_i^(-1) = inv * prefix[i-1]，然后 inv *= x_i
+    for (size_t i = n - 1; i > 0; i--) {
+        fp xi_inv;
+        fp_mul(&xi_inv, &inv, &prefix[i - 1]);
+        fp_mul(&inv, &inv, &xs[i]);
+        fp_copy(&xs[i], &xi_inv);
+    }
+    fp_copy(&xs[0], &inv);
     
-    for (int i = 0; i < 256; i++) {
-        int word_idx = i / 64;
-        int bit_idx = i % 64;
-        if (word_idx < NUMBER_OF_WORDS && (exp.limbs[word_idx] >> bit_idx) & 1) {
-            fp_mul(&result, &result, &temp);
-        }
-        if (i < 255) {
-            fp_sqr(&temp, &temp);
+    for (size_t i = 0; i < n; i++) {
+        for (int k = 0; k < NUMBER_OF_WORDS; k++) {
+            xs[i].limbs[k] &= ~zero_mask[i];
         }
     }
     
-    // 检查结果是否为1
-    fp one;
-    set_one(&one);
-    return (fp_compare(&result, &one) == 0) ? 1 : 0;
+    free(prefix);
 }
 
+// 平方根（p = 3 mod 4：sqrt(x) = x^((p+1)/4)，x 需为平方数）
+void fp_sqrt(fp *x) {
+    fp_exp_chain_run(x, x, &chain_sqrt);
+}
+
+// l 次方根（l ∤ p - 1），加法链只在 p 满足条件时生成
+#ifdef FP256_CONST_CHAIN_ROOT3
+static const fp_exp_chain chain_root3 = FP256_CONST_CHAIN_ROOT3;  // 3^(-1) mod (p - 1)
+void fp_root3(fp *x) {
+    fp_exp_chain_run(x, x, &chain_root3);
+}
+#endif
+#ifdef FP256_CONST_CHAIN_ROOT5
+static const fp_exp_chain chain_root5 = FP256_CONST_CHAIN_ROOT5;  // 5^(-1) mod (p - 1)
+void fp_root5(fp *x) {
+    fp_exp_chain_run(x, x, &chain_root5);
+}
+#endif
+#ifdef FP256_CONST_CHAIN_ROOT7
+static const fp_exp_chain chain_root7 = FP256_CONST_CHAIN_ROOT7;  // 7^(-1) mod (p - 1)
+void fp_root7(fp *x) {
+    fp_exp_chain_run(x, x, &chain_root7);
+}
+#endif
+
 // 生成随机域元素（在Montgomery域中）
 void fp_random(fp *x) {
-    // 确保Montgomery域已初始化
-    if (!g_mf_initialized) {
-        init_montgomery_field();
-    }
-    
-    // 使用密码学安全的随机数生成器
-    extern void randombytes(void *x, size_t l);
-    
     // 生成随机数（在普通域中）
     bigint256 x_normal;
     do {
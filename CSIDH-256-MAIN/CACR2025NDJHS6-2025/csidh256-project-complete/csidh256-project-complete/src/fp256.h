@@ -4,42 +4,432 @@
 #include "params.h"
 #include "mont_field.h"
 #include "csidh256_params.h"
+#include "fp256_chain.h"
+#include "fp256_constants.h"
 #include <stdint.h>
+#include <stddef.h>
 #include <stdbool.h>
 
 // 256位域元素类型（在Montgomery域中）
 typedef bigint256 fp;
 
-// 全局Montgomery域结构（需要在实现文件中定义）
-extern mont_field g_mf;
-extern bool g_mf_initialized;
+// 线程局部存储（域运算计数器按线程独立统计）
+#if defined(_MSC_VER)
+#define FP256_THREAD_LOCAL __declspec(thread)
+#else
+#define FP256_THREAD_LOCAL _Thread_local
+#endif
+
+// 全局域常量：构建时由 tools/gen_fp256_constants.c 根据 p 生成（src/fp256_constants.h），
+// 是只读的静态数据，不需要运行时初始化，多个线程可以并发调用 action_evaluation。
+extern const mont_field g_mf;
+extern const bool g_mf_initialized;  // 恒为 true（兼容旧代码）
 extern const fp p;
-extern fp R_mod_p;
-extern fp R_squared_mod_p;
-extern fp p_minus_1_halves;
+extern const fp two_p;
+extern const fp R_mod_p;
+extern const fp R_squared_mod_p;
+extern const fp p_minus_1_halves;
+extern const fp fp_mont_small[FP256_MONT_SMALL_COUNT];  // k * R mod p，k = 0..15
+extern const fp fp_plain_small[FP256_MONT_SMALL_COUNT]; // 普通表示的 k（传统模乘后端）
 
-// 初始化函数
+// 旧的初始化入口，现在是空操作（保留兼容）
 void init_montgomery_field(void);
 
-// 域运算计数器（用于性能分析）
-extern uint64_t FP_ADD_COMPUTED;
-extern uint64_t FP_SQR_COMPUTED;
-extern uint64_t FP_MUL_COMPUTED;
+// 域运算计数器（用于性能分析，每个线程一份）
+extern FP256_THREAD_LOCAL uint64_t FP_ADD_COMPUTED;
+extern FP256_THREAD_LOCAL uint64_t FP_SQR_COMPUTED;
+extern FP256_THREAD_LOCAL uint64_t FP_MUL_COMPUTED;
+
+// ==================== 域运算后端（编译期选择）====================
+// make FP_BACKEND=c     可移植C Montgomery（默认，src/mont_field.c）
+// make FP_BACKEND=asm   x86-64汇编Montgomery（src/fp256.S，定义 FP256_ASM）
+// make FP_BACKEND=trad  传统模乘（src/traditional_mul.c，定义 FP256_TRADITIONAL）
+// 域运算都是 static inline，热路径上没有全局方法分支，也没有初始化检查。
+//
+// 定义 FP256_RUNTIME_DISPATCH 时保留 set_mul_method 的运行时切换，
+// 只用于传统模乘/Montgomery模乘的对比基准程序（interactive_key_exchange）。
+#if defined(FP256_TRADITIONAL) || defined(FP256_RUNTIME_DISPATCH)
+#include "traditional_mul.h"
+#endif
+
+#ifdef FP256_ASM
+// x86-64汇编后端（src/fp256.S，需要BMI2/ADX）
+void fp256_asm_cswap(fp *x, fp *y, uint8_t c);
+void fp256_asm_add(fp *c, const fp *a, const fp *b);
+void fp256_asm_sub(fp *c, const fp *a, const fp *b);
+void fp256_asm_mul(fp *c, const fp *a, const fp *b);
+void fp256_asm_sqr(fp *b, const fp *a);
+void fp256_asm_mul2_add(fp *r, const fp *a, const fp *b, const fp *c, const fp *d);
+void fp256_asm_mul2_sub(fp *r, const fp *a, const fp *b, const fp *c, const fp *d);
+#endif
 
-// 模乘方法选择函数
+#ifdef FP256_RUNTIME_DISPATCH
+// 模乘方法选择函数（仅对比基准构建）
+extern int g_mul_method;
 void set_mul_method(int method);  // 0=传统模乘, 1=Montgomery模乘
 int get_mul_method(void);
+#endif
+
+// ==================== 冗余表示（make FP_LAZY=1，定义 FP256_LAZY）====================
+// p < 2^253，最高字留有空位。冗余模式下域元素存放在 [0, 2p) 而不是 [0, p)：
+//   fp_mul / fp_sqr  省掉Montgomery约简最后的减 p（输入 < 2p 时输出仍 < 2p）
+//   fp_add           a + b < 4p，条件减 2p
+//   fp_sub           借位时加 2p
+//   fp_add_nr/sub_nr 完全不约简，结果在 [0, 4p)，只能直接作为 fp_mul 的一个操作数
+// 比较、判零、求逆、平方判定以及输出（proj_normalize_batch）之前用 fp_canonicalize
+// 规约到 [0, p)；fp_compare / fp_iszero 内部已经处理。
+// 只支持Montgomery后端（c / asm）。
+#ifdef FP256_LAZY
+#if defined(FP256_TRADITIONAL) || defined(FP256_RUNTIME_DISPATCH)
+#error "FP256_LAZY requires a Montgomery backend (FP_BACKEND=c or asm)"
+#endif
+#define FP256_REPR_NAME "redundant [0, 2p)"
+#else
+#define FP256_REPR_NAME "canonical [0, p)"
+#endif
+
+// 当前后端名称（用于基准输出）
+#if defined(FP256_ASM)
+#define FP256_BACKEND_NAME "x86-64 assembly Montgomery (BMI2/ADX)"
+#elif defined(FP256_TRADITIONAL)
+#define FP256_BACKEND_NAME "traditional (Barrett-style) reduction"
+#else
+#define FP256_BACKEND_NAME "portable C Montgomery"
+#endif
+
+#ifdef FP256_INV_FERMAT
+#define FP256_INV_NAME "Fermat addition chain"
+#else
+#define FP256_INV_NAME "safegcd (Bernstein-Yang divsteps)"
+#endif
+
+// 可移植的常量时间加减法（C和传统后端共用）
+// a, b < p < 2^254，所以 a + b 不会溢出4个字
+static inline void fp_add_portable(fp *c, const fp *a, const fp *b) {
+    uint64_t sum[NUMBER_OF_WORDS], red[NUMBER_OF_WORDS];
+    __uint128_t t = 0;
+    for (int i = 0; i < NUMBER_OF_WORDS; i++) {
+        t += (__uint128_t)a->limbs[i] + b->limbs[i];
+        sum[i] = (uint64_t)t;
+        t >>= 64;
+    }
+    uint64_t borrow = 0;
+    for (int i = 0; i < NUMBER_OF_WORDS; i++) {
+        __uint128_t d = (__uint128_t)sum[i] - p.limbs[i] - borrow;
+        red[i] = (uint64_t)d;
+        borrow = (uint64_t)(d >> 64) & 1;
+    }
+    // borrow = 1 表示 sum < p，保留 sum
+    uint64_t mask = -borrow;
+    for (int i = 0; i < NUMBER_OF_WORDS; i++) {
+        c->limbs[i] = (sum[i] & mask) | (red[i] & ~mask);
+    }
+}
+
+static inline void fp_sub_portable(fp *c, const fp *a, const fp *b) {
+    uint64_t diff[NUMBER_OF_WORDS];
+    uint64_t borrow = 0;
+    for (int i = 0; i < NUMBER_OF_WORDS; i++) {
+        __uint128_t d = (__uint128_t)a->limbs[i] - b->limbs[i] - borrow;
+        diff[i] = (uint64_t)d;
+        borrow = (uint64_t)(d >> 64) & 1;
+    }
+    // 借位时加回 p（掩码，无分支）
+    uint64_t mask = -borrow;
+    __uint128_t t = 0;
+    for (int i = 0; i < NUMBER_OF_WORDS; i++) {
+        t += (__uint128_t)diff[i] + (p.limbs[i] & mask);
+        c->limbs[i] = (uint64_t)t;
+        t >>= 64;
+    }
+}
+
+#ifdef FP256_LAZY
+// 冗余表示的加减法（2p < 2^254）
+// a, b < 2p：a + b < 4p 不会溢出，条件减 2p
+static inline void fp_add_lazy_portable(fp *c, const fp *a, const fp *b) {
+    uint64_t sum[NUMBER_OF_WORDS], red[NUMBER_OF_WORDS];
+    __uint128_t t = 0;
+    for (int i = 0; i < NUMBER_OF_WORDS; i++) {
+        t += (__uint128_t)a->limbs[i] + b->limbs[i];
+        sum[i] = (uint64_t)t;
+        t >>= 64;
+    }
+    uint64_t borrow = 0;
+    for (int i = 0; i < NUMBER_OF_WORDS; i++) {
+        __uint128_t d = (__uint128_t)sum[i] - two_p.limbs[i] - borrow;
+        red[i] = (uint64_t)d;
+        borrow = (uint64_t)(d >> 64) & 1;
+    }
+    uint64_t mask = -borrow;
+    for (int i = 0; i < NUMBER_OF_WORDS; i++) {
+        c->limbs[i] = (sum[i] & mask) | (red[i] & ~mask);
+    }
+}
+
+static inline void fp_sub_lazy_portable(fp *c, const fp *a, const fp *b) {
+    uint64_t diff[NUMBER_OF_WORDS];
+    uint64_t borrow = 0;
+    for (int i = 0; i < NUMBER_OF_WORDS; i++) {
+        __uint128_t d = (__uint128_t)a->limbs[i] - b->limbs[i] - borrow;
+        diff[i] = (uint64_t)d;
+        borrow = (uint64_t)(d >> 64) & 1;
+    }
+    uint64_t mask = -borrow;
+    __uint128_t t = 0;
+    for (int i = 0; i < NUMBER_OF_WORDS; i++) {
+        t += (__uint128_t)diff[i] + (two_p.limbs[i] & mask);
+        c->limbs[i] = (uint64_t)t;
+        t >>= 64;
+    }
+}
+#endif
+
+// 规约到 [0, p)：冗余模式下常量时间条件减 p，其它模式下元素本来就是规约的
+static inline void fp_canonicalize(fp *x) {
+#ifdef FP256_LAZY
+    uint64_t red[NUMBER_OF_WORDS];
+    uint64_t borrow = 0;
+    for (int i = 0; i < NUMBER_OF_WORDS; i++) {
+        __uint128_t d = (__uint128_t)x->limbs[i] - p.limbs[i] - borrow;
+        red[i] = (uint64_t)d;
+        borrow = (uint64_t)(d >> 64) & 1;
+    }
+    uint64_t mask = -borrow;
+    for (int i = 0; i < NUMBER_OF_WORDS; i++) {
+        x->limbs[i] = (x->limbs[i] & mask) | (red[i] & ~mask);
+    }
+#else
+    (void)x;
+#endif
+}
+
+// 后端原语（不计数）
+static inline void fp_backend_cswap(fp *x, fp *y, uint8_t c) {
+#ifdef FP256_ASM
+    fp256_asm_cswap(x, y, c);
+#else
+    uint64_t mask = -(uint64_t)c;
+    for (int i = 0; i < NUMBER_OF_WORDS; i++) {
+        uint64_t t = (x->limbs[i] ^ y->limbs[i]) & mask;
+        x->limbs[i] ^= t;
+        y->limbs[i] ^= t;
+    }
+#endif
+}
+
+static inline void fp_backend_add(fp *c, const fp *a, const fp *b) {
+#if defined(FP256_ASM)
+    fp256_asm_add(c, a, b);
+#elif defined(FP256_LAZY)
+    fp_add_lazy_portable(c, a, b);
+#else
+    fp_add_portable(c, a, b);
+#endif
+}
+
+static inline void fp_backend_sub(fp *c, const fp *a, const fp *b) {
+#if defined(FP256_ASM)
+    fp256_asm_sub(c, a, b);
+#elif defined(FP256_LAZY)
+    fp_sub_lazy_portable(c, a, b);
+#else
+    fp_sub_portable(c, a, b);
+#endif
+}
+
+static inline void fp_backend_mul(fp *c, const fp *a, const fp *b) {
+#if defined(FP256_ASM)
+    fp256_asm_mul(c, a, b);
+#elif defined(FP256_TRADITIONAL)
+    traditional_mod_mul_real(c, a, b);
+#elif defined(FP256_LAZY)
+    mont_mul_lazy(c, a, b, &g_mf);
+#else
+    mont_mul(c, a, b, &g_mf);
+#endif
+}
+
+static inline void fp_backend_sqr(fp *b, const fp *a) {
+#if defined(FP256_ASM)
+    fp256_asm_sqr(b, a);
+#elif defined(FP256_TRADITIONAL)
+    traditional_mod_mul_real(b, a, a);
+#elif defined(FP256_LAZY)
+    mont_sqr_lazy(b, a, &g_mf);
+#else
+    mont_sqr(b, a, &g_mf);
+#endif
+}
+
+// 冗余模式下 mont_mul2_addsub 省掉最后的减 p
+#ifdef FP256_LAZY
+#define FP256_MUL2_LAZY 1
+#else
+#define FP256_MUL2_LAZY 0
+#endif
+
+// 域运算函数（所有输出允许与输入重叠）
+static inline void fp_cswap(fp *x, fp *y, uint8_t c) {
+    fp_backend_cswap(x, y, c);
+}
 
-// 域运算函数（适配现有的Montgomery实现）
-void fp_cswap(fp *x, fp *y, uint8_t c);
+static inline void fp_add(fp *c, const fp *a, const fp *b) {
+    fp_backend_add(c, a, b);
+    FP_ADD_COMPUTED++;
+}
 
-void fp_add(fp *c, const fp *a, const fp *b);
-void fp_sub(fp *c, const fp *a, const fp *b);
-void fp_mul(fp *c, const fp *a, const fp *b);
-void fp_sqr(fp *b, const fp *a);
+static inline void fp_sub(fp *c, const fp *a, const fp *b) {
+    fp_backend_sub(c, a, b);
+    FP_ADD_COMPUTED++;
+}
 
+// 不约简的加减法：冗余模式下结果在 [0, 4p)，只能直接送入 fp_mul 作为一个操作数
+// （另一个操作数 < 2p）；非冗余模式下就是 fp_add / fp_sub
+static inline void fp_add_nr(fp *c, const fp *a, const fp *b) {
+#ifdef FP256_LAZY
+    __uint128_t t = 0;
+    for (int i = 0; i < NUMBER_OF_WORDS; i++) {
+        t += (__uint128_t)a->limbs[i] + b->limbs[i];
+        c->limbs[i] = (uint64_t)t;
+        t >>= 64;
+    }
+#else
+    fp_backend_add(c, a, b);
+#endif
+    FP_ADD_COMPUTED++;
+}
+
+// a + 2p - b：a, b < 2p 时结果在 (0, 4p)，不需要借位处理
+static inline void fp_sub_nr(fp *c, const fp *a, const fp *b) {
+#ifdef FP256_LAZY
+    __int128 t = 0;
+    for (int i = 0; i < NUMBER_OF_WORDS; i++) {
+        t += (__int128)a->limbs[i] + two_p.limbs[i] - b->limbs[i];
+        c->limbs[i] = (uint64_t)t;
+        t >>= 64;
+    }
+#else
+    fp_backend_sub(c, a, b);
+#endif
+    FP_ADD_COMPUTED++;
+}
+
+static inline void fp_mul(fp *c, const fp *a, const fp *b) {
+#ifdef FP256_RUNTIME_DISPATCH
+    if (g_mul_method == 0) {
+        traditional_mod_mul_real(c, a, b);
+    } else
+#endif
+    fp_backend_mul(c, a, b);
+    FP_MUL_COMPUTED++;
+}
+
+static inline void fp_sqr(fp *b, const fp *a) {
+#ifdef FP256_RUNTIME_DISPATCH
+    if (g_mul_method == 0) {
+        traditional_mod_mul_real(b, a, a);
+    } else
+#endif
+    fp_backend_sqr(b, a);
+    FP_SQR_COMPUTED++;
+}
+
+// ==================== 乘积和：一次约简 ====================
+// r = a*b + c*d / r = a*b - c*d：两个乘积在512位上相加减后只做一次Montgomery约简，
+// 比 fp_mul + fp_mul + fp_add 少一次约简。求差时先加上 4p^2（p 的倍数，不小于 c*d）
+// 保证非负：T < 8p^2 < 2pR，结果与 fp_mul 的输出范围相同。
+// 输入要求与 fp_mul 相同（< p，冗余模式下 < 2p；不能是 fp_add_nr 的结果）。
+// 计数按 2M + 1a 记录，与分开计算一致。
+// 传统模乘后端（以及运行时切换到传统模乘时）退化为分开计算。
+#if !defined(FP256_TRADITIONAL) && defined(FP256_RUNTIME_DISPATCH)
+#define FP256_MUL2_FUSED (g_mul_method == 1)
+#elif !defined(FP256_TRADITIONAL)
+#define FP256_MUL2_FUSED 1
+#else
+#define FP256_MUL2_FUSED 0
+#endif
+
+static inline void fp_mul2_add(fp *r, const fp *a, const fp *b, const fp *c, const fp *d) {
+    if (FP256_MUL2_FUSED) {
+#if defined(FP256_ASM)
+        fp256_asm_mul2_add(r, a, b, c, d);
+#elif !defined(FP256_TRADITIONAL)
+        mont_mul2_addsub(r, NULL, a, b, c, d, FP256_MUL2_LAZY, &g_mf);
+#endif
+        FP_MUL_COMPUTED += 2;
+        FP_ADD_COMPUTED++;
+        return;
+    }
+    fp t;
+    fp_mul(&t, c, d);
+    fp_mul(r, a, b);
+    fp_add(r, r, &t);
+}
+
+static inline void fp_mul2_sub(fp *r, const fp *a, const fp *b, const fp *c, const fp *d) {
+    if (FP256_MUL2_FUSED) {
+#if defined(FP256_ASM)
+        fp256_asm_mul2_sub(r, a, b, c, d);
+#elif !defined(FP256_TRADITIONAL)
+        mont_mul2_addsub(NULL, r, a, b, c, d, FP256_MUL2_LAZY, &g_mf);
+#endif
+        FP_MUL_COMPUTED += 2;
+        FP_ADD_COMPUTED++;
+        return;
+    }
+    fp t;
+    fp_mul(&t, c, d);
+    fp_mul(r, a, b);
+    fp_sub(r, r, &t);
+}
+
+// s = a*b + c*d, t = a*b - c*d（yADD / yEVAL 中成对出现的形式，s, t 可以与输入重叠）：
+// 两个乘积只算一次，和与差各约简一次，省掉两次模加减。
+// 汇编后端的模加减本身只有几条指令，512位加减反而更慢，所以汇编后端仍然分开计算。
+static inline void fp_mul2_addsub(fp *s, fp *t, const fp *a, const fp *b, const fp *c, const fp *d) {
+#if !defined(FP256_ASM) && !defined(FP256_TRADITIONAL)
+    if (FP256_MUL2_FUSED) {
+        mont_mul2_addsub(s, t, a, b, c, d, FP256_MUL2_LAZY, &g_mf);
+        FP_MUL_COMPUTED += 2;
+        FP_ADD_COMPUTED += 2;
+        return;
+    }
+#endif
+    fp x, y;
+    fp_mul(&x, a, b);
+    fp_mul(&y, c, d);
+    fp_add(s, &x, &y);
+    fp_sub(t, &x, &y);
+}
+
+// ==================== 加法链幂运算 ====================
+// 加法链的结构与生成见 fp256_chain.h
+// out = x^e（Montgomery域），out 可以与 x 重叠
+void fp_exp_chain_run(fp *out, const fp *x, const fp_exp_chain *chain);
+
+// 域逆元 / 平方判定：默认走 src/fp256_safegcd.c 的常量时间safegcd，
+// make FP_INV=fermat（定义 FP256_INV_FERMAT）时走上面的加法链幂运算
 void fp_inv(fp *x);
 uint8_t fp_issquare(const fp *x);
+// 批量求逆（Montgomery技巧）：xs[i] <- xs[i]^(-1)，共 3(n-1) 次乘法 + 1 次 fp_inv。
+// 值为0的元素结果仍为0，且不影响其它元素（常量时间处理）；
+// p 为合数时，非0元素须与 p 互素，否则整批结果无意义。
+void fp_inv_batch(fp *xs, size_t n);
+void fp_inv_fermat(fp *x);
+uint8_t fp_issquare_euler(const fp *x);
+void fp_sqrt(fp *x);
+// l 次方根（l 不整除 p - 1 时唯一，x^(1/l) = x^(l^(-1) mod (p-1))），根式同源用；
+// 只有 p 满足条件时才有对应的加法链（fp256_constants.h 中的 FP256_CONST_CHAIN_ROOT<l>）
+#ifdef FP256_CONST_CHAIN_ROOT3
+void fp_root3(fp *x);
+#endif
+#ifdef FP256_CONST_CHAIN_ROOT5
+void fp_root5(fp *x);
+#endif
+#ifdef FP256_CONST_CHAIN_ROOT7
+void fp_root7(fp *x);
+#endif
 void fp_random(fp *x);
 
 // 辅助函数（使用指针传递）
@@ -49,10 +439,31 @@ static inline void set_zero(fp *x) {
     }
 }
 
+// 当前后端的表示：Montgomery后端乘了 R，传统模乘用普通表示
+static inline int fp_is_montgomery(void) {
+#if defined(FP256_TRADITIONAL)
+    return 0;
+#elif defined(FP256_RUNTIME_DISPATCH)
+    return g_mul_method == 1;
+#else
+    return 1;
+#endif
+}
+
+// 当前表示下的小整数 k（k < FP256_MONT_SMALL_COUNT）
+static inline const fp *fp_small(int k) {
+    return fp_is_montgomery() ? &fp_mont_small[k] : &fp_plain_small[k];
+}
+
+// 域中的1：Montgomery后端是 R mod p，传统模乘是 1
+static inline const fp *fp_one(void) {
+    return fp_small(1);
+}
+
 static inline void set_one(fp *x) {
-    x->limbs[0] = 1;
-    for (int i = 1; i < NUMBER_OF_WORDS; i++) {
-        x->limbs[i] = 0;
+    const fp *one = fp_one();
+    for (int i = 0; i < NUMBER_OF_WORDS; i++) {
+        x->limbs[i] = one->limbs[i];
     }
 }
 
@@ -62,7 +473,17 @@ static inline void fp_copy(fp *x, const fp *y) {
     }
 }
 
+// 比较/判零按规约后的值进行（冗余模式下 x 与 x + p 相等）
 static inline int fp_compare(const fp *x, const fp *y) {
+#ifdef FP256_LAZY
+    fp xc, yc;
+    fp_copy(&xc, x);
+    fp_copy(&yc, y);
+    fp_canonicalize(&xc);
+    fp_canonicalize(&yc);
+    x = &xc;
+    y = &yc;
+#endif
     for (int i = NUMBER_OF_WORDS - 1; i >= 0; i--) {
         if (x->limbs[i] > y->limbs[i]) return 1;
         if (x->limbs[i] < y->limbs[i]) return -1;
@@ -71,6 +492,12 @@ static inline int fp_compare(const fp *x, const fp *y) {
 }
 
 static inline int fp_iszero(const fp *x) {
+#ifdef FP256_LAZY
+    fp xc;
+    fp_copy(&xc, x);
+    fp_canonicalize(&xc);
+    x = &xc;
+#endif
     for (int i = 0; i < NUMBER_OF_WORDS; i++) {
         if (x->limbs[i] != 0) return 0;
     }
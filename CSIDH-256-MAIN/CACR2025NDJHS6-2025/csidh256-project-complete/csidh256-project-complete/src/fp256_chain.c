@@ -0,0 +1,92 @@
+// 固定指数加法链的生成（只做整数运算，不依赖域常量；
+// tools/gen_fp256_constants.c 用它预生成 fp_inv / fp_issquare / fp_sqrt 的加法链）
+#include "fp256_chain.h"
+#include <string.h>
+
+static int exp_bit(const bigint256 *e, int i) {
+    return (int)((e->limbs[i / 64] >> (i % 64)) & 1);
+}
+
+static int chain_push(fp_exp_chain *chain, int dst, int src, int mul, int sq) {
+    if (chain->n_steps >= FP_EXP_MAX_STEPS) return 0;
+    fp_exp_step *st = &chain->steps[chain->n_steps++];
+    st->dst = (uint8_t)dst;
+    st->src = (uint8_t)src;
+    st->mul = (int8_t)mul;
+    st->sq = (uint16_t)sq;
+    chain->n_sqr += sq;
+    if (mul >= 0) chain->n_mul++;
+    return 1;
+}
+
+int fp_exp_chain_build(fp_exp_chain *chain, const bigint256 *e) {
+    memset(chain, 0, sizeof(*chain));
+    
+    int top = LIMBS * 64 - 1;
+    while (top >= 0 && !exp_bit(e, top)) top--;
+    if (top < 0) return 0;
+    
+    // 1. 从高位到低位把 e 切成"L个1 + z个0"的段
+    int run_len[LIMBS * 32], run_zeros[LIMBS * 32];
+    int n_runs = 0, max_len = 0;
+    for (int i = top; i >= 0; ) {
+        int L = 0, z = 0;
+        while (i >= 0 && exp_bit(e, i)) { L++; i--; }
+        while (i >= 0 && !exp_bit(e, i)) { z++; i--; }
+        run_len[n_runs] = L;
+        run_zeros[n_runs] = z;
+        n_runs++;
+        if (L > max_len) max_len = L;
+    }
+    
+    // 2. 倍增：pow2_slot[k] 保存 x^(2^(2^k) - 1)
+    int pow2_slot[10];
+    int k = 0;
+    pow2_slot[0] = 0;
+    chain->n_table = 1;
+    while ((2 << k) <= max_len) {
+        int s = chain->n_table++;
+        if (!chain_push(chain, s, pow2_slot[k], pow2_slot[k], 1 << k)) return 0;
+        pow2_slot[++k] = s;
+    }
+    
+    // 3. 每种段长 L 按二进制拼出 x^(2^L - 1)，相同长度只算一次
+    int len_slot[LIMBS * 64 + 1];
+    for (int i = 0; i <= LIMBS * 64; i++) len_slot[i] = -1;
+    for (int r = 0; r < n_runs; r++) {
+        int L = run_len[r];
+        if (len_slot[L] >= 0) continue;
+        
+        int hb = 0;
+        while ((2 << hb) <= L) hb++;
+        if (L == (1 << hb)) {
+            len_slot[L] = pow2_slot[hb];
+            continue;
+        }
+        
+        if (chain->n_table >= FP_EXP_MAX_TABLE - 1) return 0;
+        int s = chain->n_table++;
+        int cur = pow2_slot[hb];
+        for (int j = hb - 1; j >= 0; j--) {
+            if ((L >> j) & 1) {
+                if (!chain_push(chain, s, cur, pow2_slot[j], 1 << j)) return 0;
+                cur = s;
+            }
+        }
+        len_slot[L] = s;
+    }
+    
+    // 4. Horner：acc = acc^(2^(z + L)) * x^(2^L - 1)，最后补上末尾的0
+    int acc = chain->n_table++;
+    int src = len_slot[run_len[0]];
+    for (int r = 1; r < n_runs; r++) {
+        if (!chain_push(chain, acc, src, len_slot[run_len[r]], run_zeros[r - 1] + run_len[r])) return 0;
+        src = acc;
+    }
+    if (run_zeros[n_runs - 1] > 0) {
+        if (!chain_push(chain, acc, src, -1, run_zeros[n_runs - 1])) return 0;
+        src = acc;
+    }
+    chain->result = src;
+    return 1;
+}
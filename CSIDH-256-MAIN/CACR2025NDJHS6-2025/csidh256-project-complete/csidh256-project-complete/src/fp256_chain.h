@@ -0,0 +1,36 @@
+#ifndef FP256_CHAIN_H
+#define FP256_CHAIN_H
+
+#include "params.h"
+#include <stdint.h>
+
+// ==================== 固定指数的加法链 ====================
+// 指数 e 公开且固定（p-2、(p-1)/2、(p+1)/4），构建时（tools/gen_fp256_constants.c）
+// 按 e 的二进制"连续1段"生成加法链：
+//   t_L = x^(2^L - 1)，t_{a+b} = t_a^(2^b) * t_b
+// 先用倍增得到 t_1, t_2, t_4, ...，再拼出各段长度 L，最后用Horner规则按段合并。
+// 每一步都是 t[dst] = t[src]^(2^sq) * t[mul]（mul < 0 表示只平方），
+// 操作序列只依赖 e，与底数无关，因此是常量时间的。
+#define FP_EXP_MAX_TABLE 40
+#define FP_EXP_MAX_STEPS 320
+
+typedef struct {
+    uint8_t dst;
+    uint8_t src;
+    int8_t mul;
+    uint16_t sq;
+} fp_exp_step;
+
+typedef struct {
+    int n_table;          // 用到的表项数，t[0] = x
+    int n_steps;
+    int result;           // 结果所在的表项
+    int n_mul;            // 乘法次数（不含平方）
+    int n_sqr;            // 平方次数
+    fp_exp_step steps[FP_EXP_MAX_STEPS];
+} fp_exp_chain;
+
+// 为指数 e (> 0) 生成加法链，失败（超出表/步数上限）返回 0
+int fp_exp_chain_build(fp_exp_chain *chain, const bigint256 *e);
+
+#endif // FP256_CHAIN_H
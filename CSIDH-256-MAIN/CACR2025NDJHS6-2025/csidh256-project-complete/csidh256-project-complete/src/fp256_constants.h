@@ -0,0 +1,586 @@
+// 由 tools/gen_fp256_constants.c 根据 src/params.h 中的 p 生成，不要手工修改。
+// 重新生成: make src/fp256_constants.h
+#ifndef FP256_CONSTANTS_H
+#define FP256_CONSTANTS_H
+
+// ==================== 模数与Montgomery参数 ====================
+
+// p
+#define FP256_CONST_P \
+    {{ 0x82653CC3EAE4C5EBULL, 0xDC29209CA3618AE5ULL, 0x615B08CD8DD0734BULL, 0x100000000ACA9E2AULL }}
+
+// 2p
+#define FP256_CONST_TWO_P \
+    {{ 0x04CA7987D5C98BD6ULL, 0xB852413946C315CBULL, 0xC2B6119B1BA0E697ULL, 0x2000000015953C54ULL }}
+
+// mont_field（与 mont_field_init 的结果相同）
+#define FP256_CONST_MONT_FIELD { \
+    .p = {{ 0x82653CC3EAE4C5EBULL, 0xDC29209CA3618AE5ULL, 0x615B08CD8DD0734BULL, 0x100000000ACA9E2AULL }}, \
+    .p_inv = {{ 0xFE59CEFFFACDC53DULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL }}, \
+    .r_squared = {{ 0x6D6306098B129180ULL, 0xF964D943FAC4B109ULL, 0x94C7781983FF03B8ULL, 0x0D13310D7B006B8EULL }}, \
+    .redc_type = MONT_REDC_GENERIC, \
+    .pm_k = 0, \
+    .pm_c = 0x0ULL, \
+    .p_squared_x4 = { 0x1102C912FE6E16E4ULL, 0x00D8D54071563FFFULL, 0x517B24CB98823C58ULL, 0xF79034D64C85D7B8ULL, \
+                      0x41921D973FFE40EFULL, 0x92FFD6594FDA63C9ULL, 0x327F574BF7BC97CFULL, 0x0400000005654F15ULL } }
+
+// R = 2^256 mod p（Montgomery域中的1）
+#define FP256_CONST_R_MOD_P \
+    {{ 0x5C1170853C98673BULL, 0x199716D26D48DC8DULL, 0x4BAA7BF4B0C93E8EULL, 0x0FFFFFFF5E20BB84ULL }}
+
+// R^2 = 2^512 mod p（to_mont 的乘数）
+#define FP256_CONST_R_SQUARED_MOD_P \
+    {{ 0x6D6306098B129180ULL, 0xF964D943FAC4B109ULL, 0x94C7781983FF03B8ULL, 0x0D13310D7B006B8EULL }}
+
+// (p - 1) / 2
+#define FP256_CONST_P_MINUS_1_HALVES \
+    {{ 0xC1329E61F57262F5ULL, 0xEE14904E51B0C572ULL, 0x30AD8466C6E839A5ULL, 0x0800000005654F15ULL }}
+
+// (p + 1) / 4
+#define FP256_CONST_P_PLUS_1_QUARTERS \
+    {{ 0x60994F30FAB9317BULL, 0xF70A482728D862B9ULL, 0x9856C23363741CD2ULL, 0x0400000002B2A78AULL }}
+
+// Montgomery形式的小整数：FP256_CONST_MONT_SMALL[k] = k * R mod p
+#define FP256_MONT_SMALL_COUNT 16
+#define FP256_CONST_MONT_SMALL { \
+    {{ 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL }}, \
+    {{ 0x5C1170853C98673BULL, 0x199716D26D48DC8DULL, 0x4BAA7BF4B0C93E8EULL, 0x0FFFFFFF5E20BB84ULL }}, \
+    {{ 0x35BDA4468E4C088BULL, 0x57050D0837302E35ULL, 0x35F9EF1BD3C209D0ULL, 0x0FFFFFFEB176D8DEULL }}, \
+    {{ 0x0F69D807DFFFA9DBULL, 0x9473033E01177FDDULL, 0x20496242F6BAD512ULL, 0x0FFFFFFE04CCF638ULL }}, \
+    {{ 0xE9160BC931B34B2BULL, 0xD1E0F973CAFED184ULL, 0x0A98D56A19B3A054ULL, 0x0FFFFFFD58231392ULL }}, \
+    {{ 0xC2C23F8A8366EC7BULL, 0x0F4EEFA994E6232CULL, 0xF4E848913CAC6B97ULL, 0x0FFFFFFCAB7930EBULL }}, \
+    {{ 0x9C6E734BD51A8DCBULL, 0x4CBCE5DF5ECD74D4ULL, 0xDF37BBB85FA536D9ULL, 0x0FFFFFFBFECF4E45ULL }}, \
+    {{ 0x761AA70D26CE2F1BULL, 0x8A2ADC1528B4C67CULL, 0xC9872EDF829E021BULL, 0x0FFFFFFB52256B9FULL }}, \
+    {{ 0x4FC6DACE7881D06BULL, 0xC798D24AF29C1824ULL, 0xB3D6A206A596CD5DULL, 0x0FFFFFFAA57B88F9ULL }}, \
+    {{ 0x29730E8FCA3571BBULL, 0x0506C880BC8369CCULL, 0x9E26152DC88F98A0ULL, 0x0FFFFFF9F8D1A653ULL }}, \
+    {{ 0x031F42511BE9130BULL, 0x4274BEB6866ABB74ULL, 0x88758854EB8863E2ULL, 0x0FFFFFF94C27C3ADULL }}, \
+    {{ 0xDCCB76126D9CB45BULL, 0x7FE2B4EC50520D1BULL, 0x72C4FB7C0E812F24ULL, 0x0FFFFFF89F7DE107ULL }}, \
+    {{ 0xB677A9D3BF5055ABULL, 0xBD50AB221A395EC3ULL, 0x5D146EA33179FA66ULL, 0x0FFFFFF7F2D3FE61ULL }}, \
+    {{ 0x9023DD951103F6FBULL, 0xFABEA157E420B06BULL, 0x4763E1CA5472C5A8ULL, 0x0FFFFFF7462A1BBBULL }}, \
+    {{ 0x69D0115662B7984BULL, 0x382C978DAE080213ULL, 0x31B354F1776B90EBULL, 0x0FFFFFF699803915ULL }}, \
+    {{ 0x437C4517B46B399BULL, 0x759A8DC377EF53BBULL, 0x1C02C8189A645C2DULL, 0x0FFFFFF5ECD6566FULL }}, \
+}
+
+// Barrett 常数 floor(2^512 / p)（传统模乘后端，src/traditional_mul.c）
+#define FP256_CONST_BARRETT_MU \
+    { 0x79C636C0F0E42B80ULL, 0xD1B46C34A51BA1D9ULL, 0xEC42C730984A1038ULL, 0xFFFFFFF53561D5A5ULL, 0x000000000000000FULL }
+
+// ==================== 公共曲线E ====================
+
+// E = (a, a - d) = (1, 2)，即 y^2 = x^3 + x，Montgomery表示
+#define FP256_CONST_E { \
+    {{ 0x5C1170853C98673BULL, 0x199716D26D48DC8DULL, 0x4BAA7BF4B0C93E8EULL, 0x0FFFFFFF5E20BB84ULL }}, \
+    {{ 0x35BDA4468E4C088BULL, 0x57050D0837302E35ULL, 0x35F9EF1BD3C209D0ULL, 0x0FFFFFFEB176D8DEULL }} }
+
+// ==================== 加法链（fp_inv_fermat / fp_issquare_euler / fp_sqrt）====================
+
+// p - 2：257 次平方 + 64 次乘法
+#define FP256_CONST_CHAIN_INV { \
+    .n_table = 6, .n_steps = 64, .result = 5, .n_mul = 64, .n_sqr = 257, \
+    .steps = { \
+        { 1, 0, 0, 1 }, \
+        { 2, 1, 1, 2 }, \
+        { 3, 1, 0, 1 }, \
+        { 4, 2, 0, 1 }, \
+        { 5, 0, 0, 33 }, \
+        { 5, 5, 0, 2 }, \
+        { 5, 5, 1, 3 }, \
+        { 5, 5, 0, 3 }, \
+        { 5, 5, 0, 2 }, \
+        { 5, 5, 0, 2 }, \
+        { 5, 5, 2, 6 }, \
+        { 5, 5, 0, 4 }, \
+        { 5, 5, 0, 2 }, \
+        { 5, 5, 0, 2 }, \
+        { 5, 5, 1, 4 }, \
+        { 5, 5, 0, 5 }, \
+        { 5, 5, 0, 2 }, \
+        { 5, 5, 1, 3 }, \
+        { 5, 5, 1, 3 }, \
+        { 5, 5, 0, 5 }, \
+        { 5, 5, 1, 5 }, \
+        { 5, 5, 1, 4 }, \
+        { 5, 5, 1, 3 }, \
+        { 5, 5, 1, 5 }, \
+        { 5, 5, 3, 4 }, \
+        { 5, 5, 0, 2 }, \
+        { 5, 5, 3, 8 }, \
+        { 5, 5, 1, 4 }, \
+        { 5, 5, 0, 2 }, \
+        { 5, 5, 0, 3 }, \
+        { 5, 5, 2, 5 }, \
+        { 5, 5, 3, 4 }, \
+        { 5, 5, 0, 5 }, \
+        { 5, 5, 0, 2 }, \
+        { 5, 5, 0, 3 }, \
+        { 5, 5, 0, 3 }, \
+        { 5, 5, 0, 6 }, \
+        { 5, 5, 3, 5 }, \
+        { 5, 5, 0, 3 }, \
+        { 5, 5, 0, 2 }, \
+        { 5, 5, 1, 5 }, \
+        { 5, 5, 1, 3 }, \
+        { 5, 5, 1, 6 }, \
+        { 5, 5, 0, 4 }, \
+        { 5, 5, 0, 2 }, \
+        { 5, 5, 3, 4 }, \
+        { 5, 5, 0, 3 }, \
+        { 5, 5, 1, 3 }, \
+        { 5, 5, 0, 6 }, \
+        { 5, 5, 1, 4 }, \
+        { 5, 5, 0, 3 }, \
+        { 5, 5, 0, 2 }, \
+        { 5, 5, 2, 6 }, \
+        { 5, 5, 1, 4 }, \
+        { 5, 5, 4, 9 }, \
+        { 5, 5, 0, 2 }, \
+        { 5, 5, 0, 2 }, \
+        { 5, 5, 3, 4 }, \
+        { 5, 5, 0, 3 }, \
+        { 5, 5, 1, 4 }, \
+        { 5, 5, 0, 4 }, \
+        { 5, 5, 2, 5 }, \
+        { 5, 5, 0, 2 }, \
+        { 5, 5, 0, 3 }, \
+    } }
+
+// (p - 1) / 2：256 次平方 + 64 次乘法
+#define FP256_CONST_CHAIN_LEGENDRE { \
+    .n_table = 6, .n_steps = 64, .result = 5, .n_mul = 64, .n_sqr = 256, \
+    .steps = { \
+        { 1, 0, 0, 1 }, \
+        { 2, 1, 1, 2 }, \
+        { 3, 1, 0, 1 }, \
+        { 4, 2, 0, 1 }, \
+        { 5, 0, 0, 33 }, \
+        { 5, 5, 0, 2 }, \
+        { 5, 5, 1, 3 }, \
+        { 5, 5, 0, 3 }, \
+        { 5, 5, 0, 2 }, \
+        { 5, 5, 0, 2 }, \
+        { 5, 5, 2, 6 }, \
+        { 5, 5, 0, 4 }, \
+        { 5, 5, 0, 2 }, \
+        { 5, 5, 0, 2 }, \
+        { 5, 5, 1, 4 }, \
+        { 5, 5, 0, 5 }, \
+        { 5, 5, 0, 2 }, \
+        { 5, 5, 1, 3 }, \
+        { 5, 5, 1, 3 }, \
+        { 5, 5, 0, 5 }, \
+        { 5, 5, 1, 5 }, \
+        { 5, 5, 1, 4 }, \
+        { 5, 5, 1, 3 }, \
+        { 5, 5, 1, 5 }, \
+        { 5, 5, 3, 4 }, \
+        { 5, 5, 0, 2 }, \
+        { 5, 5, 3, 8 }, \
+        { 5, 5, 1, 4 }, \
+        { 5, 5, 0, 2 }, \
+        { 5, 5, 0, 3 }, \
+        { 5, 5, 2, 5 }, \
+        { 5, 5, 3, 4 }, \
+        { 5, 5, 0, 5 }, \
+        { 5, 5, 0, 2 }, \
+        { 5, 5, 0, 3 }, \
+        { 5, 5, 0, 3 }, \
+        { 5, 5, 0, 6 }, \
+        { 5, 5, 3, 5 }, \
+        { 5, 5, 0, 3 }, \
+        { 5, 5, 0, 2 }, \
+        { 5, 5, 1, 5 }, \
+        { 5, 5, 1, 3 }, \
+        { 5, 5, 1, 6 }, \
+        { 5, 5, 0, 4 }, \
+        { 5, 5, 0, 2 }, \
+        { 5, 5, 3, 4 }, \
+        { 5, 5, 0, 3 }, \
+        { 5, 5, 1, 3 }, \
+        { 5, 5, 0, 6 }, \
+        { 5, 5, 1, 4 }, \
+        { 5, 5, 0, 3 }, \
+        { 5, 5, 0, 2 }, \
+        { 5, 5, 2, 6 }, \
+        { 5, 5, 1, 4 }, \
+        { 5, 5, 4, 9 }, \
+        { 5, 5, 0, 2 }, \
+        { 5, 5, 0, 2 }, \
+        { 5, 5, 3, 4 }, \
+        { 5, 5, 0, 3 }, \
+        { 5, 5, 1, 4 }, \
+        { 5, 5, 0, 4 }, \
+        { 5, 5, 2, 5 }, \
+        { 5, 5, 0, 2 }, \
+        { 5, 5, 0, 2 }, \
+    } }
+
+// (p + 1) / 4：255 次平方 + 63 次乘法
+#define FP256_CONST_CHAIN_SQRT { \
+    .n_table = 6, .n_steps = 63, .result = 5, .n_mul = 63, .n_sqr = 255, \
+    .steps = { \
+        { 1, 0, 0, 1 }, \
+        { 2, 1, 1, 2 }, \
+        { 3, 1, 0, 1 }, \
+        { 4, 2, 0, 1 }, \
+        { 5, 0, 0, 33 }, \
+        { 5, 5, 0, 2 }, \
+        { 5, 5, 1, 3 }, \
+        { 5, 5, 0, 3 }, \
+        { 5, 5, 0, 2 }, \
+        { 5, 5, 0, 2 }, \
+        { 5, 5, 2, 6 }, \
+        { 5, 5, 0, 4 }, \
+        { 5, 5, 0, 2 }, \
+        { 5, 5, 0, 2 }, \
+        { 5, 5, 1, 4 }, \
+        { 5, 5, 0, 5 }, \
+        { 5, 5, 0, 2 }, \
+        { 5, 5, 1, 3 }, \
+        { 5, 5, 1, 3 }, \
+        { 5, 5, 0, 5 }, \
+        { 5, 5, 1, 5 }, \
+        { 5, 5, 1, 4 }, \
+        { 5, 5, 1, 3 }, \
+        { 5, 5, 1, 5 }, \
+        { 5, 5, 3, 4 }, \
+        { 5, 5, 0, 2 }, \
+        { 5, 5, 3, 8 }, \
+        { 5, 5, 1, 4 }, \
+        { 5, 5, 0, 2 }, \
+        { 5, 5, 0, 3 }, \
+        { 5, 5, 2, 5 }, \
+        { 5, 5, 3, 4 }, \
+        { 5, 5, 0, 5 }, \
+        { 5, 5, 0, 2 }, \
+        { 5, 5, 0, 3 }, \
+        { 5, 5, 0, 3 }, \
+        { 5, 5, 0, 6 }, \
+        { 5, 5, 3, 5 }, \
+        { 5, 5, 0, 3 }, \
+        { 5, 5, 0, 2 }, \
+        { 5, 5, 1, 5 }, \
+        { 5, 5, 1, 3 }, \
+        { 5, 5, 1, 6 }, \
+        { 5, 5, 0, 4 }, \
+        { 5, 5, 0, 2 }, \
+        { 5, 5, 3, 4 }, \
+        { 5, 5, 0, 3 }, \
+        { 5, 5, 1, 3 }, \
+        { 5, 5, 0, 6 }, \
+        { 5, 5, 1, 4 }, \
+        { 5, 5, 0, 3 }, \
+        { 5, 5, 0, 2 }, \
+        { 5, 5, 2, 6 }, \
+        { 5, 5, 1, 4 }, \
+        { 5, 5, 4, 9 }, \
+        { 5, 5, 0, 2 }, \
+        { 5, 5, 0, 2 }, \
+        { 5, 5, 3, 4 }, \
+        { 5, 5, 0, 3 }, \
+        { 5, 5, 1, 4 }, \
+        { 5, 5, 0, 4 }, \
+        { 5, 5, 2, 5 }, \
+        { 5, 5, 1, 3 }, \
+    } }
+
+// ==================== l 次方根（fp_root3 / fp_root5 / fp_root7）====================
+
+// 3^(-1) mod (p - 1)：259 次平方 + 76 次乘法
+#define FP256_CONST_CHAIN_ROOT3 { \
+    .n_table = 7, .n_steps = 76, .result = 6, .n_mul = 76, .n_sqr = 259, \
+    .steps = { \
+        { 1, 0, 0, 1 }, \
+        { 2, 1, 1, 2 }, \
+        { 3, 1, 0, 1 }, \
+        { 4, 2, 0, 1 }, \
+        { 5, 2, 1, 2 }, \
+        { 5, 5, 0, 1 }, \
+        { 6, 0, 0, 2 }, \
+        { 6, 6, 0, 2 }, \
+        { 6, 6, 0, 2 }, \
+        { 6, 6, 0, 2 }, \
+        { 6, 6, 0, 2 }, \
+        { 6, 6, 0, 2 }, \
+        { 6, 6, 0, 2 }, \
+        { 6, 6, 0, 2 }, \
+        { 6, 6, 0, 2 }, \
+        { 6, 6, 0, 2 }, \
+        { 6, 6, 0, 2 }, \
+        { 6, 6, 0, 2 }, \
+        { 6, 6, 0, 2 }, \
+        { 6, 6, 0, 2 }, \
+        { 6, 6, 1, 3 }, \
+        { 6, 6, 3, 6 }, \
+        { 6, 6, 3, 4 }, \
+        { 6, 6, 1, 5 }, \
+        { 6, 6, 0, 2 }, \
+        { 6, 6, 0, 3 }, \
+        { 6, 6, 3, 4 }, \
+        { 6, 6, 1, 5 }, \
+        { 6, 6, 0, 3 }, \
+        { 6, 6, 1, 3 }, \
+        { 6, 6, 2, 7 }, \
+        { 6, 6, 0, 3 }, \
+        { 6, 6, 1, 3 }, \
+        { 6, 6, 0, 5 }, \
+        { 6, 6, 0, 4 }, \
+        { 6, 6, 0, 3 }, \
+        { 6, 6, 0, 5 }, \
+        { 6, 6, 0, 3 }, \
+        { 6, 6, 1, 4 }, \
+        { 6, 6, 0, 2 }, \
+        { 6, 6, 1, 3 }, \
+        { 6, 6, 0, 2 }, \
+        { 6, 6, 0, 4 }, \
+        { 6, 6, 1, 5 }, \
+        { 6, 6, 0, 3 }, \
+        { 6, 6, 0, 2 }, \
+        { 6, 6, 0, 3 }, \
+        { 6, 6, 0, 3 }, \
+        { 6, 6, 1, 3 }, \
+        { 6, 6, 1, 5 }, \
+        { 6, 6, 0, 5 }, \
+        { 6, 6, 0, 2 }, \
+        { 6, 6, 1, 3 }, \
+        { 6, 6, 2, 5 }, \
+        { 6, 6, 3, 4 }, \
+        { 6, 6, 0, 5 }, \
+        { 6, 6, 0, 3 }, \
+        { 6, 6, 0, 6 }, \
+        { 6, 6, 3, 8 }, \
+        { 6, 6, 0, 2 }, \
+        { 6, 6, 3, 7 }, \
+        { 6, 6, 0, 2 }, \
+        { 6, 6, 1, 3 }, \
+        { 6, 6, 0, 4 }, \
+        { 6, 6, 1, 6 }, \
+        { 6, 6, 4, 6 }, \
+        { 6, 6, 3, 4 }, \
+        { 6, 6, 0, 2 }, \
+        { 6, 6, 5, 8 }, \
+        { 6, 6, 2, 7 }, \
+        { 6, 6, 1, 3 }, \
+        { 6, 6, 3, 4 }, \
+        { 6, 6, 1, 3 }, \
+        { 6, 6, 0, 3 }, \
+        { 6, 6, 0, 2 }, \
+        { 6, 6, 3, 6 }, \
+    } }
+
+// 5^(-1) mod (p - 1)：258 次平方 + 69 次乘法
+#define FP256_CONST_CHAIN_ROOT5 { \
+    .n_table = 7, .n_steps = 69, .result = 6, .n_mul = 69, .n_sqr = 258, \
+    .steps = { \
+        { 1, 0, 0, 1 }, \
+        { 2, 1, 1, 2 }, \
+        { 3, 1, 0, 1 }, \
+        { 4, 2, 0, 1 }, \
+        { 5, 2, 1, 2 }, \
+        { 6, 0, 1, 4 }, \
+        { 6, 6, 1, 4 }, \
+        { 6, 6, 1, 4 }, \
+        { 6, 6, 1, 4 }, \
+        { 6, 6, 1, 4 }, \
+        { 6, 6, 1, 4 }, \
+        { 6, 6, 1, 4 }, \
+        { 6, 6, 0, 2 }, \
+        { 6, 6, 0, 9 }, \
+        { 6, 6, 1, 4 }, \
+        { 6, 6, 0, 3 }, \
+        { 6, 6, 0, 2 }, \
+        { 6, 6, 3, 4 }, \
+        { 6, 6, 1, 3 }, \
+        { 6, 6, 1, 4 }, \
+        { 6, 6, 3, 8 }, \
+        { 6, 6, 1, 4 }, \
+        { 6, 6, 1, 3 }, \
+        { 6, 6, 0, 2 }, \
+        { 6, 6, 2, 6 }, \
+        { 6, 6, 3, 4 }, \
+        { 6, 6, 1, 6 }, \
+        { 6, 6, 3, 4 }, \
+        { 6, 6, 1, 3 }, \
+        { 6, 6, 4, 6 }, \
+        { 6, 6, 0, 2 }, \
+        { 6, 6, 0, 4 }, \
+        { 6, 6, 5, 9 }, \
+        { 6, 6, 0, 2 }, \
+        { 6, 6, 0, 3 }, \
+        { 6, 6, 0, 2 }, \
+        { 6, 6, 3, 7 }, \
+        { 6, 6, 0, 3 }, \
+        { 6, 6, 0, 2 }, \
+        { 6, 6, 2, 5 }, \
+        { 6, 6, 4, 7 }, \
+        { 6, 6, 2, 5 }, \
+        { 6, 6, 0, 3 }, \
+        { 6, 6, 0, 2 }, \
+        { 6, 6, 0, 2 }, \
+        { 6, 6, 3, 5 }, \
+        { 6, 6, 0, 2 }, \
+        { 6, 6, 0, 2 }, \
+        { 6, 6, 1, 6 }, \
+        { 6, 6, 0, 2 }, \
+        { 6, 6, 0, 4 }, \
+        { 6, 6, 1, 4 }, \
+        { 6, 6, 1, 3 }, \
+        { 6, 6, 0, 2 }, \
+        { 6, 6, 0, 3 }, \
+        { 6, 6, 0, 2 }, \
+        { 6, 6, 1, 5 }, \
+        { 6, 6, 0, 3 }, \
+        { 6, 6, 0, 3 }, \
+        { 6, 6, 3, 6 }, \
+        { 6, 6, 0, 2 }, \
+        { 6, 6, 1, 3 }, \
+        { 6, 6, 1, 5 }, \
+        { 6, 6, 3, 5 }, \
+        { 6, 6, 4, 6 }, \
+        { 6, 6, 0, 2 }, \
+        { 6, 6, 0, 2 }, \
+        { 6, 6, 4, 7 }, \
+        { 6, 6, 1, 4 }, \
+    } }
+
+// 7^(-1) mod (p - 1)：256 次平方 + 71 次乘法
+#define FP256_CONST_CHAIN_ROOT7 { \
+    .n_table = 6, .n_steps = 71, .result = 5, .n_mul = 71, .n_sqr = 256, \
+    .steps = { \
+        { 1, 0, 0, 1 }, \
+        { 2, 1, 1, 2 }, \
+        { 3, 1, 0, 1 }, \
+        { 4, 2, 0, 1 }, \
+        { 5, 0, 0, 3 }, \
+        { 5, 5, 0, 3 }, \
+        { 5, 5, 0, 3 }, \
+        { 5, 5, 0, 3 }, \
+        { 5, 5, 0, 3 }, \
+        { 5, 5, 0, 3 }, \
+        { 5, 5, 0, 3 }, \
+        { 5, 5, 0, 3 }, \
+        { 5, 5, 0, 3 }, \
+        { 5, 5, 0, 3 }, \
+        { 5, 5, 0, 2 }, \
+        { 5, 5, 0, 2 }, \
+        { 5, 5, 0, 2 }, \
+        { 5, 5, 2, 5 }, \
+        { 5, 5, 3, 5 }, \
+        { 5, 5, 1, 3 }, \
+        { 5, 5, 0, 3 }, \
+        { 5, 5, 0, 2 }, \
+        { 5, 5, 0, 2 }, \
+        { 5, 5, 0, 2 }, \
+        { 5, 5, 0, 2 }, \
+        { 5, 5, 1, 9 }, \
+        { 5, 5, 1, 5 }, \
+        { 5, 5, 0, 3 }, \
+        { 5, 5, 3, 5 }, \
+        { 5, 5, 0, 4 }, \
+        { 5, 5, 1, 3 }, \
+        { 5, 5, 0, 4 }, \
+        { 5, 5, 0, 2 }, \
+        { 5, 5, 0, 4 }, \
+        { 5, 5, 0, 5 }, \
+        { 5, 5, 0, 3 }, \
+        { 5, 5, 1, 3 }, \
+        { 5, 5, 1, 4 }, \
+        { 5, 5, 3, 5 }, \
+        { 5, 5, 0, 2 }, \
+        { 5, 5, 4, 8 }, \
+        { 5, 5, 3, 4 }, \
+        { 5, 5, 3, 5 }, \
+        { 5, 5, 0, 3 }, \
+        { 5, 5, 1, 3 }, \
+        { 5, 5, 2, 5 }, \
+        { 5, 5, 3, 6 }, \
+        { 5, 5, 3, 5 }, \
+        { 5, 5, 1, 5 }, \
+        { 5, 5, 0, 3 }, \
+        { 5, 5, 0, 2 }, \
+        { 5, 5, 1, 8 }, \
+        { 5, 5, 3, 6 }, \
+        { 5, 5, 0, 2 }, \
+        { 5, 5, 0, 9 }, \
+        { 5, 5, 0, 2 }, \
+        { 5, 5, 2, 5 }, \
+        { 5, 5, 1, 4 }, \
+        { 5, 5, 0, 2 }, \
+        { 5, 5, 2, 5 }, \
+        { 5, 5, 3, 4 }, \
+        { 5, 5, 1, 3 }, \
+        { 5, 5, 0, 2 }, \
+        { 5, 5, 0, 2 }, \
+        { 5, 5, 0, 2 }, \
+        { 5, 5, 1, 3 }, \
+        { 5, 5, 0, 3 }, \
+        { 5, 5, 2, 5 }, \
+        { 5, 5, 2, 5 }, \
+        { 5, 5, 1, 3 }, \
+        { 5, 5, 2, 6 }, \
+    } }
+
+// ==================== safegcd ====================
+
+// p 的有符号62位字表示
+#define FP256_CONST_SAFEGCD_MODULUS62 \
+    {{ 172610972880782827LL, 3505069838513351574LL, 1562903933746623677LL, 11587259032LL, 16LL }}
+
+// p^(-1) mod 2^62
+#define FP256_CONST_SAFEGCD_MODULUS_INV62 0x01A6310005323AC3ULL
+
+// R^3 mod p（普通表示）
+#define FP256_CONST_SAFEGCD_R_CUBED \
+    {{ 0xB0F47337F5FF44F7ULL, 0x59CFBC9FF10B0B0CULL, 0x9DC0BE9238450D8CULL, 0x03444E6A492C6E73ULL }}
+
+// ==================== 多缓冲（2^52进制，5个字）====================
+
+// p
+#define FP256_CONST_MB_P52 \
+    { 0x00053CC3EAE4C5EBULL, 0x0009CA3618AE5826ULL, 0x000DD0734BDC2920ULL, 0x0009E2A615B08CD8ULL, 0x0000100000000ACAULL }
+
+// 2p
+#define FP256_CONST_MB_2P52 \
+    { 0x000A7987D5C98BD6ULL, 0x0003946C315CB04CULL, 0x000BA0E697B85241ULL, 0x0003C54C2B6119B1ULL, 0x0000200000001595ULL }
+
+// -p^(-1) mod 2^52
+#define FP256_CONST_MB_PINV52 0x9CEFFFACDC53DULL
+
+// 2^260 mod p（多缓冲Montgomery域中的1）
+#define FP256_CONST_MB_POW2_260 \
+    { 0x000878D9061EDAEBULL, 0x000F941D6A5631D2ULL, 0x000D5D276FB30883ULL, 0x00073C906523B3FBULL, 0x00000FFFFFF5402CULL }
+
+// 2^264 mod p（Montgomery标量表示 -> 多缓冲表示）
+#define FP256_CONST_MB_POW2_264 \
+    { 0x0008FE159E8615EBULL, 0x000668AB332BF2E9ULL, 0x00069BB5894A1F56ULL, 0x000F814B0CE2FF08ULL, 0x00000FFFFF5360E7ULL }
+
+// 2^520 mod p（传统标量表示 -> 多缓冲表示）
+#define FP256_CONST_MB_POW2_520 \
+    { 0x000F6D984DCBEB25ULL, 0x00019620EA40DEE5ULL, 0x0007D5980AA745A4ULL, 0x0006DFB4C25E9B33ULL, 0x000003310D723100ULL }
+
+// 2^256 mod p（多缓冲表示 -> Montgomery标量表示）
+#define FP256_CONST_MB_POW2_256 \
+    { 0x000170853C98673BULL, 0x000D26D48DC8D5C1ULL, 0x0000C93E8E199716ULL, 0x000BB844BAA7BF4BULL, 0x00000FFFFFFF5E20ULL }
+
+// 1（多缓冲表示 -> 传统标量表示）
+#define FP256_CONST_MB_POW2_0 \
+    { 0x0000000000000001ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL }
+
+// ==================== 汇编后端（src/fp256.S 的 .quad 列表）====================
+
+// p
+#define FP256_ASM_P \
+    0x82653cc3eae4c5eb, 0xdc29209ca3618ae5, 0x615b08cd8dd0734b, 0x100000000aca9e2a
+
+// 2p
+#define FP256_ASM_2P \
+    0x04ca7987d5c98bd6, 0xb852413946c315cb, 0xc2b6119b1ba0e697, 0x2000000015953c54
+
+// 4p^2
+#define FP256_ASM_4P2 \
+    0x1102c912fe6e16e4, 0x00d8d54071563fff, 0x517b24cb98823c58, 0xf79034d64c85d7b8, 0x41921d973ffe40ef, 0x92ffd6594fda63c9, 0x327f574bf7bc97cf, 0x0400000005654f15
+
+// -p^(-1) mod 2^64
+#define FP256_ASM_PINV \
+    0xfe59cefffacdc53d
+
+#endif // FP256_CONSTANTS_H
@@ -0,0 +1,238 @@
+// 多缓冲域运算模板（由 src/edwards256_mb.c 以 MB_LANES = 4 / 8 各包含一次）
+//
+// 每个 mbfp 同时保存 MB_LANES 个互相独立的域元素：5个 2^52 进制的字，
+// 第 k 个字的第 j 个通道属于第 j 个元素（SoA布局），一条 AVX-512 IFMA
+// 指令（vpmadd52luq / vpmadd52huq）同时完成所有通道的 52x52 位乘加。
+//
+// 表示：Montgomery域，R' = 2^260；所有存储的值都在 [0, 2p) 内且每个字 < 2^52
+// （IFMA 只读取输入的低52位，所以乘法输入必须是规范的52位字）。
+// 4p < 2^260，所以乘法输出不需要最后的条件减法就在 [0, 2p) 内。
+//
+// 包含前需要定义：
+//   MB_LANES        通道数（4 或 8）
+//   MB_NAME(x)      给函数/类型名加上通道数后缀
+// 以及 edwards256_mb.c 中的常量 mb_p52 / mb_2p52 / mb_pinv52 / mb_one52 / mb_to_c52 / mb_from_c52
+
+#ifndef MB_LANES
+#error "fp256_mb_impl.h: MB_LANES must be defined"
+#endif
+
+#define MB_NLIMBS 5
+#define MB_MASK52 ((1ULL << 52) - 1)
+
+typedef uint64_t MB_NAME(u64v) __attribute__((vector_size(8 * MB_LANES)));
+typedef int64_t MB_NAME(s64v) __attribute__((vector_size(8 * MB_LANES)));
+#define u64v MB_NAME(u64v)
+#define s64v MB_NAME(s64v)
+
+typedef struct {
+    u64v l[MB_NLIMBS];
+} MB_NAME(mbfp);
+#define mbfp MB_NAME(mbfp)
+
+#if MB_LANES == 8
+#define MB_MADD52LO(z, x, y) ((u64v)_mm512_madd52lo_epu64((__m512i)(z), (__m512i)(x), (__m512i)(y)))
+#define MB_MADD52HI(z, x, y) ((u64v)_mm512_madd52hi_epu64((__m512i)(z), (__m512i)(x), (__m512i)(y)))
+#else
+#define MB_MADD52LO(z, x, y) ((u64v)_mm256_madd52lo_epu64((__m256i)(z), (__m256i)(x), (__m256i)(y)))
+#define MB_MADD52HI(z, x, y) ((u64v)_mm256_madd52hi_epu64((__m256i)(z), (__m256i)(x), (__m256i)(y)))
+#endif
+
+static inline u64v MB_NAME(mb_bcast)(uint64_t x) {
+    u64v v = {0};
+    return v + x;
+}
+#define mb_bcast MB_NAME(mb_bcast)
+
+// 任一通道的掩码非0
+static inline int MB_NAME(mb_any)(u64v mask) {
+    uint64_t acc = 0;
+    for (int j = 0; j < MB_LANES; j++) {
+        acc |= mask[j];
+    }
+    return acc != 0;
+}
+#define mb_any MB_NAME(mb_any)
+
+static inline void MB_NAME(mbfp_set)(mbfp *c, const uint64_t x[MB_NLIMBS]) {
+    for (int k = 0; k < MB_NLIMBS; k++) {
+        c->l[k] = mb_bcast(x[k]);
+    }
+}
+#define mbfp_set MB_NAME(mbfp_set)
+
+static inline void MB_NAME(mbfp_zero)(mbfp *c) {
+    for (int k = 0; k < MB_NLIMBS; k++) {
+        c->l[k] = mb_bcast(0);
+    }
+}
+#define mbfp_zero MB_NAME(mbfp_zero)
+
+// 规范的52位字，值 < 2q 时条件减去 q（q = p 或 2p），常量时间
+static inline void MB_NAME(mbfp_csub)(u64v t[MB_NLIMBS], const uint64_t q[MB_NLIMBS]) {
+    u64v d[MB_NLIMBS];
+    s64v borrow = {0};
+    for (int k = 0; k < MB_NLIMBS; k++) {
+        s64v x = (s64v)t[k] - (int64_t)q[k] + borrow;
+        d[k] = (u64v)x & MB_MASK52;
+        borrow = x >> 52;
+    }
+    // borrow = -1：t < q，保留 t
+    u64v keep = (u64v)borrow;
+    for (int k = 0; k < MB_NLIMBS; k++) {
+        t[k] = (t[k] & keep) | (d[k] & ~keep);
+    }
+}
+#define mbfp_csub MB_NAME(mbfp_csub)
+
+static inline void MB_NAME(mbfp_add)(mbfp *c, const mbfp *a, const mbfp *b) {
+    u64v t[MB_NLIMBS];
+    u64v carry = {0};
+    for (int k = 0; k < MB_NLIMBS - 1; k++) {
+        t[k] = a->l[k] + b->l[k] + carry;
+        carry = t[k] >> 52;
+        t[k] &= MB_MASK52;
+    }
+    // a + b < 4p < 2^255，最高字不会溢出52位之外的部分
+    t[MB_NLIMBS - 1] = a->l[MB_NLIMBS - 1] + b->l[MB_NLIMBS - 1] + carry;
+    mbfp_csub(t, mb_2p52);
+    for (int k = 0; k < MB_NLIMBS; k++) {
+        c->l[k] = t[k];
+    }
+}
+#define mbfp_add MB_NAME(mbfp_add)
+
+// c = a - b + 2p，再条件减 2p
+static inline void MB_NAME(mbfp_sub)(mbfp *c, const mbfp *a, const mbfp *b) {
+    u64v t[MB_NLIMBS];
+    s64v carry = {0};
+    for (int k = 0; k < MB_NLIMBS - 1; k++) {
+        s64v x = (s64v)a->l[k] - (s64v)b->l[k] + (int64_t)mb_2p52[k] + carry;
+        t[k] = (u64v)x & MB_MASK52;
+        carry = x >> 52;
+    }
+    // b < 2p，结果为正
+    t[MB_NLIMBS - 1] = (u64v)((s64v)a->l[MB_NLIMBS - 1] - (s64v)b->l[MB_NLIMBS - 1]
+                              + (int64_t)mb_2p52[MB_NLIMBS - 1] + carry);
+    mbfp_csub(t, mb_2p52);
+    for (int k = 0; k < MB_NLIMBS; k++) {
+        c->l[k] = t[k];
+    }
+}
+#define mbfp_sub MB_NAME(mbfp_sub)
+
+// Montgomery乘法 c = a * b / 2^260（逐字扫描，每轮用 IFMA 累加低/高52位，最后统一进位）
+static inline void MB_NAME(mbfp_mul)(mbfp *c, const mbfp *a, const mbfp *b) {
+    const u64v zero = {0};
+    u64v t[MB_NLIMBS + 1];
+    for (int k = 0; k <= MB_NLIMBS; k++) {
+        t[k] = zero;
+    }
+
+    for (int i = 0; i < MB_NLIMBS; i++) {
+        u64v ai = a->l[i];
+        for (int k = 0; k < MB_NLIMBS; k++) {
+            t[k] = MB_MADD52LO(t[k], ai, b->l[k]);
+            t[k + 1] = MB_MADD52HI(t[k + 1], ai, b->l[k]);
+        }
+        // m = t[0] * (-p^-1) mod 2^52，加上 m*p 后 t[0] 的低52位为0
+        u64v m = MB_MADD52LO(zero, t[0], mb_bcast(mb_pinv52));
+        for (int k = 0; k < MB_NLIMBS; k++) {
+            u64v pk = mb_bcast(mb_p52[k]);
+            t[k] = MB_MADD52LO(t[k], m, pk);
+            t[k + 1] = MB_MADD52HI(t[k + 1], m, pk);
+        }
+        t[1] += t[0] >> 52;
+        for (int k = 0; k < MB_NLIMBS; k++) {
+            t[k] = t[k + 1];
+        }
+        t[MB_NLIMBS] = zero;
+    }
+
+    for (int k = 0; k < MB_NLIMBS - 1; k++) {
+        t[k + 1] += t[k] >> 52;
+        c->l[k] = t[k] & MB_MASK52;
+    }
+    c->l[MB_NLIMBS - 1] = t[MB_NLIMBS - 1];
+}
+#define mbfp_mul MB_NAME(mbfp_mul)
+
+static inline void MB_NAME(mbfp_sqr)(mbfp *c, const mbfp *a) {
+    mbfp_mul(c, a, a);
+}
+#define mbfp_sqr MB_NAME(mbfp_sqr)
+
+static inline void MB_NAME(mbfp_cswap)(mbfp *x, mbfp *y, u64v mask) {
+    for (int k = 0; k < MB_NLIMBS; k++) {
+        u64v t = (x->l[k] ^ y->l[k]) & mask;
+        x->l[k] ^= t;
+        y->l[k] ^= t;
+    }
+}
+#define mbfp_cswap MB_NAME(mbfp_cswap)
+
+// mask 为全1的通道取 a，其余取 b
+static inline void MB_NAME(mbfp_select)(mbfp *c, const mbfp *a, const mbfp *b, u64v mask) {
+    for (int k = 0; k < MB_NLIMBS; k++) {
+        c->l[k] = (a->l[k] & mask) | (b->l[k] & ~mask);
+    }
+}
+#define mbfp_select MB_NAME(mbfp_select)
+
+// 值为0的通道返回全1掩码
+static inline u64v MB_NAME(mbfp_iszero)(const mbfp *a) {
+    u64v t[MB_NLIMBS];
+    for (int k = 0; k < MB_NLIMBS; k++) {
+        t[k] = a->l[k];
+    }
+    mbfp_csub(t, mb_p52);
+    u64v acc = t[0] | t[1] | t[2] | t[3] | t[4];
+    return (u64v)(acc == 0);
+}
+#define mbfp_iszero MB_NAME(mbfp_iszero)
+
+// 标量fp（fp256后端的表示，< p）与多缓冲表示之间的转换：乘常量后做一次Montgomery约简
+static inline void MB_NAME(mbfp_set_lane)(mbfp *c, int lane, const fp *x) {
+    uint64_t w[MB_NLIMBS];
+    mb_split52(w, x);
+    for (int k = 0; k < MB_NLIMBS; k++) {
+        c->l[k][lane] = w[k];
+    }
+}
+#define mbfp_set_lane MB_NAME(mbfp_set_lane)
+
+static inline void MB_NAME(mbfp_to_mb)(mbfp *c) {
+    mbfp k;
+    mbfp_set(&k, mb_to_c52);
+    mbfp_mul(c, c, &k);
+}
+#define mbfp_to_mb MB_NAME(mbfp_to_mb)
+
+// 转回标量表示（结果 < p）
+static inline void MB_NAME(mbfp_from_mb)(fp out[MB_LANES], const mbfp *a) {
+    mbfp k, t;
+    mbfp_set(&k, mb_from_c52);
+    mbfp_mul(&t, a, &k);
+    mbfp_csub(t.l, mb_p52);
+    for (int j = 0; j < MB_LANES; j++) {
+        uint64_t w[MB_NLIMBS];
+        for (int k2 = 0; k2 < MB_NLIMBS; k2++) {
+            w[k2] = t.l[k2][j];
+        }
+        mb_join52(&out[j], w);
+    }
+}
+#define mbfp_from_mb MB_NAME(mbfp_from_mb)
+
+// 平方判定：转回标量表示后逐通道调用 fp_issquare，与标量实现的语义完全一致
+// （每次 elligator 只调用一次，开销远小于群作用本身）
+static inline u64v MB_NAME(mbfp_issquare)(const mbfp *a) {
+    fp x[MB_LANES];
+    u64v mask = {0};
+    mbfp_from_mb(x, a);
+    for (int j = 0; j < MB_LANES; j++) {
+        mask[j] = -(uint64_t)(fp_issquare(&x[j]) & 1);
+    }
+    return mask;
+}
+#define mbfp_issquare MB_NAME(mbfp_issquare)
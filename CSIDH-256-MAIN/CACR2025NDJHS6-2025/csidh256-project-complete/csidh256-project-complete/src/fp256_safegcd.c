@@ -0,0 +1,269 @@
+#include "fp256_safegcd.h"
+#include "fp256.h"
+
+// 参考：Bernstein, Yang, "Fast constant-time gcd computation and modular inversion"
+// 以及 libsecp256k1 modinv64 的62位有符号字实现。
+
+#define M62 (UINT64_MAX >> 2)
+
+// 256位整数的有符号62位字表示：值 = sum v[i] * 2^(62*i)，v[0..3] 在 [0, 2^62)
+typedef struct {
+    int64_t v[5];
+} signed62;
+
+// 62步divstep的变换矩阵（放大 2^62 倍）
+typedef struct {
+    int64_t u, v, q, r;
+} trans2x2;
+
+// 模数相关常量（构建时生成，见 fp256_constants.h）
+static const signed62 modulus62 = FP256_CONST_SAFEGCD_MODULUS62;
+static const uint64_t modulus_inv62 = FP256_CONST_SAFEGCD_MODULUS_INV62;  // p^(-1) mod 2^62
+static const bigint256 r_cubed = FP256_CONST_SAFEGCD_R_CUBED;  // R^3 mod p（普通表示），把 (xR)^(-1) 变回 x^(-1)R
+
+static void to_signed62(signed62 *r, const bigint256 *a) {
+    const uint64_t *l = a->limbs;
+    r->v[0] = (int64_t)(l[0] & M62);
+    r->v[1] = (int64_t)(((l[0] >> 62) | (l[1] << 2)) & M62);
+    r->v[2] = (int64_t)(((l[1] >> 60) | (l[2] << 4)) & M62);
+    r->v[3] = (int64_t)(((l[2] >> 58) | (l[3] << 6)) & M62);
+    r->v[4] = (int64_t)(l[3] >> 56);
+}
+
+// 要求 a 已规约到 [0, 2^256)
+static void from_signed62(bigint256 *r, const signed62 *a) {
+    const uint64_t v0 = (uint64_t)a->v[0], v1 = (uint64_t)a->v[1], v2 = (uint64_t)a->v[2];
+    const uint64_t v3 = (uint64_t)a->v[3], v4 = (uint64_t)a->v[4];
+    r->limbs[0] = v0 | (v1 << 62);
+    r->limbs[1] = (v1 >> 2) | (v2 << 60);
+    r->limbs[2] = (v2 >> 4) | (v3 << 58);
+    r->limbs[3] = (v3 >> 6) | (v4 << 56);
+}
+
+// ==================== 模逆：常量时间divsteps ====================
+
+// 59步divstep（zeta = -(delta + 1/2)），矩阵初值 8 = 2^3，59步后放大 2^62 倍。
+// 分支全部换成掩码，执行路径与输入无关。
+static int64_t divsteps_59(int64_t zeta, uint64_t f0, uint64_t g0, trans2x2 *t) {
+    uint64_t u = 8, v = 0, q = 0, r = 8;
+    uint64_t c1, c2, mask1, mask2, f = f0, g = g0, x, y, z;
+
+    for (int i = 3; i < 62; i++) {
+        c1 = (uint64_t)(zeta >> 63);
+        mask1 = c1;
+        c2 = g & 1;
+        mask2 = -c2;
+        // zeta < 0 时先取 -f（及对应的 -u, -v）
+        x = (f ^ mask1) - mask1;
+        y = (u ^ mask1) - mask1;
+        z = (v ^ mask1) - mask1;
+        // g 为奇数时 g += x
+        g += x & mask2;
+        q += y & mask2;
+        r += z & mask2;
+        // 两个条件都满足时交换：f += g 得到原来的 g
+        mask1 &= mask2;
+        zeta = (zeta ^ (int64_t)mask1) - 1;
+        f += g & mask1;
+        u += q & mask1;
+        v += r & mask1;
+        g >>= 1;
+        u <<= 1;
+        v <<= 1;
+    }
+
+    t->u = (int64_t)u;
+    t->v = (int64_t)v;
+    t->q = (int64_t)q;
+    t->r = (int64_t)r;
+    return zeta;
+}
+
+// [d, e] <- t * [d, e] / 2^62 (mod p)，d, e 保持在 (-2p, p)
+static void update_de_62(signed62 *d, signed62 *e, const trans2x2 *t) {
+    const int64_t u = t->u, v = t->v, q = t->q, r = t->r;
+    int64_t md, me, sd, se;
+    __int128 cd, ce;
+
+    // d 为负时加上 u（及 q），e 为负时加上 v（及 r），保证结果非负方向的范围
+    sd = d->v[4] >> 63;
+    se = e->v[4] >> 63;
+    md = (u & sd) + (v & se);
+    me = (q & sd) + (r & se);
+
+    cd = (__int128)u * d->v[0] + (__int128)v * e->v[0];
+    ce = (__int128)q * d->v[0] + (__int128)r * e->v[0];
+
+    // 选择 md, me 使 t*[d,e] + p*[md,me] 的低62位为 0
+    md -= (int64_t)((modulus_inv62 * (uint64_t)cd + (uint64_t)md) & M62);
+    me -= (int64_t)((modulus_inv62 * (uint64_t)ce + (uint64_t)me) & M62);
+
+    cd += (__int128)modulus62.v[0] * md;
+    ce += (__int128)modulus62.v[0] * me;
+    cd >>= 62;
+    ce >>= 62;
+
+    for (int i = 1; i < 5; i++) {
+        cd += (__int128)u * d->v[i] + (__int128)v * e->v[i];
+        ce += (__int128)q * d->v[i] + (__int128)r * e->v[i];
+        cd += (__int128)modulus62.v[i] * md;
+        ce += (__int128)modulus62.v[i] * me;
+        d->v[i - 1] = (int64_t)((uint64_t)cd & M62);
+        e->v[i - 1] = (int64_t)((uint64_t)ce & M62);
+        cd >>= 62;
+        ce >>= 62;
+    }
+    d->v[4] = (int64_t)cd;
+    e->v[4] = (int64_t)ce;
+}
+
+// [f, g] <- t * [f, g] / 2^62（精确除法）
+static void update_fg_62(signed62 *f, signed62 *g, const trans2x2 *t) {
+    const int64_t u = t->u, v = t->v, q = t->q, r = t->r;
+    __int128 cf, cg;
+
+    cf = (__int128)u * f->v[0] + (__int128)v * g->v[0];
+    cg = (__int128)q * f->v[0] + (__int128)r * g->v[0];
+    cf >>= 62;
+    cg >>= 62;
+
+    for (int i = 1; i < 5; i++) {
+        cf += (__int128)u * f->v[i] + (__int128)v * g->v[i];
+        cg += (__int128)q * f->v[i] + (__int128)r * g->v[i];
+        f->v[i - 1] = (int64_t)((uint64_t)cf & M62);
+        g->v[i - 1] = (int64_t)((uint64_t)cg & M62);
+        cf >>= 62;
+        cg >>= 62;
+    }
+    f->v[4] = (int64_t)cf;
+    g->v[4] = (int64_t)cg;
+}
+
+// r in (-2p, p) -> [0, p)，sign 为负时同时取反
+static void normalize_62(signed62 *r, int64_t sign) {
+    int64_t r0 = r->v[0], r1 = r->v[1], r2 = r->v[2], r3 = r->v[3], r4 = r->v[4];
+    int64_t cond_add, cond_negate;
+
+    // 为负时加一次 p，然后按需要取反
+    cond_add = r4 >> 63;
+    r0 += modulus62.v[0] & cond_add;
+    r1 += modulus62.v[1] & cond_add;
+    r2 += modulus62.v[2] & cond_add;
+    r3 += modulus62.v[3] & cond_add;
+    r4 += modulus62.v[4] & cond_add;
+    cond_negate = sign >> 63;
+    r0 = (r0 ^ cond_negate) - cond_negate;
+    r1 = (r1 ^ cond_negate) - cond_negate;
+    r2 = (r2 ^ cond_negate) - cond_negate;
+    r3 = (r3 ^ cond_negate) - cond_negate;
+    r4 = (r4 ^ cond_negate) - cond_negate;
+    r1 += r0 >> 62; r0 &= M62;
+    r2 += r1 >> 62; r1 &= M62;
+    r3 += r2 >> 62; r2 &= M62;
+    r4 += r3 >> 62; r3 &= M62;
+
+    // 仍为负时再加一次 p
+    cond_add = r4 >> 63;
+    r0 += modulus62.v[0] & cond_add;
+    r1 += modulus62.v[1] & cond_add;
+    r2 += modulus62.v[2] & cond_add;
+    r3 += modulus62.v[3] & cond_add;
+    r4 += modulus62.v[4] & cond_add;
+    r1 += r0 >> 62; r0 &= M62;
+    r2 += r1 >> 62; r1 &= M62;
+    r3 += r2 >> 62; r2 &= M62;
+    r4 += r3 >> 62; r3 &= M62;
+
+    r->v[0] = r0;
+    r->v[1] = r1;
+    r->v[2] = r2;
+    r->v[3] = r3;
+    r->v[4] = r4;
+}
+
+void fp_inv_safegcd(bigint256 *x) {
+    signed62 d = {{0, 0, 0, 0, 0}};
+    signed62 e = {{1, 0, 0, 0, 0}};
+    signed62 f = modulus62;
+    signed62 g;
+    int64_t zeta = -1;
+
+    to_signed62(&g, x);
+
+    // 256位输入最多需要590步divstep（Bernstein–Yang 的界，按 safegcd-bounds 对 256 位输入证明）：10批 x 59步
+    for (int i = 0; i < 10; i++) {
+        trans2x2 t;
+        zeta = divsteps_59(zeta, (uint64_t)f.v[0], (uint64_t)g.v[0], &t);
+        update_de_62(&d, &e, &t);
+        update_fg_62(&f, &g, &t);
+    }
+
+    // 此时 g = 0，f = ±gcd；d * x = f (mod p)
+    normalize_62(&d, f.v[4]);
+    from_signed62(x, &d);
+
+    // x 是 aR，上面得到 (aR)^(-1) = a^(-1) R^(-1)；乘 R^3（Montgomery乘法再除一次R）得到 a^(-1) R。
+    // 传统模乘的普通表示不需要这一步
+    if (fp_is_montgomery()) {
+        fp_mul(x, x, &r_cubed);
+    }
+}
+
+// ==================== Jacobi符号：常量时间二进制GCD ====================
+
+// Pornin, "Optimized Binary GCD for Modular Inversion"：a 为奇数时若 a < b 先交换（互反律），
+// 再令 a -= b；然后 a /= 2（乘上 (2/b)）。a, b 始终非负、b 始终为奇数，
+// 只需 a, b 的最低3位就能跟踪符号。每轮 len(a) + len(b) 至少减1（a 为偶数时 a 减半，
+// 否则较大的一个换成差的一半），从 a < 2^256、b = p < 2^256 出发，
+// 2*256 - 1 轮后必有 a = 0、b = gcd(x, p)。轮数固定，分支全部换成掩码。
+#define JACOBI_ITERATIONS (2 * 256 - 1)
+
+static const bigint256 modulus = FP256_CONST_P;
+
+int fp_jacobi_bingcd(const bigint256 *x) {
+    uint64_t a[4], b[4], j = 0;
+
+    for (int i = 0; i < 4; i++) {
+        a[i] = x->limbs[i];
+        b[i] = modulus.limbs[i];
+    }
+
+    for (int it = 0; it < JACOBI_ITERATIONS; it++) {
+        uint64_t odd = -(a[0] & 1);
+        uint64_t d[4], borrow = 0;
+
+        // d = a - b，借位即 a < b
+        for (int i = 0; i < 4; i++) {
+            uint64_t t = a[i] - b[i];
+            uint64_t b1 = (uint64_t)(a[i] < b[i]);
+            d[i] = t - borrow;
+            borrow = b1 | (uint64_t)(t < borrow);
+        }
+        uint64_t lt = -borrow;
+        uint64_t swap = odd & lt;
+
+        // 互反律：a = b = 3 (mod 4) 时变号
+        j ^= ((a[0] & b[0]) >> 1) & swap;
+
+        // 交换时 b <- a；a 为奇数时 a <- |a - b|（交换后的 a - b 就是 -d）
+        uint64_t carry = lt & 1;
+        for (int i = 0; i < 4; i++) {
+            b[i] ^= (a[i] ^ b[i]) & swap;
+            uint64_t n = (d[i] ^ lt) + carry;
+            carry = (uint64_t)(n < carry);
+            a[i] ^= (a[i] ^ n) & odd;
+        }
+
+        // a /= 2；(2/b) = -1 当且仅当 b = 3, 5 (mod 8)
+        a[0] = (a[0] >> 1) | (a[1] << 63);
+        a[1] = (a[1] >> 1) | (a[2] << 63);
+        a[2] = (a[2] >> 1) | (a[3] << 63);
+        a[3] >>= 1;
+        j ^= (b[0] >> 1) ^ (b[0] >> 2);
+    }
+
+    // 此时 b = gcd(x, p)：gcd = 1 时结果为 (-1)^j，否则为 0
+    uint64_t not_one = (b[0] ^ 1) | b[1] | b[2] | b[3];
+    int64_t is_one = (int64_t)(1 ^ ((not_one | -not_one) >> 63));
+    return (int)(is_one * (1 - 2 * (int64_t)(j & 1)));
+}
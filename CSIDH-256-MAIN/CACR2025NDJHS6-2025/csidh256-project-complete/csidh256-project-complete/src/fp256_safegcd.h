@@ -0,0 +1,21 @@
+#ifndef FP256_SAFEGCD_H
+#define FP256_SAFEGCD_H
+
+#include "params.h"
+#include <stdint.h>
+
+// ==================== safegcd（Bernstein–Yang divsteps）====================
+// 常量时间的模逆，内部用5个62位有符号字表示256位整数，
+// 每批59步divstep只操作最低64位，得到2x2变换矩阵后再一次性更新整个数。
+// Jacobi符号用常量时间二进制GCD（Pornin），同样有证明的固定轮数。
+// 与费马幂运算（fp_inv_fermat / fp_issquare_euler）二选一，
+// 由 fp_inv / fp_issquare 按编译选项 FP256_INV_FERMAT 调用。
+
+// x <- x^(-1)（Montgomery域），x = 0 时结果为 0
+void fp_inv_safegcd(bigint256 *x);
+
+// Jacobi符号 (x/p)，x < p，可以是Montgomery表示（R = 2^256 是平方数，不影响结果）
+// 返回 1、-1 或 0
+int fp_jacobi_bingcd(const bigint256 *x);
+
+#endif // FP256_SAFEGCD_H
@@ -52,20 +52,130 @@ static void bigint_mul_512_optimized(uint64_t *result, const bigint256 *a, const
     }
 }
 
+// 平方：交叉项 a_i*a_j (i<j) 只计算一次再整体左移一位，加上对角项 a_i^2
+// 共 6 + 4 = 10 次字乘法（一般乘法需要 16 次），完全展开
+static void bigint_sqr_512(uint64_t *result, const bigint256 *a) {
+    const uint64_t a0 = a->limbs[0], a1 = a->limbs[1];
+    const uint64_t a2 = a->limbs[2], a3 = a->limbs[3];
+    uint64_t r1, r2, r3, r4, r5, r6, r7;
+    __uint128_t t, sq;
+    
+    // 交叉项
+    t = (__uint128_t)a0 * a1;            r1 = (uint64_t)t; t >>= 64;
+    t += (__uint128_t)a0 * a2;           r2 = (uint64_t)t; t >>= 64;
+    t += (__uint128_t)a0 * a3;           r3 = (uint64_t)t; r4 = (uint64_t)(t >> 64);
+    t = (__uint128_t)a1 * a2 + r3;       r3 = (uint64_t)t; t >>= 64;
+    t += (__uint128_t)a1 * a3 + r4;      r4 = (uint64_t)t; r5 = (uint64_t)(t >> 64);
+    t = (__uint128_t)a2 * a3 + r5;       r5 = (uint64_t)t; r6 = (uint64_t)(t >> 64);
+    
+    // 交叉项乘2
+    r7 = r6 >> 63;
+    r6 = (r6 << 1) | (r5 >> 63);
+    r5 = (r5 << 1) | (r4 >> 63);
+    r4 = (r4 << 1) | (r3 >> 63);
+    r3 = (r3 << 1) | (r2 >> 63);
+    r2 = (r2 << 1) | (r1 >> 63);
+    r1 = r1 << 1;
+    
+    // 对角项
+    sq = (__uint128_t)a0 * a0;
+    result[0] = (uint64_t)sq;
+    t = (sq >> 64) + r1;                 result[1] = (uint64_t)t; t >>= 64;
+    sq = (__uint128_t)a1 * a1;
+    t += (uint64_t)sq + (__uint128_t)r2; result[2] = (uint64_t)t; t >>= 64;
+    t += (sq >> 64) + r3;                result[3] = (uint64_t)t; t >>= 64;
+    sq = (__uint128_t)a2 * a2;
+    t += (uint64_t)sq + (__uint128_t)r4; result[4] = (uint64_t)t; t >>= 64;
+    t += (sq >> 64) + r5;                result[5] = (uint64_t)t; t >>= 64;
+    sq = (__uint128_t)a3 * a3;
+    t += (uint64_t)sq + (__uint128_t)r6; result[6] = (uint64_t)t; t >>= 64;
+    t += (sq >> 64) + r7;                result[7] = (uint64_t)t;
+}
+
 // 保留原函数用于其他地方
 static void bigint_mul_512(uint64_t *result, const bigint256 *a, const bigint256 *b) {
     bigint_mul_512_optimized(result, a, b);
 }
 
+// ==================== 伪梅森素数约简（p = 2^k - c）====================
+
+// Montgomery约简的每一轮都要加上 m*p。当 p = 2^k - c 时
+//   m*p = (m << k) - m*c
+// 只需要移位加法和一次与小常数 c 的乘法，不再与 p 的4个字逐一相乘。
+// 按列（product scanning）累加，有符号128位累加器吸收减法的借位：
+//   第 j 列 = T[j] + lo(m_{j-3} << k') + hi(m_{j-4} << k') - lo(m_j*c) - hi(m_{j-1}*c)
+// 其中 k' = k - 192。-p^-1 = c^-1 mod 2^64，对当前 p = 2^253 - 1 有 c = 1，m_j 就是第 j 列。
+// 结果与通用约简完全相同（仍然是 T * R^-1 mod p），所以Montgomery表示不变。
+static void mont_redc_pseudo_mersenne(bigint256 *result, const uint64_t *T, const mont_field *mf) {
+    const uint32_t shift = mf->pm_k - 64 * (LIMBS - 1);  // 1..63
+    const uint64_t c = mf->pm_c;
+    const uint64_t p_inv = mf->p_inv.limbs[0];
+    uint64_t m[LIMBS], mc_hi[LIMBS], out[LIMBS];
+    __int128 acc = 0;
+    
+    for (int j = 0; j < 2 * LIMBS; j++) {
+        acc += T[j];
+        if (j >= LIMBS - 1 && j < 2 * LIMBS - 1) acc += (__int128)(m[j - (LIMBS - 1)] << shift);
+        if (j >= LIMBS)     acc += (__int128)(m[j - LIMBS] >> (64 - shift));
+        if (j >= 1 && j <= LIMBS) acc -= mc_hi[j - 1];
+        
+        if (j < LIMBS) {
+            // 选择 m_j 使本列低64位为0；c = 1 时 m_j 就是本列低64位，省掉两次乘法
+            if (c == 1) {
+                m[j] = (uint64_t)acc;
+                acc -= m[j];
+                mc_hi[j] = 0;
+            } else {
+                m[j] = (uint64_t)acc * p_inv;
+                __uint128_t mc = (__uint128_t)m[j] * c;
+                acc -= (uint64_t)mc;
+                mc_hi[j] = (uint64_t)(mc >> 64);
+            }
+        } else {
+            out[j - LIMBS] = (uint64_t)acc;
+        }
+        acc >>= 64;
+    }
+    
+    // 结果 < 2p，最终的减 p 由 mont_redc 完成
+    memcpy(result->limbs, out, sizeof(out));
+}
+
+// 识别 p = 2^k - c（192 < k < 256，c 为小奇数）
+static int detect_pseudo_mersenne(const bigint256 *p, uint32_t *k, uint64_t *c) {
+    uint64_t top = p->limbs[LIMBS - 1];
+    for (int i = 1; i < LIMBS - 1; i++) {
+        if (p->limbs[i] != 0xFFFFFFFFFFFFFFFFULL) return 0;
+    }
+    // 最高字必须是 2^(k-192) - 1
+    if (top == 0 || top == 0xFFFFFFFFFFFFFFFFULL || (top & (top + 1)) != 0) return 0;
+    
+    uint64_t cc = -p->limbs[0];  // c = 2^64 - p_0
+    if (cc == 0 || cc >= (1ULL << 32) || (cc & 1) == 0) return 0;
+    
+    uint32_t bits = 0;
+    while ((top >> bits) != 0) bits++;
+    *k = 64 * (LIMBS - 1) + bits;
+    *c = cc;
+    return 1;
+}
+
 // ==================== Montgomery 约简（优化版本）====================
 
-static void mont_redc(bigint256 *result, const uint64_t *T, const mont_field *mf) {
+// 约简但不做最终的减 p：T < 2pR 时结果 T * R^-1 落在 [0, 2p)（冗余表示）
+static void mont_redc_2p(bigint256 *result, const uint64_t *T, const mont_field *mf) {
+    if (mf->redc_type == MONT_REDC_PSEUDO_MERSENNE) {
+        mont_redc_pseudo_mersenne(result, T, mf);
+        return;
+    }
+    
     // 优化：直接使用内联计算，减少内存拷贝
     uint64_t temp[8];
     // 使用memcpy优化（编译器会优化）
     __builtin_memcpy(temp, T, 8 * sizeof(uint64_t));
     
     // 优化的Montgomery约简：内联展开，减少循环开销
+    uint64_t top_carry = 0;
     for (int i = 0; i < LIMBS; i++) {
         uint64_t m_i = temp[i] * mf->p_inv.limbs[0];
         
@@ -77,26 +187,30 @@ static void mont_redc(bigint256 *result, const uint64_t *T, const mont_field *mf
             carry = (uint64_t)(prod >> 64);
         }
         
-        // 优化的进位传播：使用更高效的方式
-        int idx = i + LIMBS;
-        if (carry > 0 && idx < 8) {
-            __uint128_t sum = (__uint128_t)temp[idx] + carry;
-            temp[idx] = (uint64_t)sum;
-            carry = (uint64_t)(sum >> 64);
-            idx++;
-            if (carry > 0 && idx < 8) {
-                sum = (__uint128_t)temp[idx] + carry;
-                temp[idx] = (uint64_t)sum;
-            }
-        }
+        // 进位传播：高位进位留到下一轮加入 temp[i + 1 + LIMBS]，不会丢失
+        __uint128_t sum = (__uint128_t)temp[i + LIMBS] + carry + top_carry;
+        temp[i + LIMBS] = (uint64_t)sum;
+        top_carry = (uint64_t)(sum >> 64);
     }
     
     // 直接复制结果（避免额外的memcpy）
     __builtin_memcpy(result->limbs, &temp[LIMBS], LIMBS * sizeof(uint64_t));
+}
+
+static void mont_redc(bigint256 *result, const uint64_t *T, const mont_field *mf) {
+    mont_redc_2p(result, T, mf);
     
-    // 优化的最终约简：只比较一次
-    if (bigint_compare(result, &mf->p) >= 0) {
-        bigint_sub(result, result, &mf->p, &mf->p);
+    // 结果 < 2p，常量时间减去 p
+    uint64_t red[LIMBS];
+    uint64_t borrow = 0;
+    for (int i = 0; i < LIMBS; i++) {
+        __uint128_t d = (__uint128_t)result->limbs[i] - mf->p.limbs[i] - borrow;
+        red[i] = (uint64_t)d;
+        borrow = (uint64_t)(d >> 64) & 1;
+    }
+    uint64_t mask = -borrow;  // 全1表示 result < p，保留 result
+    for (int i = 0; i < LIMBS; i++) {
+        result->limbs[i] = (result->limbs[i] & mask) | (red[i] & ~mask);
     }
 }
 
@@ -108,6 +222,70 @@ void mont_mul(bigint256 *result, const bigint256 *a, const bigint256 *b, const m
     mont_redc(result, T, mf);
 }
 
+// ==================== Montgomery 平方 ====================
+
+void mont_sqr(bigint256 *result, const bigint256 *a, const mont_field *mf) {
+    uint64_t T[8];
+    bigint_sqr_512(T, a);
+    mont_redc(result, T, mf);
+}
+
+// ==================== 冗余表示 [0, 2p) 的乘法/平方 ====================
+
+// 不做最终的减 p。p < 2^253 时 4p^2 < 2pR、8p^2 < 2pR，
+// 所以 a, b < 2p（或 a < 4p, b < 2p）时结果仍在 [0, 2p)
+void mont_mul_lazy(bigint256 *result, const bigint256 *a, const bigint256 *b, const mont_field *mf) {
+    uint64_t T[8];
+    bigint_mul_512_optimized(T, a, b);
+    mont_redc_2p(result, T, mf);
+}
+
+void mont_sqr_lazy(bigint256 *result, const bigint256 *a, const mont_field *mf) {
+    uint64_t T[8];
+    bigint_sqr_512(T, a);
+    mont_redc_2p(result, T, mf);
+}
+
+// ==================== 乘积和：一次约简 ====================
+
+// s = a*b + c*d, t = a*b - c*d（s 或 t 可以为 NULL）。两个乘积在512位上相加减，
+// 和与差各只约简一次；差加上 4p^2（p 的倍数，且不小于 c*d）保证非负。
+// 输入 < 2p 时 T < 8p^2 < 2pR：lazy = 1 结果在 [0, 2p)，否则再减一次 p 得到 [0, p)。
+void mont_mul2_addsub(bigint256 *s, bigint256 *t, const bigint256 *a, const bigint256 *b,
+                      const bigint256 *c, const bigint256 *d, int lazy, const mont_field *mf) {
+    uint64_t T[8], U[8], V[8];
+    bigint_mul_512_optimized(T, a, b);
+    bigint_mul_512_optimized(U, c, d);
+    
+    if (s != NULL) {
+        __uint128_t acc = 0;
+        for (int i = 0; i < 2 * LIMBS; i++) {
+            acc += (__uint128_t)T[i] + U[i];
+            V[i] = (uint64_t)acc;
+            acc >>= 64;
+        }
+        if (lazy) {
+            mont_redc_2p(s, V, mf);
+        } else {
+            mont_redc(s, V, mf);
+        }
+    }
+    
+    if (t != NULL) {
+        __int128 acc = 0;
+        for (int i = 0; i < 2 * LIMBS; i++) {
+            acc += (__int128)T[i] + mf->p_squared_x4[i] - U[i];
+            V[i] = (uint64_t)acc;
+            acc >>= 64;
+        }
+        if (lazy) {
+            mont_redc_2p(t, V, mf);
+        } else {
+            mont_redc(t, V, mf);
+        }
+    }
+}
+
 // ==================== 辅助函数 ====================
 
 static uint64_t inv_mod_2_64(uint64_t a) {
@@ -121,25 +299,46 @@ static uint64_t inv_mod_2_64(uint64_t a) {
 // ==================== Montgomery 域初始化 ====================
 
 void mont_field_init(mont_field *mf) {
-    memcpy(mf->p.limbs, CSIDH256_P, LIMBS * sizeof(uint64_t));
+    bigint256 p;
+    memcpy(p.limbs, CSIDH256_P, LIMBS * sizeof(uint64_t));
+    mont_field_init_modulus(mf, &p);
+}
+
+void mont_field_init_modulus(mont_field *mf, const bigint256 *p) {
+    mf->p = *p;
     
     mf->p_inv.limbs[0] = -inv_mod_2_64(mf->p.limbs[0]);
     for (int i = 1; i < LIMBS; i++) {
         mf->p_inv.limbs[i] = 0;
     }
     
+    // p = 2^k - c 时使用伪梅森约简，否则回退到通用Montgomery约简
+    mf->redc_type = MONT_REDC_GENERIC;
+    mf->pm_k = 0;
+    mf->pm_c = 0;
+    if (detect_pseudo_mersenne(&mf->p, &mf->pm_k, &mf->pm_c)) {
+        mf->redc_type = MONT_REDC_PSEUDO_MERSENNE;
+    }
+    
     bigint256 R;
     memset(&R, 0, sizeof(R));
     R.limbs[0] = 1;
     
-    for (int i = 0; i < 256; i++) {
+    // R^2 = 2^512 mod p：继续加倍，不能用 mont_mul(R, R)（那只是 R * R * R^-1 = R）
+    for (int i = 0; i < 512; i++) {
         bigint_add(&R, &R, &R);
         if (bigint_compare(&R, &mf->p) >= 0) {
             bigint_sub(&R, &R, &mf->p, &mf->p);
         }
     }
+    mf->r_squared = R;
     
-    mont_mul(&mf->r_squared, &R, &R, mf);
+    // 4p^2 = p^2 左移2位（p < 2^253，不会溢出512位）
+    bigint_mul_512_optimized(mf->p_squared_x4, &mf->p, &mf->p);
+    for (int i = 2 * LIMBS - 1; i > 0; i--) {
+        mf->p_squared_x4[i] = (mf->p_squared_x4[i] << 2) | (mf->p_squared_x4[i - 1] >> 62);
+    }
+    mf->p_squared_x4[0] <<= 2;
 }
 
 // ==================== 转换函数 ====================
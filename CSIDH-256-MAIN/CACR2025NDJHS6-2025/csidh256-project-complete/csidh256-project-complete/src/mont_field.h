@@ -6,18 +6,41 @@
 
 // ==================== 基础版本函数声明 ====================
 
+// Montgomery约简方式（由 mont_field_init 根据 p 的形状自动选择）
+#define MONT_REDC_GENERIC          0   // 通用Montgomery约简
+#define MONT_REDC_PSEUDO_MERSENNE  1   // p = 2^k - c（c很小）：移位加法折叠
+
 typedef struct {
     bigint256 p;           // 模数
     bigint256 p_inv;       // Montgomery 参数
     bigint256 r_squared;   // R^2 mod p
+    int redc_type;         // 约简方式 MONT_REDC_*
+    uint32_t pm_k;         // 伪梅森形式 p = 2^k - c 中的 k
+    uint64_t pm_c;         // 伪梅森形式 p = 2^k - c 中的 c
+    uint64_t p_squared_x4[8];  // 4p^2（mont_mul2_addsub 求差时的偏移量）
 } mont_field;
 
 // 初始化 Montgomery 域
 void mont_field_init(mont_field *mf);
 
+// 以任意奇模数 p（p < 2^255）初始化，供素数搜索等工具使用
+void mont_field_init_modulus(mont_field *mf, const bigint256 *p);
+
 // Montgomery 乘法
 void mont_mul(bigint256 *result, const bigint256 *a, const bigint256 *b, const mont_field *mf);
 
+// Montgomery 平方（利用对称交叉项，10次字乘法）
+void mont_sqr(bigint256 *result, const bigint256 *a, const mont_field *mf);
+
+// 冗余表示：输出在 [0, 2p)，省掉最终的减 p（输入 a, b < 2p，或 a < 4p 且 b < 2p）
+void mont_mul_lazy(bigint256 *result, const bigint256 *a, const bigint256 *b, const mont_field *mf);
+void mont_sqr_lazy(bigint256 *result, const bigint256 *a, const mont_field *mf);
+
+// 乘积和：s = a*b + c*d, t = a*b - c*d（s 或 t 可以为 NULL），两个乘积只算一次，
+// 和与差各约简一次；lazy = 1 时结果在 [0, 2p)（输入 < 2p），否则在 [0, p)
+void mont_mul2_addsub(bigint256 *s, bigint256 *t, const bigint256 *a, const bigint256 *b,
+                      const bigint256 *c, const bigint256 *d, int lazy, const mont_field *mf);
+
 // 转换函数
 void to_mont(bigint256 *result, const bigint256 *a, const mont_field *mf);
 void from_mont(bigint256 *result, const bigint256 *a, const mont_field *mf);
@@ -90,8 +90,8 @@ void mont_field_init_optimized(mont_field *mf) {
     bigint256 R = {0};
     R.limbs[0] = 1;
     
-    // 计算R = 2^256 mod p
-    for (int i = 0; i < 256; i++) {
+    // 计算R^2 = 2^512 mod p（一直加倍，mont_mul(R, R) 得到的只是 R）
+    for (int i = 0; i < 512; i++) {
         uint64_t carry = 0;
         for (int j = 0; j < LIMBS; j++) {
             uint64_t old_val = R.limbs[j];
@@ -119,8 +119,7 @@ void mont_field_init_optimized(mont_field *mf) {
         }
     }
     
-    // 计算R^2 mod p
-    mont_mul_optimized(&mf->r_squared, &R, &R, mf);
+    mf->r_squared = R;
 }
 
 // 简化的转换函数
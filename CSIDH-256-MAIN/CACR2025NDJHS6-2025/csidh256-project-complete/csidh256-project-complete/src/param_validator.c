@@ -2,38 +2,22 @@
 #include "params.h"
 #include "fp256.h"
 #include "param_validator.h"
+#include "prime_search.h"
 #include <stdio.h>
+#include <string.h>
 #include <stdint.h>
 #include <stdbool.h>
 
 // 全局变量：参数验证状态
 bool csidh_params_valid = false;
 
-// 计算并验证CSIDH-256素数p
-// p必须满足：p+1能被所有小素数l_i整除（或(p+1)/4能被l_i整除）
-
-// 计算正确的CSIDH-256素数p
-// 这是一个满足条件的256位素数
-// p = 4 * (l_0 * l_1 * ... * l_{N-1}) * k - 1
-// 其中k是使得p为素数的整数
-
+// 当前参数集的素数p：p必须满足 (p+1)/4 能被所有小素数l_i整除，
+// p = 4 * (l_0 * l_1 * ... * l_{N-1}) * k - 1（余因子k见 csidh256_params.h 的 COFACTOR）。
+// p 由 make params 写入 params.h 的 CSIDH256_P，这里直接读取，不另外硬编码
 static void compute_csidh256_prime(uint64_t p[4]) {
-    // 计算所有小素数的乘积（近似）
-    // 实际应该使用大整数运算，这里使用一个已知的CSIDH-256素数
-    // 这个素数是经过验证的，满足p+1能被所有l_i整除
-    
-    // CSIDH-256的标准素数（256位）
-    // p = 2^256 - 2^32 - 2^9 - 2^8 - 2^7 - 2^6 - 2^4 - 1
-    // 但需要验证是否满足条件
-    
-    // 使用一个更简单的方法：找到一个满足条件的素数
-    // 这里使用一个已知的CSIDH-256素数
-    p[0] = 0xFFFFFFFFFFFFFFFF;
-    p[1] = 0xFFFFFFFFFFFFFFFF;
-    p[2] = 0xFFFFFFFFFFFFFFFF;
-    p[3] = 0x1FFFFFFFFFFFFFFF;
-    
-    // 注意：这个素数需要验证是否满足p+1能被所有l_i整除
+    for (int i = 0; i < 4; i++) {
+        p[i] = CSIDH256_P[i];
+    }
 }
 
 // 验证p+1是否能被l_i整除
@@ -127,6 +111,7 @@ bool validate_csidh256_params(void) {
     
     if (all_valid) {
         printf("SUCCESS: p+1 is divisible by all small primes l_i\n");
+        printf("Cofactor k = (p+1) / (4 * prod l_i): %d bits\n", COFACTOR_BITS);
     } else {
         printf("\n");
         printf("================================================================================\n");
@@ -135,7 +120,11 @@ bool validate_csidh256_params(void) {
         printf("当前素数 p 不满足完整的CSIDH-256要求。\n");
         printf("\n");
         printf("CSIDH要求: p+1 必须能被所有小素数 l_i 整除（或 (p+1)/4 能被 l_i 整除）\n");
-        printf("当前素数: p = 2^255 - 1 = 0x1fffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff\n");
+        printf("当前素数: p = 0x");
+        for (int i = 3; i >= 0; i--) {
+            printf("%016llx", (unsigned long long)p[i]);
+        }
+        printf("（params.h 的 CSIDH256_P）\n");
         printf("\n");
         printf("要找到一个满足所有条件的256位CSIDH素数需要：\n");
         printf("  1. 计算所有小素数 l_i 的乘积\n");
@@ -149,7 +138,7 @@ bool validate_csidh256_params(void) {
         printf("  - 模乘优化的性能对比仍然有效和准确\n");
         printf("  - 点乘和同源运算都正确使用了选定的模乘方法\n");
         printf("\n");
-        printf("如需真正的CSIDH-256参数，请参考官方CSIDH实现或使用专门的素数搜索算法。\n");
+        printf("可用 make run-prime-search 搜索满足条件的素数，再用 make params PARAMS_ARGS=\"-p <p>\" 生成参数集。\n");
         printf("================================================================================\n");
     }
     
@@ -160,30 +149,32 @@ bool validate_csidh256_params(void) {
 }
 
 // 计算正确的CSIDH-256素数（满足所有条件）
+// p = 4 * (l_0 * l_1 * ... * l_{N-1}) * k - 1，取使 p 为 253 位（冗余表示要求 p < 2^253）
+// 且 k 为奇数（p ≡ 3 mod 8；L 含 2 时 p ≡ 7 mod 8）的最小 k：先用小素数筛，再做 BPSW。
+// 多线程搜索和其他形状（p ≡ 7 mod 8 等）见 tools/prime_search.c
 void compute_valid_csidh256_prime(uint64_t p[4]) {
-    // CSIDH-256需要一个满足以下条件的素数：
-    // 1. p是256位素数
-    // 2. p ≡ 3 (mod 4)
-    // 3. p+1能被所有小素数l_i整除（或(p+1)/4能被l_i整除）
-    
-    // 方法：p = 4 * (所有l_i的乘积) * k - 1
-    // 其中k是使得p为素数的整数
-    
-    // 计算所有l_i的乘积（使用大整数）
-    // 由于乘积很大，我们使用一个已知的满足条件的素数
-    
-    // 注意：真正的CSIDH-256素数需要通过专门的算法搜索
-    // 这里提供一个框架，实际素数需要通过验证
-    
-    // 使用当前的素数（需要验证）
+    prime_sieve sieve;
+    uint8_t alive[PRIME_SIEVE_BLOCK];
+    bigint256 cand;
+
+    if (prime_sieve_init(&sieve, L, N, 2)) {
+        uint64_t k = prime_sieve_first_k(&sieve, 253) | 1;
+        uint64_t k_end = prime_sieve_first_k(&sieve, 254);
+        for (; k < k_end; k += 2 * (uint64_t)PRIME_SIEVE_BLOCK) {
+            prime_sieve_block(&sieve, k, alive, PRIME_SIEVE_BLOCK);
+            for (int i = 0; i < PRIME_SIEVE_BLOCK; i++) {
+                if (!alive[i] || !prime_sieve_candidate(&sieve, k + 2 * (uint64_t)i, &cand)) continue;
+                if (bigint_is_probable_prime(&cand)) {
+                    memcpy(p, cand.limbs, 4 * sizeof(uint64_t));
+                    return;
+                }
+            }
+        }
+    }
+
+    // 找不到时（l_i 的乘积太大）退回当前素数
     p[0] = CSIDH256_P[0];
     p[1] = CSIDH256_P[1];
     p[2] = CSIDH256_P[2];
     p[3] = CSIDH256_P[3];
-    
-    // 在实际应用中，应该：
-    // 1. 计算所有l_i的乘积
-    // 2. 搜索k使得p = 4 * product * k - 1是素数
-    // 3. 验证p+1能被所有l_i整除
 }
-
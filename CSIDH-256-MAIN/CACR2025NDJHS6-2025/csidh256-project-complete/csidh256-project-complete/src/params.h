@@ -3,6 +3,8 @@
 
 #include <stdint.h>
 
+// 由 tools/gen_csidh_params.c 生成（make params），修改参数请重新运行生成器
+
 // CSIDH-256 参数（比 512 简单很多）
 #define LIMBS 4  // 256 / 64 = 4
 
@@ -22,21 +24,21 @@ typedef struct {
 // 如需标准CSIDH参数，请参考官方实现
 // ============================================================================
 static const uint64_t CSIDH256_P[4] = {
-    0xFFFFFFFFFFFFFFFF,
-    0xFFFFFFFFFFFFFFFF,
-    0xFFFFFFFFFFFFFFFF,
-    0x1FFFFFFFFFFFFFFF  // 注意最高位
+    0x82653CC3EAE4C5EB,
+    0xDC29209CA3618AE5,
+    0x615B08CD8DD0734B,
+    0x100000000ACA9E2A
 };
 
 // 验证函数：检查p+1是否能被l整除
 // 这个函数在运行时验证参数的正确性
 
-// 小素数列表（37个，比512的74个少一半）
+// 小素数列表（37个，升序）
 #define NUM_PRIMES 37
 static const int PRIMES[NUM_PRIMES] = {
     3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41, 43, 47, 53,
-    59, 61, 67, 71, 73, 79, 83, 89, 97, 101, 103, 107, 109, 113,
-    127, 131, 137, 139, 149, 151, 157, 163
+    59, 61, 67, 71, 73, 79, 83, 89, 97, 101, 103, 107, 109, 113, 127,
+    131, 137, 139, 149, 151, 157, 163
 };
 
 #endif
@@ -0,0 +1,334 @@
+#include "prime_search.h"
+#include "mont_field.h"
+#include <string.h>
+
+#define TRIAL_DIVISION_LIMIT 257    // 试除所有小于此值的奇数
+#define SIEVE_Q_LIMIT 32768         // 筛法小素数的上界
+
+// ==================== 小整数辅助 ====================
+
+uint32_t bigint_mod_small(const bigint256 *a, uint32_t q) {
+    uint64_t r = 0;
+    for (int i = LIMBS - 1; i >= 0; i--) {
+        __uint128_t t = ((__uint128_t)r << 64) | a->limbs[i];
+        r = (uint64_t)(t % q);
+    }
+    return (uint32_t)r;
+}
+
+// a^(-1) mod q（q 为奇素数，a 不是 q 的倍数）
+static uint32_t inv_mod_small(uint64_t a, uint32_t q) {
+    int64_t r0 = (int64_t)q, r1 = (int64_t)(a % q);
+    int64_t t0 = 0, t1 = 1;
+    while (r1 != 0) {
+        int64_t quo = r0 / r1, tmp;
+        tmp = r0 - quo * r1; r0 = r1; r1 = tmp;
+        tmp = t0 - quo * t1; t0 = t1; t1 = tmp;
+    }
+    return (uint32_t)(t0 < 0 ? t0 + q : t0);
+}
+
+// Jacobi 符号 (a / n)，n 为正奇数
+static int jacobi_u64(uint64_t a, uint64_t n) {
+    int j = 1;
+    a %= n;
+    while (a != 0) {
+        while ((a & 1) == 0) {
+            a >>= 1;
+            if ((n & 7) == 3 || (n & 7) == 5) j = -j;
+        }
+        uint64_t t = a; a = n; n = t;
+        if ((a & 3) == 3 && (n & 3) == 3) j = -j;
+        a %= n;
+    }
+    return n == 1 ? j : 0;
+}
+
+// Jacobi 符号 (d / n)，d 为小的奇数（可为负），n 为大的正奇数：
+// 二次互反律把它化为 (n mod |d| / |d|)
+static int jacobi_small_big(int64_t d, const bigint256 *n) {
+    uint64_t a = (uint64_t)(d < 0 ? -d : d);
+    int j = jacobi_u64(bigint_mod_small(n, (uint32_t)a), a);
+    if ((a & 3) == 3 && (n->limbs[0] & 3) == 3) j = -j;
+    if (d < 0 && (n->limbs[0] & 3) == 3) j = -j;   // (-1 / n)
+    return j;
+}
+
+static int bigint_is_zero(const bigint256 *a) {
+    uint64_t acc = 0;
+    for (int i = 0; i < LIMBS; i++) acc |= a->limbs[i];
+    return acc == 0;
+}
+
+static int bigint_bit(const bigint256 *a, int i) {
+    return (int)((a->limbs[i / 64] >> (i % 64)) & 1);
+}
+
+static int bigint_bits(const bigint256 *a) {
+    for (int i = LIMBS - 1; i >= 0; i--) {
+        if (a->limbs[i] != 0) return 64 * i + 64 - __builtin_clzll(a->limbs[i]);
+    }
+    return 0;
+}
+
+static void bigint_shr1(bigint256 *a) {
+    for (int i = 0; i < LIMBS - 1; i++) {
+        a->limbs[i] = (a->limbs[i] >> 1) | (a->limbs[i + 1] << 63);
+    }
+    a->limbs[LIMBS - 1] >>= 1;
+}
+
+// a = d·2^s，d 为奇数（a 非零），返回 s
+static int bigint_split_pow2(bigint256 *d, const bigint256 *a) {
+    int s = 0;
+    *d = *a;
+    while ((d->limbs[0] & 1) == 0) {
+        bigint_shr1(d);
+        s++;
+    }
+    return s;
+}
+
+// ==================== 模 n 的加减与减半（输入 < n）====================
+
+static void mod_add(bigint256 *r, const bigint256 *a, const bigint256 *b, const bigint256 *n) {
+    bigint_add(r, a, b);   // n < 2^255，不会溢出
+    if (bigint_compare(r, n) >= 0) {
+        bigint256 z;
+        memset(&z, 0, sizeof(z));
+        bigint_sub(r, r, n, &z);
+    }
+}
+
+static void mod_half(bigint256 *r, const bigint256 *a, const bigint256 *n) {
+    if (a->limbs[0] & 1) {
+        bigint_add(r, a, n);
+    } else {
+        *r = *a;
+    }
+    bigint_shr1(r);   // a + n < 2^256
+}
+
+// Montgomery 形式的小整数 v（|v| < n）
+static void mont_small(bigint256 *r, int64_t v, const bigint256 *r2, const mont_field *mf) {
+    bigint256 x;
+    memset(&x, 0, sizeof(x));
+    x.limbs[0] = (uint64_t)(v < 0 ? -v : v);
+    mont_mul(r, &x, r2, mf);
+    if (v < 0 && !bigint_is_zero(r)) {
+        bigint_sub(r, &mf->p, r, &mf->p);
+    }
+}
+
+// ==================== 强 Miller–Rabin（底 2）====================
+
+// 2^d 用“平方 + 加倍”计算，不需要真正的乘法
+static bool strong_fermat_base2(const bigint256 *n, const bigint256 *one, const bigint256 *minus_one,
+                                const mont_field *mf) {
+    bigint256 n1 = *n, d, x;
+    n1.limbs[0] -= 1;               // n 为奇数，不会借位
+    int s = bigint_split_pow2(&d, &n1);
+
+    x = *one;
+    for (int i = bigint_bits(&d) - 1; i >= 0; i--) {
+        mont_sqr(&x, &x, mf);
+        if (bigint_bit(&d, i)) mod_add(&x, &x, &x, n);
+    }
+    if (bigint_compare(&x, one) == 0 || bigint_compare(&x, minus_one) == 0) return true;
+    for (int r = 1; r < s; r++) {
+        mont_sqr(&x, &x, mf);
+        if (bigint_compare(&x, minus_one) == 0) return true;
+        if (bigint_compare(&x, one) == 0) return false;
+    }
+    return false;
+}
+
+// ==================== 强 Lucas 测试（Selfridge 方法 A：P = 1, Q = (1 - D)/4）====================
+
+// n 是否为完全平方数（二分求整数平方根，根 < 2^128）
+static bool bigint_is_square(const bigint256 *n) {
+    __uint128_t lo = 0, hi = ~(__uint128_t)0;
+    while (lo <= hi) {
+        __uint128_t mid = lo + ((hi - lo) >> 1);
+        uint64_t m0 = (uint64_t)mid, m1 = (uint64_t)(mid >> 64);
+        // mid^2 的四个字
+        __uint128_t ll = (__uint128_t)m0 * m0, lh = (__uint128_t)m0 * m1, hh = (__uint128_t)m1 * m1;
+        bigint256 sq;
+        __uint128_t t = (ll >> 64) + (uint64_t)lh + (uint64_t)lh;
+        sq.limbs[0] = (uint64_t)ll;
+        sq.limbs[1] = (uint64_t)t;
+        t = (t >> 64) + (lh >> 64) + (lh >> 64) + (uint64_t)hh;
+        sq.limbs[2] = (uint64_t)t;
+        sq.limbs[3] = (uint64_t)((t >> 64) + (hh >> 64));
+        int c = bigint_compare(&sq, n);
+        if (c == 0) return true;
+        if (c < 0) {
+            lo = mid + 1;
+        } else {
+            if (mid == 0) break;
+            hi = mid - 1;
+        }
+    }
+    return false;
+}
+
+static bool strong_lucas_selfridge(const bigint256 *n, const bigint256 *one, const bigint256 *r2,
+                                   const mont_field *mf) {
+    // D = 5, -7, 9, -11, ... 中第一个满足 (D / n) = -1 的值；完全平方数找不到这样的 D
+    int64_t D = 5;
+    for (int tries = 0;; tries++) {
+        int j = jacobi_small_big(D, n);
+        if (j == -1) break;
+        if (j == 0) return false;   // |D| 与 n 有公因子（n 远大于 |D|）
+        if (tries == 16 && bigint_is_square(n)) return false;
+        D = (D > 0) ? -(D + 2) : -(D - 2);
+    }
+
+    bigint256 Dm, Qm, U, V, Qk, t;
+    mont_small(&Dm, D, r2, mf);
+    mont_small(&Qm, (1 - D) / 4, r2, mf);
+
+    // n + 1 = d·2^s
+    bigint256 n1 = *n, d;
+    for (int i = 0; i < LIMBS && ++n1.limbs[i] == 0; i++) {}
+    int s = bigint_split_pow2(&d, &n1);
+
+    // U_1 = 1, V_1 = P = 1, Q^1 = Q；从 d 的次高位开始：k -> 2k（-> 2k + 1）
+    U = *one;
+    V = *one;
+    Qk = Qm;
+    for (int i = bigint_bits(&d) - 2; i >= 0; i--) {
+        // U_2k = U_k V_k, V_2k = V_k^2 - 2Q^k, Q^2k = (Q^k)^2
+        mont_mul(&U, &U, &V, mf);
+        mont_sqr(&V, &V, mf);
+        mod_add(&t, &Qk, &Qk, n);
+        bigint_sub(&V, &V, &t, n);
+        mont_sqr(&Qk, &Qk, mf);
+        if (bigint_bit(&d, i)) {
+            // U_k+1 = (U_k + V_k)/2, V_k+1 = (D U_k + V_k)/2, Q^k+1 = Q^k Q
+            bigint256 u_new;
+            mod_add(&u_new, &U, &V, n);
+            mod_half(&u_new, &u_new, n);
+            mont_mul(&t, &Dm, &U, mf);
+            mod_add(&t, &t, &V, n);
+            mod_half(&V, &t, n);
+            U = u_new;
+            mont_mul(&Qk, &Qk, &Qm, mf);
+        }
+    }
+
+    // U_d ≡ 0，或存在 0 <= r < s 使 V_(d·2^r) ≡ 0
+    if (bigint_is_zero(&U)) return true;
+    for (int r = 0; r < s; r++) {
+        if (bigint_is_zero(&V)) return true;
+        mont_sqr(&V, &V, mf);
+        mod_add(&t, &Qk, &Qk, n);
+        bigint_sub(&V, &V, &t, n);
+        mont_sqr(&Qk, &Qk, mf);
+    }
+    return false;
+}
+
+// ==================== BPSW ====================
+
+bool bigint_is_probable_prime(const bigint256 *n) {
+    if (n->limbs[LIMBS - 1] >> 63) {
+        return false;   // 只支持 n < 2^255（mont_redc 的结果需 < 2^256）
+    }
+    int small = (n->limbs[1] | n->limbs[2] | n->limbs[3]) == 0;
+    if (small && n->limbs[0] < 2) return false;
+    if (small && n->limbs[0] == 2) return true;
+    if ((n->limbs[0] & 1) == 0) return false;
+
+    for (uint32_t q = 3; q < TRIAL_DIVISION_LIMIT; q += 2) {
+        if (small && n->limbs[0] == q) return true;
+        if (bigint_mod_small(n, q) == 0) return false;
+    }
+    if (small && n->limbs[0] < (uint64_t)TRIAL_DIVISION_LIMIT * TRIAL_DIVISION_LIMIT) return true;
+
+    // 以 n 为模的 Montgomery 域
+    mont_field mf;
+    mont_field_init_modulus(&mf, n);
+    bigint256 one, minus_one, zero;
+    memset(&zero, 0, sizeof(zero));
+    memset(&one, 0, sizeof(one));
+    one.limbs[0] = 1;
+    for (int i = 0; i < 256; i++) mod_add(&one, &one, &one, n);
+    bigint_sub(&minus_one, &zero, &one, n);
+
+    return strong_fermat_base2(n, &one, &minus_one, &mf) &&
+           strong_lucas_selfridge(n, &one, &mf.r_squared, &mf);
+}
+
+// ==================== 筛法 ====================
+
+bool prime_sieve_init(prime_sieve *s, const uint32_t *l, int n, uint64_t k_step) {
+    memset(s, 0, sizeof(*s));
+    s->m.limbs[0] = 4;
+    for (int i = 0; i < n; i++) {
+        if (l[i] < 3 || (l[i] & 1) == 0) return false;
+        uint64_t carry = 0;
+        for (int j = 0; j < LIMBS; j++) {
+            __uint128_t t = (__uint128_t)s->m.limbs[j] * l[i] + carry;
+            s->m.limbs[j] = (uint64_t)t;
+            carry = (uint64_t)(t >> 64);
+        }
+        if (carry != 0) return false;
+    }
+    s->k_step = k_step;
+
+    // 埃氏筛出 SIEVE_Q_LIMIT 以内的奇素数，去掉整除 m 或 k_step 的（它们不可能整除 m*k - 1 或无法步进）
+    uint8_t composite[SIEVE_Q_LIMIT] = {0};
+    for (uint32_t i = 3; i * i < SIEVE_Q_LIMIT; i += 2) {
+        if (composite[i]) continue;
+        for (uint32_t j = i * i; j < SIEVE_Q_LIMIT; j += 2 * i) composite[j] = 1;
+    }
+    for (uint32_t q = 3; q < SIEVE_Q_LIMIT && s->nq < PRIME_SIEVE_PRIMES; q += 2) {
+        if (composite[q]) continue;
+        uint32_t mq = bigint_mod_small(&s->m, q);
+        if (mq == 0 || k_step % q == 0) continue;
+        s->q[s->nq] = q;
+        s->k_root[s->nq] = inv_mod_small(mq, q);
+        s->step_inv[s->nq] = inv_mod_small(k_step % q, q);
+        s->nq++;
+    }
+    return true;
+}
+
+void prime_sieve_block(const prime_sieve *s, uint64_t k0, uint8_t *alive, int count) {
+    memset(alive, 1, (size_t)count);
+    for (int j = 0; j < s->nq; j++) {
+        uint32_t q = s->q[j];
+        // k0 + i*k_step ≡ k_root  =>  i ≡ (k_root - k0) * k_step^(-1)  (mod q)
+        uint64_t diff = (s->k_root[j] + q - k0 % q) % q;
+        uint64_t i = diff * s->step_inv[j] % q;
+        for (; i < (uint64_t)count; i += q) alive[i] = 0;
+    }
+}
+
+bool prime_sieve_candidate(const prime_sieve *s, uint64_t k, bigint256 *p) {
+    uint64_t carry = 0;
+    for (int j = 0; j < LIMBS; j++) {
+        __uint128_t t = (__uint128_t)s->m.limbs[j] * k + carry;
+        p->limbs[j] = (uint64_t)t;
+        carry = (uint64_t)(t >> 64);
+    }
+    if (carry != 0 || bigint_is_zero(p)) return false;
+    for (int j = 0; j < LIMBS && p->limbs[j]-- == 0; j++) {}
+    return true;
+}
+
+uint64_t prime_sieve_first_k(const prime_sieve *s, int bits) {
+    // 二分：m*k - 1 >= 2^(bits-1) 的最小 k
+    uint64_t lo = 1, hi = ~0ULL;
+    while (lo < hi) {
+        uint64_t mid = lo + ((hi - lo) >> 1);
+        bigint256 p;
+        if (!prime_sieve_candidate(s, mid, &p) || bigint_bits(&p) >= bits) {
+            hi = mid;
+        } else {
+            lo = mid + 1;
+        }
+    }
+    return lo;
+}
@@ -0,0 +1,42 @@
+#ifndef PRIME_SEARCH_H
+#define PRIME_SEARCH_H
+
+// CSIDH素数搜索：p = 4 * l_1 * ... * l_n * k - 1
+// 先用小素数筛掉候选 k，再用项目自己的4字Montgomery运算做 BPSW 测试
+
+#include "params.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#define PRIME_SIEVE_PRIMES 2048     // 参与筛法的小素数个数上限
+#define PRIME_SIEVE_BLOCK 8192      // 每块筛的候选 k 个数
+
+// a mod q（q < 2^32）
+uint32_t bigint_mod_small(const bigint256 *a, uint32_t q);
+
+// Baillie–PSW 概率素性测试：小素数试除 + 以2为底的强 Miller–Rabin + 强 Lucas（Selfridge 参数）。
+// n 必须小于 2^255；目前没有已知的 BPSW 伪素数
+bool bigint_is_probable_prime(const bigint256 *n);
+
+typedef struct {
+    bigint256 m;                            // 4 * l_1 * ... * l_n
+    uint64_t k_step;                        // 相邻候选 k 的间隔
+    int nq;                                 // 参与筛法的小素数个数
+    uint32_t q[PRIME_SIEVE_PRIMES];
+    uint32_t k_root[PRIME_SIEVE_PRIMES];    // q | m*k - 1 当且仅当 k ≡ k_root (mod q)
+    uint32_t step_inv[PRIME_SIEVE_PRIMES];  // k_step^(-1) mod q
+} prime_sieve;
+
+// 由 l_i 列表构造筛（k_step 为奇数或2的幂）；乘积超过 256 位或 l_i 不是奇素数时返回 false
+bool prime_sieve_init(prime_sieve *s, const uint32_t *l, int n, uint64_t k_step);
+
+// 筛一块：alive[i] = 1 表示 p = m*(k0 + i*k_step) - 1 没有参与筛法的小素数因子
+void prime_sieve_block(const prime_sieve *s, uint64_t k0, uint8_t *alive, int count);
+
+// p = m*k - 1；超过 256 位时返回 false
+bool prime_sieve_candidate(const prime_sieve *s, uint64_t k, bigint256 *p);
+
+// 使 m*k - 1 恰好为 bits 位的最小 k（bits <= 255）
+uint64_t prime_sieve_first_k(const prime_sieve *s, int bits);
+
+#endif // PRIME_SEARCH_H
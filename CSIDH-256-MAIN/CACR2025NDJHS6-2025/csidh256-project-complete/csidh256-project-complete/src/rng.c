@@ -1,4 +1,6 @@
-// 密码学安全的随机数生成器
+// 密码学安全的随机数生成器：系统 CSPRNG 取种子 + 每线程 ChaCha20 DRBG
+#include "rng.h"
+#include <stdatomic.h>
 #include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
@@ -16,10 +18,16 @@
 #endif
 #endif
 
+#if defined(_MSC_VER)
+#define RNG_THREAD_LOCAL __declspec(thread)
+#else
+#define RNG_THREAD_LOCAL _Thread_local
+#endif
+
 // 使用系统提供的密码学安全RNG (CSPRNG)
 // Windows: 使用 CryptGenRandom (Windows CSPRNG)
 // Linux: 使用 /dev/urandom 或 getrandom() 系统调用
-void randombytes(void *x, size_t l) {
+void randombytes_os(void *x, size_t l) {
 #ifdef _WIN32
     // Windows: 使用 CryptGenRandom (Windows CSPRNG)
     HCRYPTPROV hProvider = 0;
@@ -62,3 +70,172 @@ void randombytes(void *x, size_t l) {
 #endif
 }
 
+// ==================== ChaCha20 ====================
+
+#define ROTL32(x, n) (((x) << (n)) | ((x) >> (32 - (n))))
+#define CHACHA_QR(a, b, c, d) \
+    a += b; d ^= a; d = ROTL32(d, 16); \
+    c += d; b ^= c; b = ROTL32(b, 12); \
+    a += b; d ^= a; d = ROTL32(d, 8);  \
+    c += d; b ^= c; b = ROTL32(b, 7)
+
+// 一个64字节的密钥流块（RFC 8439 的状态布局：32位计数器，nonce 的前32位为 0）
+static void chacha20_block(uint8_t out[64], const uint32_t key[8], uint32_t counter, uint64_t nonce) {
+    uint32_t in[16] = {
+        0x61707865, 0x3320646e, 0x79622d32, 0x6b206574,
+        key[0], key[1], key[2], key[3], key[4], key[5], key[6], key[7],
+        counter, 0, (uint32_t)nonce, (uint32_t)(nonce >> 32)
+    };
+    uint32_t x[16];
+    memcpy(x, in, sizeof(x));
+    for (int i = 0; i < 10; i++) {
+        CHACHA_QR(x[0], x[4], x[8], x[12]);
+        CHACHA_QR(x[1], x[5], x[9], x[13]);
+        CHACHA_QR(x[2], x[6], x[10], x[14]);
+        CHACHA_QR(x[3], x[7], x[11], x[15]);
+        CHACHA_QR(x[0], x[5], x[10], x[15]);
+        CHACHA_QR(x[1], x[6], x[11], x[12]);
+        CHACHA_QR(x[2], x[7], x[8], x[13]);
+        CHACHA_QR(x[3], x[4], x[9], x[14]);
+    }
+    for (int i = 0; i < 16; i++) {
+        uint32_t v = x[i] + in[i];
+        out[4 * i] = (uint8_t)v;
+        out[4 * i + 1] = (uint8_t)(v >> 8);
+        out[4 * i + 2] = (uint8_t)(v >> 16);
+        out[4 * i + 3] = (uint8_t)(v >> 24);
+    }
+}
+
+// ==================== 每线程 DRBG ====================
+// 快速密钥擦除：每次用当前密钥生成 RNG_BUFFER_BLOCKS 块，前32字节立即成为新密钥，
+// 其余作为输出缓冲；交出的字节在缓冲中清零，事后泄露状态也恢复不出以前的输出。
+
+#define RNG_BUFFER_BLOCKS 8
+#define RNG_BUFFER_BYTES (64 * RNG_BUFFER_BLOCKS)
+
+typedef struct {
+    uint32_t key[8];
+    uint8_t buf[RNG_BUFFER_BYTES];
+    size_t pos;                 // buf 中下一个未用字节（== RNG_BUFFER_BYTES 表示需要重新生成）
+    size_t since_reseed;        // 上次混入系统熵以来输出的字节数
+    int seeded;
+    int deterministic;
+} rng_state;
+
+static RNG_THREAD_LOCAL rng_state tls_rng;
+
+// 确定性模式的全局种子：rng_seed 之后第一次使用 DRBG 的线程按先后顺序派生各自的密钥
+static uint32_t g_seed_key[8];
+static atomic_int g_seed_set;
+static atomic_uint g_seed_seq;
+
+static void load_key(uint32_t key[8], const uint8_t k[RNG_SEED_BYTES]) {
+    for (int i = 0; i < 8; i++) {
+        key[i] = (uint32_t)k[4 * i] | ((uint32_t)k[4 * i + 1] << 8) |
+                 ((uint32_t)k[4 * i + 2] << 16) | ((uint32_t)k[4 * i + 3] << 24);
+    }
+}
+
+static void rng_refill(rng_state *st) {
+    for (uint32_t i = 0; i < RNG_BUFFER_BLOCKS; i++) {
+        chacha20_block(st->buf + 64 * i, st->key, i, 0);
+    }
+    load_key(st->key, st->buf);
+    memset(st->buf, 0, RNG_SEED_BYTES);
+    st->pos = RNG_SEED_BYTES;
+}
+
+// 把新的系统熵混入密钥（key ^= OS 随机数）
+static void rng_mix_os_entropy(rng_state *st) {
+    uint8_t fresh[RNG_SEED_BYTES];
+    uint32_t k[8];
+    randombytes_os(fresh, sizeof(fresh));
+    load_key(k, fresh);
+    for (int i = 0; i < 8; i++) {
+        st->key[i] ^= k[i];
+    }
+    memset(fresh, 0, sizeof(fresh));
+    memset(k, 0, sizeof(k));
+    st->pos = RNG_BUFFER_BYTES;     // 丢弃用旧密钥生成的缓冲
+    st->since_reseed = 0;
+}
+
+void randombytes(void *x, size_t l) {
+    rng_state *st = &tls_rng;
+    uint8_t *out = (uint8_t *)x;
+
+    if (!st->seeded) {
+        if (atomic_load_explicit(&g_seed_set, memory_order_acquire)) {
+            uint8_t block[64];
+            uint32_t seq = atomic_fetch_add_explicit(&g_seed_seq, 1, memory_order_relaxed);
+            chacha20_block(block, g_seed_key, 0x80000000u | seq, 0);
+            load_key(st->key, block);
+            memset(block, 0, sizeof(block));
+            st->pos = RNG_BUFFER_BYTES;
+            st->deterministic = 1;
+        } else {
+            memset(st->key, 0, sizeof(st->key));
+            rng_mix_os_entropy(st);
+            st->deterministic = 0;
+        }
+        st->seeded = 1;
+    } else if (!st->deterministic && st->since_reseed >= RNG_RESEED_BYTES) {
+        rng_mix_os_entropy(st);
+    }
+
+    while (l > 0) {
+        if (st->pos == RNG_BUFFER_BYTES) rng_refill(st);
+        size_t n = RNG_BUFFER_BYTES - st->pos;
+        if (n > l) n = l;
+        memcpy(out, st->buf + st->pos, n);
+        memset(st->buf + st->pos, 0, n);
+        st->pos += n;
+        st->since_reseed += n;
+        out += n;
+        l -= n;
+    }
+}
+
+void rng_seed(const uint8_t seed[RNG_SEED_BYTES]) {
+    rng_state *st = &tls_rng;
+    load_key(st->key, seed);
+    st->pos = RNG_BUFFER_BYTES;
+    st->since_reseed = 0;
+    st->seeded = 1;
+    st->deterministic = 1;
+
+    load_key(g_seed_key, seed);
+    atomic_store_explicit(&g_seed_seq, 0, memory_order_relaxed);
+    atomic_store_explicit(&g_seed_set, 1, memory_order_release);
+}
+
+void rng_reseed(void) {
+    rng_state *st = &tls_rng;
+    if (!st->seeded) memset(st->key, 0, sizeof(st->key));
+    rng_mix_os_entropy(st);
+    st->seeded = 1;
+    st->deterministic = 0;
+    atomic_store_explicit(&g_seed_set, 0, memory_order_release);
+}
+
+void rng_expand(void *out, size_t l, const uint8_t seed[RNG_SEED_BYTES], uint64_t nonce) {
+    uint32_t key[8];
+    uint8_t block[64];
+    uint8_t *o = (uint8_t *)out;
+    load_key(key, seed);
+    for (uint32_t ctr = 0; l > 0; ctr++) {
+        size_t n = (l < sizeof(block)) ? l : sizeof(block);
+        chacha20_block(block, key, ctr, nonce);
+        memcpy(o, block, n);
+        o += n;
+        l -= n;
+    }
+    memset(block, 0, sizeof(block));
+    memset(key, 0, sizeof(key));
+}
+
+void rng_zeroize(void *x, size_t l) {
+    volatile uint8_t *p = (volatile uint8_t *)x;
+    while (l--) *p++ = 0;
+}
@@ -4,9 +4,28 @@
 #include <stddef.h>
 #include <stdint.h>
 
-// 密码学安全的随机数生成
+// 每个线程一个 ChaCha20 DRBG（快速密钥擦除），第一次使用时从操作系统取种子，
+// 之后每输出 RNG_RESEED_BYTES 字节混入新的系统熵。一次系统调用可以服务上千次小请求。
+#define RNG_SEED_BYTES 32
+#define RNG_RESEED_BYTES (1u << 20)
+
+// 密码学安全的随机数生成（当前线程的 DRBG，任意长度批量填充）
 void randombytes(void *x, size_t l);
 
-#endif // RNG_H
+// 直接从操作系统 CSPRNG 读取（DRBG 取种子用）
+void randombytes_os(void *x, size_t l);
+
+// 确定性模式（用于可复现的基准测试）：当前线程的 DRBG 改用给定种子，不再混入系统熵；
+// 之后第一次使用 DRBG 的其他线程（如 csidh_batch 的工作线程）按先后顺序由该种子派生各自的密钥
+void rng_seed(const uint8_t seed[RNG_SEED_BYTES]);
 
+// 当前线程立即从操作系统重新取种子，并退出确定性模式
+void rng_reseed(void);
 
+// 由种子确定性展开的 ChaCha20 密钥流（nonce 区分不同用途；与 DRBG 状态无关，可在任意线程调用）
+void rng_expand(void *out, size_t l, const uint8_t seed[RNG_SEED_BYTES], uint64_t nonce);
+
+// 清零敏感数据（volatile 写，不会被编译器当作死存储删掉）
+void rng_zeroize(void *x, size_t l);
+
+#endif // RNG_H
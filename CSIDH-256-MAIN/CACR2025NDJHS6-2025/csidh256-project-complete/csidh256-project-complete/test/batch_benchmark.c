@@ -0,0 +1,158 @@
+// 批量密钥交换吞吐量基准：单核标量/多缓冲群作用，以及 1..N 个工作线程的 handshakes/s
+// 用法: make run-batch-benchmark [BATCH_THREADS=8] [BATCH_SEED=1]（给出种子时密钥与随机点可复现）
+// 一次握手 = 一次密钥生成 + 一次共享密钥计算（两次群作用）
+
+#include "../src/csidh_batch.h"
+#include "../src/edwards256_mb.h"
+#include "../src/rng.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+#define HANDSHAKES_PER_THREAD 8
+#define MB_ROUNDS 4
+
+static double wall_seconds(void) {
+#ifdef _WIN32
+    LARGE_INTEGER freq, now;
+    QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&now);
+    return (double)now.QuadPart / (double)freq.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + 1e-9 * (double)ts.tv_nsec;
+#endif
+}
+
+// 执行 n 次握手（n 为偶数，i 与 i^1 互为通信双方），返回耗时（秒）
+static double run_handshakes(csidh_job *keygen, csidh_job *derive, uint8_t (*keys)[N],
+                             size_t n, int threads, int *shared_ok) {
+    for (size_t i = 0; i < n; i++) {
+        random_key(keys[i]);
+        keygen[i].key = keys[i];
+        point_copy(keygen[i].in, E);
+    }
+
+    double t0 = wall_seconds();
+    size_t ok = csidh_batch_derive(keygen, n, threads);
+    for (size_t i = 0; i < n; i++) {
+        derive[i].key = keys[i];
+        point_copy(derive[i].in, keygen[i ^ 1].out);
+    }
+    ok += csidh_batch_derive(derive, n, threads);
+    double t1 = wall_seconds();
+
+    *shared_ok = (ok == 2 * n);
+    for (size_t i = 0; i < n; i += 2) {
+        if (!areEqual(derive[i].out, derive[i + 1].out)) *shared_ok = 0;
+    }
+    return t1 - t0;
+}
+
+int main(int argc, char *argv[]) {
+    printf("=== CSIDH-256 Batch Key Exchange Throughput ===\n\n");
+
+    init_public_curve();
+
+    int cpus = csidh_num_cpus();
+    int max_threads = (argc > 1) ? atoi(argv[1]) : cpus;
+    if (max_threads < 1) max_threads = cpus;
+    if (argc > 2) {
+        uint8_t seed[RNG_SEED_BYTES] = {0};
+        uint64_t s = strtoull(argv[2], NULL, 0);
+        for (int i = 0; i < 8; i++) seed[i] = (uint8_t)(s >> (8 * i));
+        rng_seed(seed);
+    }
+
+    size_t max_n = (size_t)HANDSHAKES_PER_THREAD * (size_t)max_threads;
+    csidh_job *keygen = (csidh_job*)calloc(max_n, sizeof(csidh_job));
+    csidh_job *derive = (csidh_job*)calloc(max_n, sizeof(csidh_job));
+    uint8_t (*keys)[N] = calloc(max_n, sizeof(*keys));
+    if (keygen == NULL || derive == NULL || keys == NULL) {
+        printf("ERROR: out of memory\n");
+        return 1;
+    }
+
+    printf("Backend:      %s\n", FP256_BACKEND_NAME);
+    printf("Field repr:   %s\n", FP256_REPR_NAME);
+    printf("Multi-buffer: %s\n", action_evaluation_mb_name());
+    printf("Online CPUs:  %d\n", cpus);
+    printf("RNG:          %s\n\n", (argc > 2) ? "deterministic (seeded ChaCha20)" : "ChaCha20, OS-seeded");
+
+    // 单核：标量 action_evaluation 与 4/8 通道多缓冲群作用
+    {
+        uint8_t mb_keys[8][N];
+        const uint8_t *kp[8];
+        proj in[8], out[8];
+        for (int j = 0; j < 8; j++) {
+            random_key(mb_keys[j]);
+            kp[j] = mb_keys[j];
+            point_copy(in[j], E);
+        }
+
+        double t0 = wall_seconds();
+        for (int r = 0; r < MB_ROUNDS; r++) {
+            for (int j = 0; j < 8; j++) {
+                action_evaluation(out[j], mb_keys[j], in[j]);
+            }
+        }
+        double scalar_rate = 8.0 * MB_ROUNDS / (wall_seconds() - t0);
+
+        // 共享密钥一侧：从公钥出发，不能用E的预计算扭点
+        proj pub[8];
+        for (int j = 0; j < 8; j++) {
+            point_copy(pub[j], out[(j + 1) % 8]);
+        }
+        t0 = wall_seconds();
+        for (int r = 0; r < MB_ROUNDS; r++) {
+            for (int j = 0; j < 8; j++) {
+                action_evaluation(out[j], mb_keys[j], pub[j]);
+            }
+        }
+        double derive_rate = 8.0 * MB_ROUNDS / (wall_seconds() - t0);
+
+        t0 = wall_seconds();
+        for (int r = 0; r < 2 * MB_ROUNDS; r++) {
+            action_evaluation_x4(out, kp, (const proj *)in);
+        }
+        double x4_rate = 4.0 * 2 * MB_ROUNDS / (wall_seconds() - t0);
+
+        t0 = wall_seconds();
+        for (int r = 0; r < MB_ROUNDS; r++) {
+            action_evaluation_x8(out, kp, (const proj *)in);
+        }
+        double x8_rate = 8.0 * MB_ROUNDS / (wall_seconds() - t0);
+
+        printf("Single core group actions/s:\n");
+        printf("  action_evaluation     %10.2f\n", scalar_rate);
+        printf("    from a public key   %10.2f\n", derive_rate);
+        printf("  action_evaluation_x4  %10.2f  (%.2fx)\n", x4_rate, x4_rate / scalar_rate);
+        printf("  action_evaluation_x8  %10.2f  (%.2fx)\n\n", x8_rate, x8_rate / scalar_rate);
+    }
+    printf("  %7s  %10s  %10s  %13s  %8s\n", "threads", "handshakes", "seconds", "handshakes/s", "speedup");
+
+    double base_rate = 0.0;
+    int all_ok = 1;
+    for (int t = 1; t <= max_threads; t = (t < max_threads && 2 * t > max_threads) ? max_threads : 2 * t) {
+        size_t n = (size_t)HANDSHAKES_PER_THREAD * (size_t)t;
+        int shared_ok;
+        double sec = run_handshakes(keygen, derive, keys, n, t, &shared_ok);
+        double rate = (double)n / sec;
+        if (t == 1) base_rate = rate;
+        printf("  %7d  %10zu  %10.3f  %13.2f  %7.2fx%s\n", t, n, sec, rate, rate / base_rate,
+               shared_ok ? "" : "  (shared secrets MISMATCH)");
+        all_ok &= shared_ok;
+        if (t == max_threads) break;
+    }
+
+    csidh_batch_shutdown();
+    free(keygen);
+    free(derive);
+    free(keys);
+    return all_ok ? 0 : 1;
+}
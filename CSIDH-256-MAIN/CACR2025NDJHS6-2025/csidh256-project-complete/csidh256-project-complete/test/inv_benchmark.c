@@ -0,0 +1,130 @@
+// 域逆元 / 平方判定微基准：费马加法链 vs safegcd，以及批量求逆的每元素开销
+// 用法: make run-inv-benchmark [FP_BACKEND=asm]
+
+#include "../src/fp256.h"
+#include "../src/fp256_safegcd.h"
+#include "../src/rng.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define ITERATIONS 20000
+
+static uint64_t get_cycles(void) {
+#ifdef _WIN32
+    return __rdtsc();
+#else
+    uint32_t lo, hi;
+    asm volatile("rdtsc":"=a"(lo),"=d"(hi));
+    return ((uint64_t)hi << 32) | lo;
+#endif
+}
+
+// 生成随机域元素（x < p）
+static void random_element(fp *x) {
+    do {
+        randombytes(x->limbs, NUMBER_OF_WORDS * sizeof(uint64_t));
+        x->limbs[NUMBER_OF_WORDS - 1] &= g_mf.p.limbs[NUMBER_OF_WORDS - 1];
+    } while (fp_compare(x, &g_mf.p) >= 0);
+}
+
+int main() {
+    printf("=== CSIDH-256 Inversion / Legendre: Fermat vs safegcd ===\n\n");
+
+    init_montgomery_field();
+
+    fp a, x, y;
+    random_element(&a);
+
+    // 正确性：a 与 p 互素时 a * a^(-1) = R mod p（Montgomery域中的1）
+    while (fp_jacobi_bingcd(&a) == 0) {
+        random_element(&a);
+    }
+    fp_copy(&y, &a);
+    fp_inv_safegcd(&y);
+    fp_mul(&x, &a, &y);
+    if (fp_compare(&x, &R_mod_p) != 0) {
+        printf("ERROR: a * fp_inv_safegcd(a) != 1\n");
+        return 1;
+    }
+
+    // 依赖链：每次求逆的输入是上一次的输出
+    uint64_t c0, c1;
+    uint64_t acc = 0;
+
+    fp_copy(&x, &a);
+    c0 = get_cycles();
+    for (int i = 0; i < ITERATIONS; i++) {
+        fp_inv_fermat(&x);
+    }
+    c1 = get_cycles();
+    double fermat_inv = (double)(c1 - c0) / ITERATIONS;
+    acc ^= x.limbs[0];
+
+    fp_copy(&x, &a);
+    c0 = get_cycles();
+    for (int i = 0; i < ITERATIONS; i++) {
+        fp_inv_safegcd(&x);
+    }
+    c1 = get_cycles();
+    double safegcd_inv = (double)(c1 - c0) / ITERATIONS;
+    acc ^= x.limbs[0];
+
+    // 平方判定：每次把上一次的结果混入输入，避免被优化掉
+    fp_copy(&x, &a);
+    c0 = get_cycles();
+    for (int i = 0; i < ITERATIONS; i++) {
+        x.limbs[0] ^= fp_issquare_euler(&x);
+    }
+    c1 = get_cycles();
+    double euler_sq = (double)(c1 - c0) / ITERATIONS;
+    acc ^= x.limbs[0];
+
+    fp_copy(&x, &a);
+    c0 = get_cycles();
+    for (int i = 0; i < ITERATIONS; i++) {
+        x.limbs[0] ^= (uint64_t)(fp_jacobi_bingcd(&x) & 1);
+    }
+    c1 = get_cycles();
+    double safegcd_jac = (double)(c1 - c0) / ITERATIONS;
+    acc ^= x.limbs[0];
+
+    printf("Backend:              %s\n", FP256_BACKEND_NAME);
+    printf("fp_inv / fp_issquare: %s\n", FP256_INV_NAME);
+    printf("Iterations:           %d\n", ITERATIONS);
+    printf("fp_inv_fermat:        %.0f cycles/op\n", fermat_inv);
+    printf("fp_inv_safegcd:       %.0f cycles/op (%.2fx)\n", safegcd_inv, fermat_inv / safegcd_inv);
+    printf("fp_issquare_euler:    %.0f cycles/op\n", euler_sq);
+    printf("fp_jacobi_bingcd:     %.0f cycles/op (%.2fx)\n", safegcd_jac, euler_sq / safegcd_jac);
+
+    // 批量求逆（Montgomery技巧）：每元素开销随 n 下降，趋近 3M
+    static const size_t batch_sizes[] = {1, 2, 4, 8, 16, 64, 256, 1024};
+    const size_t max_n = batch_sizes[sizeof(batch_sizes) / sizeof(batch_sizes[0]) - 1];
+    fp *xs = (fp*)malloc(max_n * sizeof(fp));
+    if (xs == NULL) {
+        printf("ERROR: out of memory\n");
+        return 1;
+    }
+    for (size_t i = 0; i < max_n; i++) {
+        random_element(&xs[i]);
+    }
+
+    printf("\nfp_inv_batch (per element):\n");
+    printf("  %6s  %12s  %10s\n", "n", "cycles/elem", "vs fp_inv");
+    for (size_t s = 0; s < sizeof(batch_sizes) / sizeof(batch_sizes[0]); s++) {
+        size_t n = batch_sizes[s];
+        int reps = (int)(4096 / n) + 1;
+        c0 = get_cycles();
+        for (int r = 0; r < reps; r++) {
+            fp_inv_batch(xs, n);
+        }
+        c1 = get_cycles();
+        double per_elem = (double)(c1 - c0) / ((double)reps * (double)n);
+        printf("  %6zu  %12.0f  %9.2fx\n", n, per_elem, safegcd_inv / per_elem);
+        acc ^= xs[0].limbs[0];
+    }
+    free(xs);
+
+    printf("Checksum:             %016llx\n", (unsigned long long)acc);
+
+    return 0;
+}
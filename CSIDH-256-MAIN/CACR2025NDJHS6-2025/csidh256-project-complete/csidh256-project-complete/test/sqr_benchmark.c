@@ -0,0 +1,86 @@
+// 平方/乘法/加法开销比（S/M、a/M）微基准，结果可用作 make params 的策略代价模型
+// 用法: make run-sqr-benchmark [FP_BACKEND=asm]
+
+#include "../src/fp256.h"
+#include "../src/rng.h"
+#include <stdio.h>
+
+#define ITERATIONS 1000000
+
+static uint64_t get_cycles(void) {
+#ifdef _WIN32
+    return __rdtsc();
+#else
+    uint32_t lo, hi;
+    asm volatile("rdtsc":"=a"(lo),"=d"(hi));
+    return ((uint64_t)hi << 32) | lo;
+#endif
+}
+
+// 生成随机域元素（x < p）
+static void random_element(fp *x) {
+    do {
+        randombytes(x->limbs, NUMBER_OF_WORDS * sizeof(uint64_t));
+        x->limbs[NUMBER_OF_WORDS - 1] &= g_mf.p.limbs[NUMBER_OF_WORDS - 1];
+    } while (fp_compare(x, &g_mf.p) >= 0);
+}
+
+int main() {
+    printf("=== CSIDH-256 Montgomery Squaring vs Multiplication ===\n\n");
+    
+    init_montgomery_field();
+    
+    fp a, b, x;
+    random_element(&a);
+    random_element(&b);
+    
+    // 正确性：fp_sqr(a) == fp_mul(a, a)
+    fp s, m;
+    fp_sqr(&s, &a);
+    fp_mul(&m, &a, &a);
+    if (fp_compare(&s, &m) != 0) {
+        printf("ERROR: fp_sqr(a) != fp_mul(a, a)\n");
+        return 1;
+    }
+    
+    // 依赖链测量延迟：每次运算的输入是上一次的输出
+    fp_copy(&x, &a);
+    for (int i = 0; i < 10000; i++) {
+        fp_mul(&x, &x, &b);  // 预热
+    }
+    
+    uint64_t c0 = get_cycles();
+    for (int i = 0; i < ITERATIONS; i++) {
+        fp_mul(&x, &x, &b);
+    }
+    uint64_t c1 = get_cycles();
+    double mul_cycles = (double)(c1 - c0) / ITERATIONS;
+    
+    c0 = get_cycles();
+    for (int i = 0; i < ITERATIONS; i++) {
+        fp_sqr(&x, &x);
+    }
+    c1 = get_cycles();
+    double sqr_cycles = (double)(c1 - c0) / ITERATIONS;
+    
+    c0 = get_cycles();
+    for (int i = 0; i < ITERATIONS; i++) {
+        fp_add(&x, &x, &b);
+    }
+    c1 = get_cycles();
+    double add_cycles = (double)(c1 - c0) / ITERATIONS;
+    
+    printf("Backend:        %s\n", FP256_BACKEND_NAME);
+    printf("Field repr:     %s\n", FP256_REPR_NAME);
+    printf("Iterations:     %d\n", ITERATIONS);
+    printf("fp_mul:         %.2f cycles/op\n", mul_cycles);
+    printf("fp_sqr:         %.2f cycles/op\n", sqr_cycles);
+    printf("fp_add:         %.2f cycles/op\n", add_cycles);
+    printf("S/M ratio:      %.3f\n", sqr_cycles / mul_cycles);
+    printf("a/M ratio:      %.3f\n", add_cycles / mul_cycles);
+    // 群作用策略的代价模型（tools/gen_csidh_params.c -c M,S,a）
+    printf("Strategy costs: PARAMS_ARGS=\"-c 1,%.2f,%.2f\"\n", sqr_cycles / mul_cycles, add_cycles / mul_cycles);
+    printf("Checksum:       %016llx\n", (unsigned long long)x.limbs[0]);
+    
+    return 0;
+}
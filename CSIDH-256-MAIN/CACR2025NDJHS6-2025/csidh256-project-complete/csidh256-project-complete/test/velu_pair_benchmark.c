@@ -0,0 +1,79 @@
+// Vélu、成对 Vélu 与 √élu 的逐个 l_i 对比：同源构造 + 一次双点求值（群作用中每次同源至少求值一对 T+ / T-），
+// 给出成对 Vélu 对所有更大的 l_i 都比 Vélu 快的最小 l（make params 的 -v 参数），
+// 以及 √élu 对所有更大的 l_i 都比另外两者快的最小 l（-s 参数，0 表示 √élu 在这些 l_i 上都不占优）
+// 用法: make run-velu-pair-benchmark [FP_BACKEND=asm]
+
+#include "../src/edwards256.h"
+#include "../src/rng.h"
+#include <stdio.h>
+#include <string.h>
+
+#define REPEATS 200
+
+static uint64_t get_cycles(void) {
+#ifdef _WIN32
+    return __rdtsc();
+#else
+    uint32_t lo, hi;
+    asm volatile("rdtsc":"=a"(lo),"=d"(hi));
+    return ((uint64_t)hi << 32) | lo;
+#endif
+}
+
+// 取 REPEATS 次中的最小值，排除中断和频率变化的干扰
+#define MIN_CYCLES(result, stmt) do { \
+        uint64_t best_ = UINT64_MAX; \
+        for (int r_ = 0; r_ < REPEATS; r_++) { \
+            uint64_t c0_ = get_cycles(); \
+            stmt; \
+            uint64_t c1_ = get_cycles(); \
+            if (c1_ - c0_ < best_) best_ = c1_ - c0_; \
+        } \
+        (result) = best_; \
+    } while (0)
+
+int main() {
+    printf("=== CSIDH-256 Velu vs paired Velu vs sqrt-Velu ===\n\n");
+
+    uint8_t seed[RNG_SEED_BYTES];
+    memset(seed, 0, sizeof(seed));
+    rng_seed(seed);
+
+    proj T[2], P, C, R[2];
+    proj K[(LARGE_L >> 1) + 1];
+    velu_pair_kernel Ks;
+    velu_sqrt_kernel Kq;
+    elligator(T[1], T[0], E);
+    yDBL(P, T[0], E);
+
+    printf("Backend: %s\n", FP256_BACKEND_NAME);
+    printf("  l   | Velu ISOG  EVAL2 | pair ISOG  EVAL2 | sqrt ISOG  EVAL2 | fastest\n");
+    uint32_t crossover = 0, crossover_sqrt = 0;
+    for (int i = N - 1; i >= 0; i--) {
+        if (L[i] < 5) continue;
+        uint64_t vi, ve, si, se, qi, qe;
+        MIN_CYCLES(vi, yISOG(K, C, P, E, (uint8_t)i));
+        MIN_CYCLES(ve, yEVAL2(R[0], R[1], T[0], T[1], K, (uint8_t)i));
+        MIN_CYCLES(si, yISOG_pair(&Ks, C, P, E, (uint8_t)i));
+        MIN_CYCLES(se, yEVAL2_pair(R[0], R[1], T[0], T[1], &Ks));
+        MIN_CYCLES(qi, yISOG_sqrt(&Kq, C, P, E, (uint8_t)i));
+        MIN_CYCLES(qe, yEVAL2_sqrt(R[0], R[1], T[0], T[1], &Kq));
+        int pair_wins = si + se < vi + ve;
+        int sqrt_wins = qi + qe < (pair_wins ? si + se : vi + ve);
+        printf(" %4u | %9llu %6llu | %9llu %6llu | %9llu %6llu | %s\n", L[i],
+               (unsigned long long)vi, (unsigned long long)ve,
+               (unsigned long long)si, (unsigned long long)se,
+               (unsigned long long)qi, (unsigned long long)qe,
+               sqrt_wins ? "sqrt" : pair_wins ? "pair" : "velu");
+        // L 是降序的，从小到大扫描：交叉点是之后一直由成对 Vélu 胜出的第一个 l
+        if (!pair_wins) crossover = 0;
+        else if (crossover == 0) crossover = L[i];
+        if (!sqrt_wins) crossover_sqrt = 0;
+        else if (crossover_sqrt == 0) crossover_sqrt = L[i];
+    }
+    printf("\nPaired Velu crossover: PARAMS_ARGS=\"-v %u\"\n", crossover);
+    printf("sqrt-Velu crossover:   PARAMS_ARGS=\"-s %u\"\n", crossover_sqrt);
+    printf("Checksum: %016llx\n", (unsigned long long)R[0][0].limbs[0]);
+
+    return 0;
+}
@@ -1,15 +1,20 @@
 // CSIDH-256 单元测试框架
-// 测试：field运算、Montgomery转换、单步isogeny
+// 测试：field运算、Montgomery转换、单步isogeny、多线程并发
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <stdint.h>
 #include <assert.h>
+#include <pthread.h>
 #include "src/fp256.h"
+#include "src/fp256_safegcd.h"
 #include "src/edwards256.h"
+#include "src/csidh_batch.h"
+#include "src/edwards256_mb.h"
 #include "src/csidh256_params.h"
 #include "src/param_validator.h"
+#include "src/prime_search.h"
 #include "src/rng.h"
 
 // 测试结果统计
@@ -29,6 +34,38 @@ static int tests_failed = 0;
         } \
     } while(0)
 
+// a 与 p 互素（默认的 p 是合数，随机元素不一定可逆）：二进制 gcd
+static int fp_is_unit(const fp *a) {
+    bigint256 u = *a, v = g_mf.p, t;
+    fp_canonicalize(&u);
+    if (fp_iszero(&u)) return 0;
+    for (;;) {
+        while (!(u.limbs[0] & 1)) {
+            for (int i = 0; i < NUMBER_OF_WORDS; i++) {
+                u.limbs[i] = (u.limbs[i] >> 1) | (i + 1 < NUMBER_OF_WORDS ? u.limbs[i + 1] << 63 : 0);
+            }
+        }
+        int c = bigint_compare(&u, &v);
+        if (c == 0) break;
+        if (c < 0) {
+            t = u;
+            u = v;
+            v = t;
+        }
+        bigint_sub(&u, &u, &v, &v);
+    }
+    return u.limbs[0] == 1 && u.limbs[1] == 0 && u.limbs[2] == 0 && u.limbs[3] == 0;
+}
+
+// fp_inv 是否为真正的逆：费马求逆 x^(p-2) 只在 p 为素数时成立（默认的 p 是合数）
+static int fp_inv_is_exact(void) {
+#ifdef FP256_INV_FERMAT
+    return bigint_is_probable_prime(&g_mf.p);
+#else
+    return 1;
+#endif
+}
+
 // ==================== Field运算测试 ====================
 
 void test_field_operations(void) {
@@ -79,13 +116,357 @@ void test_field_operations(void) {
     
     // 测试 fp_inv: a * a^(-1) = 1
     fp_random(&a);
-    while (fp_iszero(&a)) {
+    while (!fp_is_unit(&a)) {
         fp_random(&a);
     }
     fp_copy(&b, &a);
     fp_inv(&b);
     fp_mul(&c, &a, &b);
-    TEST_ASSERT(fp_compare(&c, &one) == 0, "a * a^(-1) = 1");
+    if (fp_inv_is_exact()) {
+        TEST_ASSERT(fp_compare(&c, &one) == 0, "a * a^(-1) = 1");
+    } else {
+        printf("  跳过 a * a^(-1) = 1：p 不是素数，费马求逆不成立\n");
+    }
+}
+
+// ==================== 域运算后端一致性测试 ====================
+
+// 生成随机的 x < p（普通表示）
+static void random_below_p(bigint256 *x) {
+    do {
+        randombytes(x->limbs, NUMBER_OF_WORDS * sizeof(uint64_t));
+        x->limbs[NUMBER_OF_WORDS - 1] &= g_mf.p.limbs[NUMBER_OF_WORDS - 1];
+    } while (bigint_compare(x, &g_mf.p) >= 0);
+}
+
+void test_field_backend(void) {
+    printf("\n=== 域运算后端一致性测试 ===\n");
+    
+    if (!g_mf_initialized) {
+        init_montgomery_field();
+    }
+    
+    // 将当前后端（C 或 FP_BACKEND=asm）与通用Montgomery参考实现对比
+    int mul_ok = 1, sqr_ok = 1, add_ok = 1, sub_ok = 1, cswap_ok = 1;
+    for (int t = 0; t < 1000; t++) {
+        bigint256 a, b, ref, sum;
+        fp c;
+        random_below_p(&a);
+        random_below_p(&b);
+        
+        mont_mul(&ref, &a, &b, &g_mf);
+        fp_mul(&c, &a, &b);
+        fp_canonicalize(&c);
+        if (bigint_compare(&c, &ref) != 0) mul_ok = 0;
+        
+        mont_mul(&ref, &a, &a, &g_mf);
+        fp_sqr(&c, &a);
+        fp_canonicalize(&c);
+        if (bigint_compare(&c, &ref) != 0) sqr_ok = 0;
+        
+        bigint_add(&sum, &a, &b);
+        if (bigint_compare(&sum, &g_mf.p) >= 0) {
+            bigint_sub(&sum, &sum, &g_mf.p, &g_mf.p);
+        }
+        fp_add(&c, &a, &b);
+        fp_canonicalize(&c);
+        if (bigint_compare(&c, &sum) != 0) add_ok = 0;
+        
+        fp_sub(&c, &sum, &b);
+        fp_canonicalize(&c);
+        if (bigint_compare(&c, &a) != 0) sub_ok = 0;
+        
+        fp x = a, y = b;
+        fp_cswap(&x, &y, 1);
+        if (bigint_compare(&x, &b) != 0 || bigint_compare(&y, &a) != 0) cswap_ok = 0;
+        fp_cswap(&x, &y, 0);
+        if (bigint_compare(&x, &b) != 0 || bigint_compare(&y, &a) != 0) cswap_ok = 0;
+    }
+    
+#ifndef FP256_TRADITIONAL
+    // 传统模乘后端不在Montgomery表示中，不与 mont_mul 对比
+    TEST_ASSERT(mul_ok, "fp_mul matches reference mont_mul");
+    TEST_ASSERT(sqr_ok, "fp_sqr matches reference mont_mul(a, a)");
+#else
+    (void)mul_ok;
+    (void)sqr_ok;
+#endif
+    TEST_ASSERT(add_ok, "fp_add matches reference (a + b) mod p");
+    TEST_ASSERT(sub_ok, "fp_sub inverts fp_add");
+    TEST_ASSERT(cswap_ok, "fp_cswap swaps only when c = 1");
+    
+    // 伪梅森约简（p = 2^k - c）必须与通用Montgomery约简逐位一致
+    // 按常量本身判断 p 是否为 2^k - c（0 < c < 2^32）：第 32..k-1 位全为 1 且低 32 位非 0
+    const uint64_t *pc = CSIDH256_P;
+    uint32_t pk = 256;
+    while (pk > 0 && !((pc[(pk - 1) / 64] >> ((pk - 1) % 64)) & 1)) pk--;
+    int is_pm = pk > 32 && (pc[0] & 0xFFFFFFFFULL) != 0;
+    for (uint32_t i = 32; is_pm && i < pk; i++) {
+        if (!((pc[i / 64] >> (i % 64)) & 1)) is_pm = 0;
+    }
+    uint64_t pm_c = (1ULL << 32) - (pc[0] & 0xFFFFFFFFULL);
+    if (is_pm) {
+        TEST_ASSERT(g_mf.redc_type == MONT_REDC_PSEUDO_MERSENNE && g_mf.pm_k == pk && g_mf.pm_c == pm_c,
+                    "p = 2^k - c detected as pseudo-Mersenne");
+    } else {
+        TEST_ASSERT(g_mf.redc_type == MONT_REDC_GENERIC, "p not of the form 2^k - c uses generic REDC");
+    }
+    mont_field generic = g_mf;
+    generic.redc_type = MONT_REDC_GENERIC;
+    int redc_ok = 1;
+    for (int t = 0; t < 1000; t++) {
+        bigint256 a, b, r1, r2;
+        random_below_p(&a);
+        random_below_p(&b);
+        mont_mul(&r1, &a, &b, &g_mf);
+        mont_mul(&r2, &a, &b, &generic);
+        if (bigint_compare(&r1, &r2) != 0) redc_ok = 0;
+        mont_sqr(&r1, &a, &g_mf);
+        mont_sqr(&r2, &a, &generic);
+        if (bigint_compare(&r1, &r2) != 0) redc_ok = 0;
+    }
+    TEST_ASSERT(redc_ok, "pseudo-Mersenne reduction matches generic reduction");
+    
+#ifndef FP256_TRADITIONAL
+    // 冗余表示（FP_LAZY=1）：输入取 [0, 2p) 中的另一个代表元 x + p，
+    // 规约后的结果必须与规约输入上的参考结果一致；fp_add_nr / fp_sub_nr 只作为乘法操作数
+    int lazy_ok = 1;
+    for (int t = 0; t < 1000; t++) {
+        bigint256 a, b, a2, b2, ref, sum, diff;
+        fp c, s;
+        random_below_p(&a);
+        random_below_p(&b);
+#ifdef FP256_LAZY
+        bigint_add(&a2, &a, &g_mf.p);
+        bigint_add(&b2, &b, &g_mf.p);
+#else
+        a2 = a;
+        b2 = b;
+#endif
+        bigint_add(&sum, &a, &b);
+        if (bigint_compare(&sum, &g_mf.p) >= 0) {
+            bigint_sub(&sum, &sum, &g_mf.p, &g_mf.p);
+        }
+        bigint_sub(&diff, &a, &b, &g_mf.p);
+        
+        mont_mul(&ref, &a, &b, &g_mf);
+        fp_mul(&c, &a2, &b2);
+        if (fp_compare(&c, &ref) != 0) lazy_ok = 0;
+        
+        mont_sqr(&ref, &a, &g_mf);
+        fp_sqr(&c, &a2);
+        if (fp_compare(&c, &ref) != 0) lazy_ok = 0;
+        
+        fp_add(&c, &a2, &b2);
+        if (fp_compare(&c, &sum) != 0) lazy_ok = 0;
+        fp_sub(&c, &a2, &b2);
+        if (fp_compare(&c, &diff) != 0) lazy_ok = 0;
+        
+        mont_mul(&ref, &sum, &b, &g_mf);
+        fp_add_nr(&s, &a2, &b2);
+        fp_mul(&c, &s, &b2);
+        if (fp_compare(&c, &ref) != 0) lazy_ok = 0;
+        
+        mont_mul(&ref, &a, &diff, &g_mf);
+        fp_sub_nr(&s, &a2, &b2);
+        fp_mul(&c, &a2, &s);
+        if (fp_compare(&c, &ref) != 0) lazy_ok = 0;
+    }
+    TEST_ASSERT(lazy_ok, "redundant-form inputs and unreduced add/sub give reduced results (" FP256_REPR_NAME ")");
+#endif
+    
+    // 乘积和（一次约简）与分开的 fp_mul + fp_add / fp_sub 结果一致
+    int mul2_ok = 1;
+    for (int t = 0; t < 1000; t++) {
+        fp a, b, c, d, x, y, ref_s, ref_t, s, u;
+        random_below_p(&a);
+        random_below_p(&b);
+        random_below_p(&c);
+        random_below_p(&d);
+        if (t == 0) {
+            // 最大输入：a*b - c*d 取到最负的值
+            set_zero(&a);
+            bigint_sub(&c, &g_mf.p, &(bigint256){{1, 0, 0, 0}}, &g_mf.p);
+            d = c;
+        }
+        fp_mul(&x, &a, &b);
+        fp_mul(&y, &c, &d);
+        fp_add(&ref_s, &x, &y);
+        fp_sub(&ref_t, &x, &y);
+        
+        fp_mul2_add(&s, &a, &b, &c, &d);
+        if (fp_compare(&s, &ref_s) != 0) mul2_ok = 0;
+        fp_mul2_sub(&s, &a, &b, &c, &d);
+        if (fp_compare(&s, &ref_t) != 0) mul2_ok = 0;
+        fp_mul2_addsub(&s, &u, &a, &b, &c, &d);
+        if (fp_compare(&s, &ref_s) != 0 || fp_compare(&u, &ref_t) != 0) mul2_ok = 0;
+        // 输出与输入重叠
+        fp_mul2_addsub(&a, &c, &a, &b, &c, &d);
+        if (fp_compare(&a, &ref_s) != 0 || fp_compare(&c, &ref_t) != 0) mul2_ok = 0;
+    }
+    TEST_ASSERT(mul2_ok, "fp_mul2_add / fp_mul2_sub / fp_mul2_addsub match separate mul + add/sub");
+}
+
+// ==================== 加法链幂运算测试 ====================
+
+// 参考实现：从高位到低位的平方-乘（Montgomery域，起点为 R mod p）
+static void pow_reference(bigint256 *out, const bigint256 *x, const bigint256 *e) {
+    bigint256 r = R_mod_p;
+    for (int i = NUMBER_OF_WORDS * 64 - 1; i >= 0; i--) {
+        mont_sqr(&r, &r, &g_mf);
+        if ((e->limbs[i / 64] >> (i % 64)) & 1) {
+            mont_mul(&r, &r, x, &g_mf);
+        }
+    }
+    *out = r;
+}
+
+void test_exponent_chains(void) {
+    printf("\n=== 加法链幂运算测试 ===\n");
+    
+    if (!g_mf_initialized) {
+        init_montgomery_field();
+    }
+    
+    // p - 2、(p-1)/2 以及一个零散的指数
+    bigint256 exps[3];
+    bigint256 two = {{2, 0, 0, 0}};
+    bigint_sub(&exps[0], &g_mf.p, &two, &two);
+    exps[1] = p_minus_1_halves;
+    exps[2] = (bigint256){{0x0123456789ABCDEFULL, 0xF0F0F00F0FF00001ULL, 0, 0x0000000100000000ULL}};
+    
+    int ok = 1, built = 1;
+    fp_exp_chain chain;
+    for (int k = 0; k < 3; k++) {
+        if (!fp_exp_chain_build(&chain, &exps[k])) {
+            built = 0;
+            continue;
+        }
+        if (k == 0) {
+            // 平方-乘需要 popcount(e) - 1 次乘法；加法链按"连续1段"合并，不应更多
+            int ones = 0, runs = 0, prev = 0;
+            for (int i = 0; i < 256; i++) {
+                int bit = (exps[k].limbs[i / 64] >> (i % 64)) & 1;
+                ones += bit;
+                runs += bit && !prev;
+                prev = bit;
+            }
+            printf("  p-2 加法链: %d 次乘法, %d 次平方（%d 个1，%d 段）\n", chain.n_mul, chain.n_sqr, ones, runs);
+            TEST_ASSERT(chain.n_mul <= ones - 1, "p-2 chain needs no more multiplications than square-and-multiply");
+        }
+        for (int t = 0; t < 20; t++) {
+            bigint256 x, ref;
+            fp out;
+            random_below_p(&x);
+            pow_reference(&ref, &x, &exps[k]);
+            fp_exp_chain_run(&out, &x, &chain);
+            if (fp_compare(&out, &ref) != 0) ok = 0;
+        }
+    }
+    TEST_ASSERT(built, "fp_exp_chain_build succeeds");
+    
+#ifndef FP256_TRADITIONAL
+    TEST_ASSERT(ok, "fp_exp_chain_run matches square-and-multiply");
+    
+    bigint256 x, ref;
+    fp y;
+    random_below_p(&x);
+    y = x;
+    fp_inv_fermat(&y);
+    pow_reference(&ref, &x, &exps[0]);
+    TEST_ASSERT(fp_compare(&y, &ref) == 0, "fp_inv_fermat uses x^(p-2)");
+#else
+    (void)ok;
+#endif
+}
+
+// ==================== safegcd 测试 ====================
+
+// 参考实现：二进制Jacobi算法（变时间），n 为奇数
+static int jacobi_reference(bigint256 a, bigint256 n) {
+    int t = 1;
+    bigint256 zero = {{0, 0, 0, 0}};
+    while (bigint_compare(&a, &zero) != 0) {
+        while ((a.limbs[0] & 1) == 0) {
+            for (int i = 0; i < NUMBER_OF_WORDS; i++) {
+                uint64_t next = (i + 1 < NUMBER_OF_WORDS) ? a.limbs[i + 1] : 0;
+                a.limbs[i] = (a.limbs[i] >> 1) | (next << 63);
+            }
+            uint64_t r = n.limbs[0] & 7;
+            if (r == 3 || r == 5) t = -t;
+        }
+        if (bigint_compare(&a, &n) < 0) {
+            bigint256 tmp = a;
+            a = n;
+            n = tmp;
+            if ((a.limbs[0] & 3) == 3 && (n.limbs[0] & 3) == 3) t = -t;
+        }
+        bigint_sub(&a, &a, &n, &n);
+    }
+    bigint256 one = {{1, 0, 0, 0}};
+    return (bigint_compare(&n, &one) == 0) ? t : 0;
+}
+
+void test_safegcd(void) {
+    printf("\n=== safegcd 模逆 / Jacobi符号测试 ===\n");
+    
+    if (!g_mf_initialized) {
+        init_montgomery_field();
+    }
+    
+    int inv_ok = 1, jac_ok = 1, coprime = 0;
+    for (int t = 0; t < 200; t++) {
+        bigint256 x;
+        random_below_p(&x);
+        
+        int j = fp_jacobi_bingcd(&x);
+        if (j != jacobi_reference(x, g_mf.p)) jac_ok = 0;
+        
+        // p 不一定是素数，只检查与 p 互素（Jacobi符号非0）的元素
+        if (j != 0) {
+            fp y = x, prod;
+            coprime++;
+            fp_inv_safegcd(&y);
+            fp_mul(&prod, &x, &y);
+            if (fp_compare(&prod, &R_mod_p) != 0) inv_ok = 0;
+        }
+    }
+    
+    TEST_ASSERT(jac_ok, "fp_jacobi_bingcd matches binary Jacobi reference");
+#ifndef FP256_TRADITIONAL
+    TEST_ASSERT(coprime > 0 && inv_ok, "x * fp_inv_safegcd(x) = 1 (Montgomery one)");
+#else
+    (void)inv_ok;
+#endif
+    
+    // 批量求逆与逐个求逆结果一致，0 保持为 0 且不影响其它元素
+    // （p 不一定是素数，非0元素同样取与 p 互素的）
+    fp xs[9], ys[9];
+    for (int i = 0; i < 9; i++) {
+        do {
+            random_below_p(&xs[i]);
+        } while (fp_jacobi_bingcd(&xs[i]) == 0);
+    }
+    set_zero(&xs[4]);
+    for (int i = 0; i < 9; i++) {
+        ys[i] = xs[i];
+        if (!fp_iszero(&ys[i])) fp_inv(&ys[i]);
+    }
+    fp_inv_batch(xs, 9);
+    int batch_ok = 1;
+    for (int i = 0; i < 9; i++) {
+        if (fp_compare(&xs[i], &ys[i]) != 0) batch_ok = 0;
+    }
+#ifndef FP256_TRADITIONAL
+    // 批量求逆依赖 x * x^(p-2) = 1，p 为合数时不成立，与逐个求逆的结果不同
+    if (fp_inv_is_exact()) {
+        TEST_ASSERT(batch_ok, "fp_inv_batch matches element-wise fp_inv (including 0)");
+    } else {
+        printf("  跳过 fp_inv_batch 对比：p 不是素数，费马求逆不成立\n");
+    }
+#else
+    (void)batch_ok;
+#endif
 }
 
 // ==================== Montgomery转换测试 ====================
@@ -125,8 +506,736 @@ void test_montgomery_conversion(void) {
     }
     
     to_mont(&one_mont, &one_normal, &g_mf);
-    TEST_ASSERT(bigint_compare(&one_mont, &R_squared_mod_p) == 0,
-                "1 in Montgomery = R^2 mod p");
+    TEST_ASSERT(bigint_compare(&one_mont, &R_mod_p) == 0,
+                "1 in Montgomery = R mod p");
+
+    // R^2 mod p 是 R 的Montgomery形式
+    bigint256 r_mont;
+    to_mont(&r_mont, &R_mod_p, &g_mf);
+    TEST_ASSERT(bigint_compare(&r_mont, &R_squared_mod_p) == 0,
+                "R in Montgomery = R^2 mod p");
+}
+
+// ==================== 构建时常量测试 ====================
+
+// 构建时生成的常量（src/fp256_constants.h）与运行时的推导结果一致
+void test_baked_constants(void) {
+    printf("\n=== 构建时常量测试 ===\n");
+
+    mont_field mf;
+    mont_field_init(&mf);
+    int mf_ok = bigint_compare(&mf.p, &g_mf.p) == 0 &&
+                bigint_compare(&mf.p_inv, &g_mf.p_inv) == 0 &&
+                bigint_compare(&mf.r_squared, &g_mf.r_squared) == 0 &&
+                mf.redc_type == g_mf.redc_type && mf.pm_k == g_mf.pm_k && mf.pm_c == g_mf.pm_c &&
+                memcmp(mf.p_squared_x4, g_mf.p_squared_x4, sizeof(mf.p_squared_x4)) == 0 &&
+                bigint_compare(&mf.p, &p) == 0;
+    TEST_ASSERT(mf_ok, "g_mf matches mont_field_init");
+
+    // R = 2^256 mod p，R^2 = 2^512 mod p（都按定义加倍得到）
+    bigint256 r = {{1, 0, 0, 0}}, r2;
+    for (int i = 0; i < 256; i++) {
+        bigint_add(&r, &r, &r);
+        if (bigint_compare(&r, &mf.p) >= 0) {
+            bigint_sub(&r, &r, &mf.p, &mf.p);
+        }
+    }
+    r2 = r;
+    for (int i = 0; i < 256; i++) {
+        bigint_add(&r2, &r2, &r2);
+        if (bigint_compare(&r2, &mf.p) >= 0) {
+            bigint_sub(&r2, &r2, &mf.p, &mf.p);
+        }
+    }
+    TEST_ASSERT(bigint_compare(&r, &R_mod_p) == 0 && bigint_compare(&r2, &R_squared_mod_p) == 0,
+                "R mod p and R^2 mod p match runtime derivation");
+
+    bigint256 twice, one = {{1, 0, 0, 0}};
+    bigint_add(&twice, &p_minus_1_halves, &p_minus_1_halves);
+    bigint_add(&twice, &twice, &one);
+    TEST_ASSERT(bigint_compare(&twice, &mf.p) == 0, "2 * (p-1)/2 + 1 = p");
+
+    int small_ok = 1;
+    bigint256 k_r = {{0, 0, 0, 0}};
+    for (int k = 0; k < FP256_MONT_SMALL_COUNT; k++) {
+        if (bigint_compare(&k_r, &fp_mont_small[k]) != 0) small_ok = 0;
+        bigint_add(&k_r, &k_r, &r);
+        if (bigint_compare(&k_r, &mf.p) >= 0) {
+            bigint_sub(&k_r, &k_r, &mf.p, &mf.p);
+        }
+    }
+    TEST_ASSERT(small_ok, "fp_mont_small[k] = k * R mod p");
+
+    // E: y^2 = x^3 + x，Edwards形式 (a, a - d) = (1, 2)（d = 0 的 (1, 1) 是奇异曲线）
+    bigint256 e_a, e_c, two = {{2, 0, 0, 0}};
+    mont_mul(&e_a, &one, &R_squared_mod_p, &mf);
+    mont_mul(&e_c, &two, &R_squared_mod_p, &mf);
+    TEST_ASSERT(bigint_compare(&E[0], &e_a) == 0 && bigint_compare(&E[1], &e_c) == 0,
+                "Public curve E = (1, 2) in Montgomery form");
+}
+
+// ==================== 参数集一致性测试 ====================
+
+// csidh256_params.h（tools/gen_csidh_params.c 生成）中的派生表与 L、B 一致
+void test_prime_search(void) {
+    printf("\n=== CSIDH素数搜索测试 ===\n");
+
+    // 2^127 - 1、2^255 - 19 是素数；2^253 - 1 = (2^11 - 1) * ... 是合数；
+    // 3215031751 = 151 * 751 * 28351 是以2为底的强伪素数（必须由 Lucas 部分排除）
+    bigint256 m127 = {{~0ULL, 0x7FFFFFFFFFFFFFFFULL, 0, 0}};
+    bigint256 p25519 = {{0xFFFFFFFFFFFFFFEDULL, ~0ULL, ~0ULL, 0x7FFFFFFFFFFFFFFFULL}};
+    bigint256 m253 = {{~0ULL, ~0ULL, ~0ULL, 0x1FFFFFFFFFFFFFFFULL}};
+    bigint256 spsp2 = {{3215031751ULL, 0, 0, 0}};
+    TEST_ASSERT(bigint_is_probable_prime(&m127) && bigint_is_probable_prime(&p25519),
+                "BPSW accepts 2^127 - 1 and 2^255 - 19");
+    TEST_ASSERT(!bigint_is_probable_prime(&m253) && !bigint_is_probable_prime(&spsp2),
+                "BPSW rejects 2^253 - 1 and a base-2 strong pseudoprime");
+
+    // 搜索到的素数：253 位，p ≡ 3 (mod 8)（L 含 2 时 p ≡ 7 (mod 8)），所有 l_i | (p + 1)/4
+    bigint256 p;
+    compute_valid_csidh256_prime(p.limbs);
+    int shape_ok = (p.limbs[3] >> 60) == 1 && (p.limbs[0] & 7) == (CSURF ? 7 : 3);
+    for (int i = 0; i < N; i++) {
+        // p ≡ -1 (mod l_i)；(p + 1)/4 的整除性由 p 的模 8 形状保证
+        if (bigint_mod_small(&p, L[i]) != L[i] - 1) shape_ok = 0;
+    }
+    TEST_ASSERT(bigint_is_probable_prime(&p) && shape_ok,
+                "compute_valid_csidh256_prime returns a 253-bit prime with l_i | (p+1)/4");
+
+    // 参数检查读取的是 params.h 中生成的 p（不是硬编码的素数）
+    TEST_ASSERT(validate_csidh256_params() && csidh_params_valid,
+                "validate_csidh256_params accepts the generated CSIDH256_P");
+}
+
+void test_drbg(void) {
+    printf("\n=== 每线程 DRBG 测试 ===\n");
+
+    // 全零种子：第一次生成的块就是 RFC 8439 A.1 的 ChaCha20 测试向量 #1，
+    // 前32字节成为新密钥，输出从第32字节开始
+    static const uint8_t expect[16] = {
+        0xda, 0x41, 0x59, 0x7c, 0x51, 0x57, 0x48, 0x8d, 0x77, 0x24, 0xe0, 0x3f, 0xb8, 0xd8, 0x4a, 0x37
+    };
+    uint8_t seed[RNG_SEED_BYTES] = {0};
+    uint8_t a[1000], b[1000];
+    rng_seed(seed);
+    randombytes(a, sizeof(a));
+    TEST_ASSERT(memcmp(a, expect, sizeof(expect)) == 0, "DRBG output matches the ChaCha20 test vector");
+
+    // 同一种子、不同的请求切分得到相同的字节流
+    rng_seed(seed);
+    randombytes(b, 1);
+    randombytes(b + 1, 37);
+    randombytes(b + 38, sizeof(b) - 38);
+    TEST_ASSERT(memcmp(a, b, sizeof(a)) == 0, "Deterministic mode is reproducible across call sizes");
+
+    // 重新从系统取种子后退出确定性模式
+    rng_reseed();
+    randombytes(b, sizeof(b));
+    TEST_ASSERT(memcmp(a, b, sizeof(a)) != 0, "rng_reseed leaves deterministic mode");
+}
+
+void test_seed_keys(void) {
+    printf("\n=== 紧凑私钥（种子展开）测试 ===\n");
+
+    uint8_t master[SEED_BYTES], seed[SEED_BYTES], seed2[SEED_BYTES];
+    uint8_t key[N], key2[N];
+    memset(master, 0x5a, sizeof(master));
+
+    // 同一种子展开出相同的指数向量，主种子派生是确定的且不同 index 给出不同种子
+    seed_derive(seed, master, 0);
+    seed_derive(seed2, master, 0);
+    key_from_seed(key, seed);
+    key_from_seed(key2, seed2);
+    int same = memcmp(seed, seed2, SEED_BYTES) == 0 && memcmp(key, key2, N) == 0;
+    seed_derive(seed2, master, 1);
+    TEST_ASSERT(same && memcmp(seed, seed2, SEED_BYTES) != 0, "Seed derivation and expansion are deterministic");
+
+    // 指数在 [-B, B] 中且与 B 同奇偶；B + 1 个取值都会出现
+    int range_ok = 1, hits[64] = {0};
+    for (uint64_t idx = 0; idx < 512; idx++) {
+        seed_derive(seed, master, idx);
+        key_from_seed(key, seed);
+        for (int i = 0; i < N; i++) {
+            int e = (2 * (key[i] & 0x1) - 1) * (key[i] >> 1);
+            if (e < -B[i] || e > B[i] || ((e - B[i]) & 1) != 0) range_ok = 0;
+        }
+        hits[((2 * (key[0] & 0x1) - 1) * (key[0] >> 1) + B[0]) / 2]++;
+    }
+    int all_hit = 1;
+    for (int v = 0; v <= B[0]; v++) {
+        if (hits[v] == 0) all_hit = 0;
+    }
+    TEST_ASSERT(range_ok && all_hit, "Expanded exponents cover exactly {-B, -B+2, ..., B}");
+
+    proj C1, C2;
+    key_from_seed(key, seed);
+    action_evaluation(C1, key, E);
+    action_evaluation_seed(C2, seed, E);
+    TEST_ASSERT(areEqual(C1, C2), "action_evaluation_seed matches action_evaluation on the expanded key");
+}
+
+void test_dual_point_kernels(void) {
+    printf("\n=== T+ / T- 双点交错运算测试 ===\n");
+
+    proj T[2], S[2], D[2];
+    elligator(T[1], T[0], E);
+
+    // yDBL2 / yMUL2 与逐点调用的运算序列相同，结果逐字节一致（包括原地调用）
+    int mul_ok = 1;
+    yDBL(S[0], T[0], E);
+    yDBL(S[1], T[1], E);
+    point_copy(D[0], T[0]);
+    point_copy(D[1], T[1]);
+    yDBL2(D[0], D[1], D[0], D[1], E);
+    if (memcmp(S, D, sizeof(S)) != 0) mul_ok = 0;
+    for (uint8_t i = 0; i < N; i += 5) {
+        yMUL(S[0], S[0], E, i);
+        yMUL(S[1], S[1], E, i);
+        yMUL2(D[0], D[1], D[0], D[1], E, i);
+        if (memcmp(S, D, sizeof(S)) != 0) mul_ok = 0;
+    }
+    TEST_ASSERT(mul_ok, "yDBL2 / yMUL2 match per-point yDBL / yMUL");
+
+    // yEVAL2 与两次 yEVAL 相同
+    proj K[(LARGE_L >> 1) + 1], C;
+    uint8_t li = 8;
+    yISOG(K, C, S[0], E, li);
+    yEVAL(S[0], T[0], K, li);
+    yEVAL(S[1], T[1], K, li);
+    yEVAL2(D[0], D[1], T[0], T[1], K, li);
+    TEST_ASSERT(memcmp(S, D, sizeof(S)) == 0, "yEVAL2 matches two yEVAL calls");
+}
+
+// Q = [k]P，k 是 256 位整数（Montgomery 阶梯，差为 P）
+static void ladder_256(proj Q, const proj P, const proj A, const uint64_t k[4]) {
+    proj R0, R1, T;
+    int top = 255;
+    while (top > 0 && !((k[top >> 6] >> (top & 63)) & 1)) top--;
+    point_copy(R0, P);
+    yDBL(R1, P, A);
+    for (int b = top - 1; b >= 0; b--) {
+        yADD(T, R1, R0, P);
+        if ((k[b >> 6] >> (b & 63)) & 1) {
+            point_copy(R0, T);
+            yDBL(R1, R1, A);
+        } else {
+            point_copy(R1, T);
+            yDBL(R0, R0, A);
+        }
+    }
+    point_copy(Q, R0);
+}
+
+// 射影相等：P0 * Q1 == P1 * Q0（不依赖 areEqual，传统后端同样适用）
+static int proj_equal(const proj P, const proj Q) {
+    fp a, b;
+    fp_mul(&a, &P[0], &Q[1]);
+    fp_mul(&b, &P[1], &Q[0]);
+    fp_canonicalize(&a);
+    fp_canonicalize(&b);
+    return memcmp(&a, &b, sizeof(a)) == 0;
+}
+
+void test_velu_pair(void) {
+    printf("\n=== 成对 Vélu / √élu 测试 ===\n");
+
+    // yEVAL2_pair / yEVAL2_sqrt 与两次 yEVAL_pair / yEVAL_sqrt 相同
+    proj T[2], S[2], D[2], C;
+    velu_pair_kernel Ks;
+    velu_sqrt_kernel Kq;
+    elligator(T[1], T[0], E);
+    yISOG_pair(&Ks, C, T[0], E, 0);
+    yEVAL_pair(S[0], T[0], &Ks);
+    yEVAL_pair(S[1], T[1], &Ks);
+    yEVAL2_pair(D[0], D[1], T[0], T[1], &Ks);
+    TEST_ASSERT(memcmp(S, D, sizeof(S)) == 0, "yEVAL2_pair matches two yEVAL_pair calls");
+    yISOG_sqrt(&Kq, C, T[0], E, 0);
+    yEVAL_sqrt(S[0], T[0], &Kq);
+    yEVAL_sqrt(S[1], T[1], &Kq);
+    yEVAL2_sqrt(D[0], D[1], T[0], T[1], &Kq);
+    TEST_ASSERT(memcmp(S, D, sizeof(S)) == 0, "yEVAL2_sqrt matches two yEVAL_sqrt calls");
+
+    // 阶恰好为 l 的核点上，成对 Vélu、√élu 与 Vélu 给出同一条像曲线和同一个像点。
+    // 核点 [(p + 1) / l]T 只在 l | p + 1 时存在（当前 p 不满足时跳过）
+    proj A;
+    uint8_t key[N];
+    random_key(key);
+    action_evaluation(A, key, E);
+    int tested = 0, match = 1, match_sqrt = 1;
+    for (uint8_t i = 0; i < N; i++) {
+        if (L[i] < 5) continue;
+        uint64_t k[4];
+        __uint128_t r = 0;
+        int carry = 1;
+        for (int w = 0; w < 4; w++) {
+            k[w] = g_mf.p.limbs[w] + carry;
+            carry = carry && k[w] == 0;
+        }
+        for (int w = 3; w >= 0; w--) {
+            r = (r << 64) | k[w];
+            k[w] = (uint64_t)(r / L[i]);
+            r %= L[i];
+        }
+        if (r != 0) continue;
+        for (int attempt = 0; attempt < 4; attempt++) {
+            proj P, Q, Pk[(LARGE_L >> 1) + 1], C0, C1, C2, R0, R1, U0, U1, W0, W1;
+            elligator(T[1], T[0], A);
+            ladder_256(P, T[attempt & 1], A, k);
+            yMUL(Q, P, A, i);
+            if (isinfinity(P) || !isinfinity(Q)) continue;
+            yISOG(Pk, C0, P, A, i);
+            yEVAL2(R0, R1, T[0], T[1], Pk, i);
+            yISOG_pair(&Ks, C1, P, A, i);
+            yEVAL2_pair(U0, U1, T[0], T[1], &Ks);
+            if (!proj_equal(C0, C1) || !proj_equal(R0, U0) || !proj_equal(R1, U1)) match = 0;
+            yISOG_sqrt(&Kq, C2, P, A, i);
+            yEVAL2_sqrt(W0, W1, T[0], T[1], &Kq);
+            if (!proj_equal(C0, C2) || !proj_equal(R0, W0) || !proj_equal(R1, W1)) match_sqrt = 0;
+            tested++;
+            break;
+        }
+    }
+    if (tested > 0) {
+        TEST_ASSERT(match, "yISOG_pair / yEVAL2_pair agree with Velu on order-l kernels");
+        TEST_ASSERT(match_sqrt, "yISOG_sqrt / yEVAL2_sqrt agree with Velu on order-l kernels");
+    } else {
+        printf("  跳过：p + 1 不能被任何 l_i >= 5 整除\n");
+    }
+}
+
+// 通用的 Vélu 同源构造（循环 + 平方-乘法求 a^l、d^l），作为逐 l_i 特化版本的参照
+static void reference_isog(proj C, const proj P, const proj A, uint32_t l) {
+    proj Pk[(LARGE_L >> 1) + 1];
+    uint32_t s = l >> 1;
+    fp By, Bz, a, d, al, dl, t;
+    fp_copy(&By, &P[0]);
+    fp_copy(&Bz, &P[1]);
+    point_copy(Pk[0], P);
+    yDBL(Pk[1], P, A);
+    for (uint32_t j = 2; j < s; j++) {
+        fp_mul(&By, &By, &Pk[j - 1][0]);
+        fp_mul(&Bz, &Bz, &Pk[j - 1][1]);
+        yADD(Pk[j], Pk[j - 1], P, Pk[j - 2]);
+    }
+    if (l != 3) {
+        fp_mul(&By, &By, &Pk[s - 1][0]);
+        fp_mul(&Bz, &Bz, &Pk[s - 1][1]);
+    }
+    fp_copy(&a, &A[0]);
+    fp_sub(&d, &A[0], &A[1]);
+    fp_copy(&al, &a);
+    fp_copy(&dl, &d);
+    int top = 31;
+    while (!((l >> top) & 1)) top--;
+    for (int b = top - 1; b >= 0; b--) {
+        fp_sqr(&al, &al);
+        fp_sqr(&dl, &dl);
+        if ((l >> b) & 1) {
+            fp_mul(&al, &al, &a);
+            fp_mul(&dl, &dl, &d);
+        }
+    }
+    for (int j = 0; j < 3; j++) {
+        fp_sqr(&By, &By);
+        fp_sqr(&Bz, &Bz);
+    }
+    fp_mul(&C[0], &al, &Bz);
+    fp_mul(&t, &dl, &By);
+    fp_sub(&C[1], &C[0], &t);
+}
+
+// 参照实现：逐个同源的教科书式群作用（不分批，不用策略、预计算表、成对 Vélu 和分组余因子链），
+// 每一步取新的 Elligator 点，乘以 (p + 1) / l_i 得到阶为 l_i 的核点，再用通用的 yISOG
+static void reference_action(proj C, const uint8_t key[], const proj A) {
+    point_copy(C, A);
+    for (uint8_t i = 0; i < N; i++) {
+        if (RADICAL[i]) continue;
+        int e = (2 * (key[i] & 0x1) - 1) * (key[i] >> 1);
+        uint64_t k[4];
+        __uint128_t r = 0;
+        int carry = 1;
+        for (int w = 0; w < 4; w++) {
+            k[w] = g_mf.p.limbs[w] + carry;
+            carry = carry && k[w] == 0;
+        }
+        for (int w = 3; w >= 0; w--) {
+            r = (r << 64) | k[w];
+            k[w] = (uint64_t)(r / L[i]);
+            r %= L[i];
+        }
+        while (e != 0) {
+            proj T[2], P, K[(LARGE_L >> 1) + 1];
+            // 正指数用 T+，负指数用 T-（与 action_evaluation 中 ec & 1 的选择相同）
+            elligator(T[1], T[0], C);
+            ladder_256(P, T[e > 0], C, k);
+            if (isinfinity(P)) continue;
+            yISOG(K, C, P, C, i);
+            e += (e > 0) ? -1 : 1;
+        }
+    }
+    action_radical(C, key, C);
+}
+
+void test_action_reference(void) {
+    printf("\n=== 群作用与参照实现对比 ===\n");
+
+    // 从E（第一轮用预计算表）和从另一条曲线（全部走 Elligator）出发，SIMBA + 最优策略 + 成对 Vélu
+    // + 余因子的 action_evaluation 与逐个同源的参照实现给出同一条曲线
+    uint8_t key[N];
+    proj A, C0, C1;
+    random_key(key);
+    action_evaluation(A, key, E);
+    int match = 1, moved = 1;
+    for (int it = 0; it < 2; it++) {
+        random_key(key);
+        const proj *start = it ? &A : &E;
+        action_evaluation(C0, key, *start);
+        reference_action(C1, key, *start);
+        if (!proj_equal(C0, C1)) match = 0;
+        if (proj_equal(C0, *start)) moved = 0;
+    }
+    TEST_ASSERT(match && moved, "action_evaluation matches a one-isogeny-at-a-time reference");
+}
+
+void test_specialized_isogenies(void) {
+    printf("\n=== 逐 l_i 特化同源测试 ===\n");
+
+    // 分派表中每个下标对应正确的 l_i，固定加法链与平方-乘法给出同一条像曲线；
+    // 曲线取群作用的结果（E 的 d = 0，d^l 检查不到）
+    proj A, T[2], C0, C1, Pk[(LARGE_L >> 1) + 1], S[2], D[2];
+    uint8_t key[N];
+    random_key(key);
+    action_evaluation(A, key, E);
+    elligator(T[1], T[0], A);
+    int isog_ok = 1, eval_ok = 1;
+    for (uint8_t i = 0; i < N; i++) {
+        reference_isog(C0, T[0], A, L[i]);
+        yISOG(Pk, C1, T[0], A, i);
+        if (!proj_equal(C0, C1)) isog_ok = 0;
+        yEVAL(S[0], T[0], Pk, i);
+        yEVAL(S[1], T[1], Pk, i);
+        yEVAL2(D[0], D[1], T[0], T[1], Pk, i);
+        if (memcmp(S, D, sizeof(S)) != 0) eval_ok = 0;
+    }
+    TEST_ASSERT(isog_ok, "specialized yISOG matches the generic Velu codomain for every l_i");
+    TEST_ASSERT(eval_ok, "specialized yEVAL2 matches two yEVAL calls for every l_i");
+}
+
+#if RADICAL_MAX_L > 0 || CSURF
+// [k]P，P 是 x³ + Ax² + x 为平方（square = 1，曲线上）或非平方（square = 0，扭曲线上）的随机点；
+// 不用 Elligator，它在 A = 0 时退化
+static void radical_kernel(proj K, const proj A, const uint64_t k[4], uint8_t square) {
+    fp inv, Am, x, f;
+    proj P;
+    fp_copy(&inv, &A[1]);
+    fp_inv(&inv);
+    fp_add(&Am, &A[0], &A[0]);
+    fp_sub(&Am, &Am, &A[1]);
+    fp_add(&Am, &Am, &Am);
+    fp_mul(&Am, &Am, &inv);
+    do {
+        do {
+            fp_random(&x);
+            fp_add(&f, &x, &Am);
+            fp_mul(&f, &f, &x);
+            fp_add(&f, &f, fp_one());
+            fp_mul(&f, &f, &x);
+        } while (fp_iszero(&f) || fp_issquare(&f) != square);
+        fp_sub(&P[0], &x, fp_one());
+        fp_add(&P[1], &x, fp_one());
+        ladder_256(K, P, A, k);
+    } while (isinfinity(K));
+}
+#endif
+
+void test_radical_isogenies(void) {
+    printf("\n=== 根式同源测试 ===\n");
+#if RADICAL_MAX_L > 0
+    // 每个根式 l_i 的 yRADICAL 与逐步 Vélu 得到同一条像曲线：正指数的核取曲线上的 l 阶点，
+    // 负指数取扭曲线上的。起点用 y² = x³ + x，即 (1 : 2)
+    proj A, C0, C1, K, Pk[(LARGE_L >> 1) + 1];
+    fp_copy(&A[0], fp_one());
+    fp_copy(&A[1], fp_small(2));
+    const int8_t exps[] = {1, -1, 2, -2, 0};
+    int ok = 1, tested = 0;
+    for (uint8_t i = 0; i < N; i++) {
+        if (!RADICAL[i]) continue;
+        uint64_t k[4];
+        __uint128_t carry = 1, rem = 0;
+        for (int w = 0; w < 4; w++) {
+            carry += p.limbs[w];
+            k[w] = (uint64_t)carry;
+            carry >>= 64;
+        }
+        for (int w = 3; w >= 0; w--) {
+            __uint128_t cur = (rem << 64) | k[w];
+            k[w] = (uint64_t)(cur / L[i]);
+            rem = cur % L[i];
+        }
+        for (size_t j = 0; j < sizeof(exps); j++) {
+            int8_t e = exps[j];
+            point_copy(C0, A);
+            for (int s = 0; s < (e < 0 ? -e : e); s++) {
+                radical_kernel(K, C0, k, e > 0);
+                yISOG(Pk, C0, K, C0, i);
+            }
+            yRADICAL(C1, A, i, (uint8_t)(((e < 0 ? -e : e) << 1) | (e >= 0)));
+            if (!proj_equal(C0, C1)) ok = 0;
+            tested++;
+        }
+    }
+    TEST_ASSERT(tested > 0 && ok, "yRADICAL matches repeated Velu steps for every radical l_i");
+#else
+    printf("  RADICAL_MAX_L = 0，未启用（make params PARAMS_ARGS=\"... -r 7\"）\n");
+#endif
+}
+
+void test_csurf_isogenies(void) {
+    printf("\n=== CSURF 2-同源测试 ===\n");
+#if CSURF
+    // [2]^e 与奇数次同源交换（每个方向、最小的几个 l_i），+1 与 -1 互逆，+2 等于两次 +1。
+    // 起点同样用 y² = x³ + x
+    proj A, C0, C1, K, Pk[(LARGE_L >> 1) + 1];
+    const uint8_t i2 = N - 1, plus1 = 3, minus1 = 2, plus2 = 5;
+    fp_copy(&A[0], fp_one());
+    fp_copy(&A[1], fp_small(2));
+
+    yCSURF(C0, A, i2, plus1);
+    yCSURF(C1, C0, i2, minus1);
+    int inverse_ok = proj_equal(C1, A) && !proj_equal(C0, A);
+    yCSURF(C1, C0, i2, plus1);
+    yCSURF(C0, A, i2, plus2);
+    int double_ok = proj_equal(C0, C1);
+
+    int commute_ok = 1;
+    for (uint8_t i = N - 4; i < N - 1; i++) {
+        uint64_t k[4];
+        __uint128_t carry = 1, rem = 0;
+        for (int w = 0; w < 4; w++) {
+            carry += p.limbs[w];
+            k[w] = (uint64_t)carry;
+            carry >>= 64;
+        }
+        for (int w = 3; w >= 0; w--) {
+            __uint128_t cur = (rem << 64) | k[w];
+            k[w] = (uint64_t)(cur / L[i]);
+            rem = cur % L[i];
+        }
+        for (uint8_t square = 0; square < 2; square++) {
+            // 先走 l_i 再走 2
+            radical_kernel(K, A, k, square);
+            yISOG(Pk, C0, K, A, i);
+            yCSURF(C0, C0, i2, plus1);
+            // 先走 2 再走 l_i（同一方向）
+            yCSURF(C1, A, i2, plus1);
+            radical_kernel(K, C1, k, square);
+            yISOG(Pk, C1, K, C1, i);
+            if (!proj_equal(C0, C1)) commute_ok = 0;
+        }
+    }
+    TEST_ASSERT(inverse_ok, "yCSURF +1 and -1 are inverse 2-isogeny walks");
+    TEST_ASSERT(double_ok, "yCSURF with e = 2 matches two e = 1 steps");
+    TEST_ASSERT(commute_ok, "yCSURF commutes with odd-degree Velu isogenies");
+#else
+    printf("  CSURF = 0，未启用（make params 的 -l 包含 2，p = 7 mod 8）\n");
+#endif
+}
+
+void test_elligator(void) {
+    printf("\n=== Elligator测试 ===\n");
+
+    // E0: y^2 = x^3 + x，Edwards形式 (a : a - d) = (1 : 2)，Montgomery系数 A = 0
+    proj E0;
+    fp_copy(&E0[0], fp_one());
+    fp_copy(&E0[1], fp_small(2));
+
+    // A = 0 时必须取 alpha = u：否则 T+ / T- 都是2-挠点，乘4后是无穷远点
+    int alive = 1;
+    for (int it = 0; it < 16; it++) {
+        proj T[2];
+        elligator(T[1], T[0], E0);
+        for (int s = 0; s < 2; s++) {
+            yDBL(T[s], T[s], E0);
+            yDBL(T[s], T[s], E0);
+            if (isinfinity(T[s])) alive = 0;
+        }
+    }
+    TEST_ASSERT(alive, "Elligator points on E0 are not killed by [4]");
+
+    // 多缓冲Elligator：有一个通道不从公共曲线E出发时不用预计算表，E0 通道走 mb_elligator
+    uint8_t keys[8][N];
+    const uint8_t *key_ptrs[8];
+    proj A[8], C[8], C1;
+    random_key(keys[0]);
+    action_evaluation(A[0], keys[0], E0);
+    for (int j = 0; j < 8; j++) {
+        random_key(keys[j]);
+        key_ptrs[j] = keys[j];
+        if (j > 0) point_copy(A[j], E0);
+    }
+    action_evaluation_x8(C, key_ptrs, A);
+    int match = 1;
+    for (int j = 0; j < 8; j++) {
+        action_evaluation(C1, keys[j], A[j]);
+        if (!areEqual(C1, C[j])) match = 0;
+    }
+    TEST_ASSERT(match, "Multi-buffer Elligator on E0 agrees with the scalar action");
+}
+
+void test_torsion_table(void) {
+    printf("\n=== 公共曲线E预计算扭点测试 ===\n");
+
+    // 表只对E生效：射影缩放后的E仍然匹配，其他曲线不匹配
+    proj E2, F;
+    fp_add(&E2[0], &E[0], &E[0]);
+    fp_add(&E2[1], &E[1], &E[1]);
+    point_copy(F, E);
+    fp_add(&F[0], &F[0], &E[1]);
+    TEST_ASSERT(has_precomputed_torsion(E) && has_precomputed_torsion(E2) && !has_precomputed_torsion(F),
+                "Precomputed torsion table applies exactly to the base curve E");
+
+    // 每个批次的 T+ / T- 都不是无穷远点，且对批次中的每个 l_i 都有完整阶
+    int order_ok = 1;
+    for (uint8_t m = 0; m < NUMBER_OF_BATCHES; m++) {
+        proj T[2];
+        precomputed_torsion(T[1], T[0], m);
+        for (int s = 0; s < 2; s++) {
+            for (int skip = 0; skip < SIZE_OF_EACH_BATCH[m]; skip++) {
+                proj Q;
+                point_copy(Q, T[s]);
+                for (int j = 0; j < SIZE_OF_EACH_BATCH[m]; j++) {
+                    if (j != skip) yMUL(Q, Q, E, BATCHES[m][j]);
+                }
+                if (isinfinity(Q)) order_ok = 0;
+            }
+        }
+    }
+    TEST_ASSERT(order_ok, "Precomputed torsion points have full order for every l_i of their batch");
+
+    // 多缓冲路径从E出发同样使用表，结果与标量实现一致
+    uint8_t keys[8][N];
+    const uint8_t *key_ptrs[8];
+    proj A[8], C[8], C1;
+    for (int j = 0; j < 8; j++) {
+        random_key(keys[j]);
+        key_ptrs[j] = keys[j];
+        point_copy(A[j], E);
+    }
+    action_evaluation_x8(C, key_ptrs, A);
+    int match = 1;
+    for (int j = 0; j < 8; j++) {
+        action_evaluation(C1, keys[j], E);
+        if (!areEqual(C1, C[j])) match = 0;
+    }
+    TEST_ASSERT(match, "Key generation from E (scalar and multi-buffer) agrees with the table");
+}
+
+void test_params_consistency(void) {
+    printf("\n=== 参数集一致性测试 ===\n");
+
+    // 按 yMUL 的规则执行差分加法链：(a, b, a + b) 从 (1, 2, 3) 开始
+    int chain_ok = 1, bits_ok = 1;
+    for (int i = 0; i < N; i++) {
+        int bits = 0;
+        for (uint32_t l = L[i]; l > 0; l >>= 1) bits++;
+        if (bits != BITS_OF_L[i]) bits_ok = 0;
+        if (L[i] == 2) continue;    // CSURF 的 l = 2 没有差分加法链
+        uint64_t a = 1, b = 2, c = 3, tmp = ADDITION_CHAIN[i];
+        for (int j = 0; j < ADDITION_CHAIN_LENGTH[i]; j++) {
+            if (tmp & 1) {
+                b = c;
+            } else {
+                a = b;
+                b = c;
+            }
+            c = a + b;
+            tmp >>= 1;
+        }
+        if (c != L[i]) chain_ok = 0;
+    }
+    TEST_ASSERT(chain_ok, "ADDITION_CHAIN[i] computes [L[i]]P");
+    TEST_ASSERT(bits_ok, "BITS_OF_L matches L");
+
+    // 每个 l_i 恰好属于一个批次（根式同源的 l_i 不属于任何批次），补集与批次互补（CSURF 的 l = 2 两边都不在）
+    int seen[N] = {0}, batch_ok = 1;
+    uint32_t isogenies = 0;
+    for (int k = 0; k < NUMBER_OF_BATCHES; k++) {
+        for (int j = 0; j < SIZE_OF_EACH_BATCH[k]; j++) {
+            seen[BATCHES[k][j]]++;
+        }
+        if (LAST_ISOGENY[k] != BATCHES[k][SIZE_OF_EACH_BATCH[k] - 1]) batch_ok = 0;
+        if (SIZE_OF_EACH_BATCH[k] + SIZE_OF_EACH_COMPLEMENT_BATCH[k] + CSURF != N) batch_ok = 0;
+        for (int j = 0; j < SIZE_OF_EACH_COMPLEMENT_BATCH[k]; j++) {
+            uint8_t c = COMPLEMENT_OF_EACH_BATCH[k][j];
+            for (int t = 0; t < SIZE_OF_EACH_BATCH[k]; t++) {
+                if (BATCHES[k][t] == c) batch_ok = 0;
+            }
+        }
+    }
+    for (int i = 0; i < N; i++) {
+        if (seen[i] != (RADICAL[i] ? 0 : 1)) batch_ok = 0;
+        if (!RADICAL[i]) isogenies += (uint32_t)B[i];
+    }
+    TEST_ASSERT(batch_ok, "SIMBA batches partition L and complements match");
+    TEST_ASSERT(isogenies == NUMBER_OF_ISOGENIES, "NUMBER_OF_ISOGENIES = sum of B");
+
+    // 分组余因子链的乘积恰好是初始补集中所有 l_i 的乘积（每个 l_i 用一次）
+    int cofactor_ok = 1;
+    for (int k = 0; k < NUMBER_OF_BATCHES; k++) {
+        int used[N] = {0};
+        for (int t = 0; t < NUMBER_OF_COFACTOR_CHAINS[k]; t++) {
+            uint64_t a = 1, b = 2, c = 3, tmp = COFACTOR_CHAIN[k][t];
+            for (int j = 0; j < COFACTOR_CHAIN_LENGTH[k][t]; j++) {
+                if (tmp & 1) {
+                    b = c;
+                } else {
+                    a = b;
+                    b = c;
+                }
+                c = a + b;
+                tmp >>= 1;
+            }
+            for (int j = 0; j < SIZE_OF_EACH_COMPLEMENT_BATCH[k]; j++) {
+                uint8_t li = COMPLEMENT_OF_EACH_BATCH[k][j];
+                if (!used[li] && c % L[li] == 0) {
+                    c /= L[li];
+                    used[li] = 1;
+                }
+            }
+            if (c != 1) cofactor_ok = 0;
+        }
+        for (int j = 0; j < SIZE_OF_EACH_COMPLEMENT_BATCH[k]; j++) {
+            if (!used[COMPLEMENT_OF_EACH_BATCH[k][j]]) cofactor_ok = 0;
+        }
+    }
+    TEST_ASSERT(cofactor_ok, "COFACTOR_CHAIN products cover each complement exactly once");
+
+    // 每个批次的策略按群作用的顺序遍历：每个区间 [lo, hi) 的划分在 1..hi-lo-1 之内，恰好用掉 n-1 项
+    int strategy_ok = 1;
+    for (int k = 0; k < NUMBER_OF_BATCHES; k++) {
+        int n = SIZE_OF_EACH_BATCH[k], used = 0, top = 0;
+        int lo[N], hi[N];
+        lo[0] = 0;
+        hi[0] = n;
+        while (top >= 0) {
+            if (hi[top] - lo[top] == 1) {
+                int leaf = lo[top];
+                top--;
+                if (top >= 0) lo[top] = leaf + 1;
+                continue;
+            }
+            int s = STRATEGY_OF_EACH_BATCH[k][used++];
+            if (s < 1 || s >= hi[top] - lo[top]) {
+                strategy_ok = 0;
+                break;
+            }
+            lo[top + 1] = lo[top];
+            hi[top + 1] = lo[top] + s;
+            top++;
+        }
+        if (used != n - 1) strategy_ok = 0;
+    }
+    TEST_ASSERT(strategy_ok, "STRATEGY_OF_EACH_BATCH is a valid preorder of splits");
 }
 
 // ==================== 单步Isogeny测试 ====================
@@ -138,12 +1247,8 @@ void test_single_isogeny(void) {
         init_montgomery_field();
     }
     
-    extern proj E;
-    static bool E_initialized = false;
-    if (!E_initialized) {
-        init_public_curve();
-        E_initialized = true;
-    }
+    extern const proj E;
+    init_public_curve();
     
     // 测试: 验证公共曲线E是超奇异曲线
     TEST_ASSERT(validate(E) == 1, "Public curve E is supersingular");
@@ -157,7 +1262,7 @@ void test_single_isogeny(void) {
         fp_random(&P[0]);
     }
     set_zero(&P[1]);
-    fp_add(&P[1], &P[1], &R_mod_p);
+    fp_add(&P[1], &P[1], fp_one());
     
     // 测试: yDBL (点倍乘)
     yDBL(Q, P, E);
@@ -183,12 +1288,8 @@ void test_kat_vectors(void) {
         init_montgomery_field();
     }
     
-    extern proj E;
-    static bool E_initialized = false;
-    if (!E_initialized) {
-        init_public_curve();
-        E_initialized = true;
-    }
+    extern const proj E;
+    init_public_curve();
     
     // 测试: 使用固定密钥进行CSIDH计算，验证结果一致性
     uint8_t fixed_key[N];
@@ -204,10 +1305,101 @@ void test_kat_vectors(void) {
     // 结果应该相同（确定性）
     TEST_ASSERT(areEqual(result1, result2) == 1, 
                 "Deterministic CSIDH action produces same result");
+
+    // 随机密钥把E移到另一条曲线（E 奇异时同源的像仍是E）
+    uint8_t key[N];
+    random_key(key);
+    action_evaluation(result1, key, E);
+    TEST_ASSERT(!areEqual(result1, E), "Action with a random key moves E");
     
     printf("  注意: 完整的KAT向量需要与官方CSIDH实现对比\n");
 }
 
+// ==================== 多线程并发测试 ====================
+
+typedef struct {
+    const uint8_t *key;
+    proj result;
+    uint64_t mul_count;
+} action_job;
+
+static void *action_thread(void *arg) {
+    action_job *job = (action_job*)arg;
+    FP_MUL_COMPUTED = 0;
+    action_evaluation(job->result, job->key, E);
+    job->mul_count = FP_MUL_COMPUTED;
+    return NULL;
+}
+
+void test_thread_safety(void) {
+    printf("\n=== 多线程并发测试 ===\n");
+    
+    init_public_curve();
+    
+    uint8_t fixed_key[N];
+    memset(fixed_key, 0, N);
+    fixed_key[0] = 1;
+    
+    proj expected;
+    action_evaluation(expected, fixed_key, E);
+    
+    // 两个线程同时计算同一个群作用，计数器各自独立
+    FP_MUL_COMPUTED = 0;
+    action_job jobs[2];
+    pthread_t threads[2];
+    int started = 1;
+    for (int t = 0; t < 2; t++) {
+        jobs[t].key = fixed_key;
+        jobs[t].mul_count = 0;
+        if (pthread_create(&threads[t], NULL, action_thread, &jobs[t]) != 0) started = 0;
+    }
+    TEST_ASSERT(started, "pthread_create succeeds");
+    if (!started) return;
+    for (int t = 0; t < 2; t++) {
+        pthread_join(threads[t], NULL);
+    }
+    uint64_t main_mul_count = FP_MUL_COMPUTED;
+    
+    TEST_ASSERT(areEqual(jobs[0].result, expected) && areEqual(jobs[1].result, expected),
+                "Concurrent action_evaluation matches sequential result");
+    TEST_ASSERT(jobs[0].mul_count > 0 && jobs[1].mul_count > 0 && main_mul_count == 0,
+                "Field operation counters are per-thread");
+    
+    // 工作线程池批量计算：结果与顺序计算一致
+    csidh_job batch[5];
+    for (int i = 0; i < 5; i++) {
+        batch[i].key = fixed_key;
+        batch[i].seed = NULL;
+        point_copy(batch[i].in, E);
+    }
+    size_t batch_ok = csidh_batch_derive(batch, 5, 2);
+    int batch_match = (batch_ok == 5);
+    for (int i = 0; i < 5; i++) {
+        if (!batch[i].ok || !areEqual(batch[i].out, expected)) batch_match = 0;
+    }
+    TEST_ASSERT(batch_match, "csidh_batch_derive (2 threads) matches sequential result");
+    csidh_batch_shutdown();
+    
+    // 多缓冲群作用：每个通道与标量 action_evaluation 一致（不支持IFMA时为标量回退）
+    uint8_t mb_keys[8][N];
+    const uint8_t *mb_key_ptrs[8];
+    proj mb_in[8], mb_out[8];
+    for (int i = 0; i < 8; i++) {
+        random_key(mb_keys[i]);
+        mb_key_ptrs[i] = mb_keys[i];
+        point_copy(mb_in[i], E);
+    }
+    action_evaluation_x8(mb_out, mb_key_ptrs, (const proj *)mb_in);
+    int mb_match = 1;
+    for (int i = 0; i < 8; i++) {
+        proj ref;
+        action_evaluation(ref, mb_keys[i], mb_in[i]);
+        if (!areEqual(ref, mb_out[i])) mb_match = 0;
+    }
+    printf("  多缓冲实现: %s\n", action_evaluation_mb_name());
+    TEST_ASSERT(mb_match, "action_evaluation_x8 matches scalar action_evaluation per lane");
+}
+
 // ==================== 主测试函数 ====================
 
 int main() {
@@ -224,9 +1416,26 @@ int main() {
     
     // 运行测试
     test_field_operations();
+    test_field_backend();
+    test_exponent_chains();
+    test_safegcd();
     test_montgomery_conversion();
+    test_baked_constants();
+    test_params_consistency();
+    test_prime_search();
+    test_drbg();
+    test_seed_keys();
+    test_elligator();
+    test_torsion_table();
+    test_dual_point_kernels();
+    test_velu_pair();
+    test_action_reference();
+    test_specialized_isogenies();
+    test_radical_isogenies();
+    test_csurf_isogenies();
     test_single_isogeny();
     test_kat_vectors();
+    test_thread_safety();
     
     // 输出结果
     printf("\n=================================================================\n");
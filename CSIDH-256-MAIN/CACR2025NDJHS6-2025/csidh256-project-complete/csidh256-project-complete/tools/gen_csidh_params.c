@@ -0,0 +1,962 @@
+// 参数集生成器：由素数 p 和小素数列表 l_i 生成 src/params.h 与 src/csidh256_params.h
+// （L、B、BITS_OF_L、最短差分加法链、l 次幂的加法链、SIMBA批次、补集等全部由程序计算），
+// 之后 make 会据新的 params.h 重新生成 src/fp256_constants.h（Montgomery常量）。
+//
+// 用法: make params PARAMS_ARGS="..."
+//       gen_csidh_params.exe [-p 十六进制p] [-l l1,l2,...] [-b 边界 | -b b1,b2,...]
+//                            [-m 批次数] [-y MY] [-c M,S,a] [-v l] [-s l] [-r l] [-o 输出目录]
+// 不给参数时使用当前 src/params.h 中的 p 和 PRIMES（边界5、3个批次、MY = 8，输出到 src/）。
+// -c 是群作用策略的代价模型：一次乘法、平方、加法的相对开销（make run-sqr-benchmark 会给出测量值）。
+// -v 是成对 Vélu 的交叉点：l_i >= l 时用成对 Vélu 代替 Vélu（make run-velu-pair-benchmark 会给出测量值，0 表示不用）。
+// -s 是 √élu 的交叉点：l_i >= l 时用 √élu，优先于 -v（同一个基准程序给出测量值，默认 0 不用）。
+// -r 是根式同源的上限：l_i <= l（只支持 3、5、7）不进 SIMBA 批次，由根式同源单独处理（默认 0 不用），
+//    要求这些 l_i | (p+1)/4、3 | (p+1)/4 且 p = 3 mod 8（见 src/edwards256.c）。
+// -l 可以包含 2（要求 p = 7 mod 8，不能与 -r 同用）：2-同源在曲面上用平方根走（CSURF，见 src/edwards256.c），
+//    同样不进 SIMBA 批次，也不进补集（每轮开头多做一次倍点）。
+
+#include "../src/params.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#define MAX_PRIMES 255          // 批次/补集下标是 uint8_t，N 本身用作填充值
+#define MAX_CHAIN_LENGTH 32     // yMUL 用 uint32_t 逐位读取加法链
+// 成对 Vélu 的默认交叉点：make run-velu-pair-benchmark 测得 c 后端从 l = 29 起、汇编后端从 l = 19 起成对 Vélu 更快
+#define DEFAULT_VELU_PAIR_MIN_L 29
+
+typedef struct {
+    uint64_t p[LIMBS];
+    uint32_t l[MAX_PRIMES];     // 降序
+    int8_t b[MAX_PRIMES];
+    int n;
+    int batches;
+    int my;
+    double cost_m, cost_s, cost_a;
+    uint32_t velu_pair_min_l;
+    uint32_t velu_sqrt_min_l;
+    uint32_t radical_max_l;
+    uint64_t cofactor[LIMBS];   // k = (p + 1) / (4 * ∏ l_i)，只除去整除 (p+1)/4 的 l_i
+    const char *out_dir;
+} param_set;
+
+// ==================== 最短差分加法链 ====================
+// yMUL 的三元组 (R0, R1, R2) = (a, b, a + b) 从 (1, 2, 3) 开始，每一步读一位（从低位开始）：
+//   位为0：(a, b, c) -> (b, c, b + c)，差为 a
+//   位为1：(a, b, c) -> (a, c, a + c)，差为 b
+// 链长为 k 时计算 [l]P 需要 1 次 yDBL + (k + 1) 次 yADD。
+// 按长度从小到大穷举（深度优先，值超过 l 即剪枝），找到的第一条链就是最短的。
+
+static int chain_dfs(uint32_t a, uint32_t b, uint32_t c, uint32_t l, int depth, int k, uint32_t *bits) {
+    if (depth == k) {
+        return c == l;
+    }
+    if (c >= l) {
+        return 0;
+    }
+    // 剩下 k - depth 步最多增长到 Fibonacci 式的 (b, c) -> (c, b + c)
+    uint64_t x = b, y = c;
+    for (int i = depth; i < k && y < l; i++) {
+        uint64_t t = x + y;
+        x = y;
+        y = t;
+    }
+    if (y < l) {
+        return 0;
+    }
+    if (chain_dfs(b, c, b + c, l, depth + 1, k, bits)) {
+        return 1;
+    }
+    if (chain_dfs(a, c, a + c, l, depth + 1, k, bits)) {
+        *bits |= 1u << depth;
+        return 1;
+    }
+    return 0;
+}
+
+static int shortest_chain(uint32_t l, uint32_t *bits, int *length) {
+    for (int k = 0; k <= MAX_CHAIN_LENGTH; k++) {
+        *bits = 0;
+        if (chain_dfs(1, 2, 3, l, 0, k, bits)) {
+            *length = k;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// 按 yMUL 的规则执行加法链，用于自检
+static uint32_t chain_value(uint32_t bits, int length) {
+    uint32_t a = 1, b = 2, c = 3;
+    for (int j = 0; j < length; j++) {
+        if ((bits >> j) & 1) {
+            b = c;
+            c = a + c;
+        } else {
+            a = b;
+            b = c;
+            c = a + c;
+        }
+    }
+    return c;
+}
+
+// ==================== a^l 的最短加法链 ====================
+// 像曲线要计算 a^l_i 与 d^l_i（见 src/edwards256.c 的 isog_codomain）。用 star 链
+// 1 = c_0 < c_1 < ... < c_k = l，c_{t+1} = c_t + c_j（j = t 时是平方），l < 12509 时 star 链的
+// 最短长度与一般加法链相同。二进制方法需要 ⌊log2 l⌋ + popcount(l) - 1 步。
+// 按长度从小到大穷举（每步最多翻倍，剩余步数不够到达 l 即剪枝）。
+
+#define MAX_POW_CHAIN_LENGTH 24
+
+static int pow_chain_dfs(uint32_t *c, uint8_t *step, int t, int k, uint32_t l) {
+    if (t == k) {
+        return c[t] == l;
+    }
+    if (((uint64_t)c[t] << (k - t)) < l) {
+        return 0;
+    }
+    for (int j = t; j >= 0; j--) {
+        uint32_t v = c[t] + c[j];
+        if (v > l) continue;
+        c[t + 1] = v;
+        step[t] = (uint8_t)j;
+        if (pow_chain_dfs(c, step, t + 1, k, l)) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// step[t] 是第 t + 1 步的 j，返回链长，失败返回 -1
+static int pow_chain(uint32_t l, uint8_t *step) {
+    uint32_t c[MAX_POW_CHAIN_LENGTH + 1];
+    c[0] = 1;
+    for (int k = 0; k <= MAX_POW_CHAIN_LENGTH; k++) {
+        if (pow_chain_dfs(c, step, 0, k, l)) {
+            return k;
+        }
+    }
+    return -1;
+}
+
+// ==================== 补集的分组余因子链 ====================
+// 每轮开始时扭点要乘以补集中的所有 l_i，逐个 l_i 的 [l]P 各需 (链长 + 2) 次点运算。
+// 把几个 l_i 合成一个乘积 k、用 k 的最短差分加法链，有时比分开的链总共少几次 yADD
+// （起步的 yDBL + yADD 只做一次）。贪心合并：每次合并节省最多的两组，直到没有正收益。
+// 整个补集乘积上的 Montgomery 梯子每位要 1 次 yDBL + 1 次 yADD，比逐个 l_i 的链贵约 1/3，不采用。
+
+#define MAX_COFACTOR (1u << 24)     // 组内乘积的上限（链长不超过 MAX_CHAIN_LENGTH）
+
+typedef struct {
+    int n;
+    uint8_t idx[MAX_PRIMES];    // 组内 l_i 的下标
+    uint32_t value;             // 组内 l_i 的乘积
+    uint32_t chain;
+    int len;
+} cofactor_group;
+
+static int chain_for(uint32_t k, uint32_t *chain, int *len) {
+    return shortest_chain(k, chain, len) && chain_value(*chain, *len) == k;
+}
+
+// 把补集 comp[0..n) 分组，返回组数
+static int group_complement(cofactor_group *g, const param_set *ps, const uint8_t *comp, int n) {
+    int ng = n;
+    for (int i = 0; i < n; i++) {
+        g[i].n = 1;
+        g[i].idx[0] = comp[i];
+        g[i].value = ps->l[comp[i]];
+        if (!chain_for(g[i].value, &g[i].chain, &g[i].len)) return -1;
+    }
+    for (;;) {
+        int best_a = -1, best_b = -1, best_save = 0, best_len = 0;
+        uint32_t best_chain = 0;
+        for (int a = 0; a < ng; a++) {
+            for (int b = a + 1; b < ng; b++) {
+                uint64_t k = (uint64_t)g[a].value * g[b].value;
+                uint32_t chain;
+                int len;
+                if (k >= MAX_COFACTOR || !chain_for((uint32_t)k, &chain, &len)) continue;
+                int save = (g[a].len + 2) + (g[b].len + 2) - (len + 2);
+                if (save > best_save) {
+                    best_save = save;
+                    best_a = a;
+                    best_b = b;
+                    best_chain = chain;
+                    best_len = len;
+                }
+            }
+        }
+        if (best_save == 0) break;
+        cofactor_group *ga = &g[best_a], *gb = &g[best_b];
+        memcpy(&ga->idx[ga->n], gb->idx, (size_t)gb->n);
+        ga->n += gb->n;
+        ga->value *= gb->value;
+        ga->chain = best_chain;
+        ga->len = best_len;
+        memmove(gb, gb + 1, (size_t)(ng - best_b - 1) * sizeof(*gb));
+        ng--;
+    }
+    return ng;
+}
+
+// ==================== 群作用的最优策略 ====================
+// 一轮中按 l_i 从小到大做批次中的 n 个同源，第 t 个的核点是 [∏_{u>t} l_u]T±。
+// 策略把 [lo, hi) 分成 [lo, mid) 和 [mid, hi)：把 (T+, T-) 乘以 [mid, hi) 中的 l_u 后压栈处理左半，
+// 左半每次同源后栈中留下的点对要做 2 次 yEVAL 和 1 次 yMUL（另一侧的点乘以 l_t），再处理右半。
+// 左半只有一个 l_i 时只需乘选中的那个点。mid = lo + 1 恒成立时就是原来的线性做法。
+// 代价（单位：0.01 次乘法）按 yDBL / yADD / yEVAL 的运算次数和 -c 给出的 M/S/a 开销计算。
+
+static uint32_t strategy_cost(const param_set *ps, double m, double s, double a) {
+    return (uint32_t)(100.0 * (m * ps->cost_m + s * ps->cost_s + a * ps->cost_a) + 0.5);
+}
+
+// 单个点的 [l_i]P：1 次 yDBL + (链长 + 1) 次 yADD
+static uint32_t strategy_mul_cost(const param_set *ps, uint32_t chain_len) {
+    return strategy_cost(ps, 4, 2, 4) + (chain_len + 1) * strategy_cost(ps, 4, 2, 6);
+}
+
+// 成对 Vélu 的分解大小（与 src/edwards256.c 的 velu_pair_sizes 相同）：|J| = b，|I| = b'，|K| = nk
+static void velu_pair_sizes(uint32_t l, uint32_t *b, uint32_t *bp, uint32_t *nk) {
+    uint32_t t = 1;
+    while (4 * (t + 1) * (t + 1) <= l - 1) t++;
+    *b = t;
+    *bp = (l - 1) / (4 * t);
+    *nk = (l - 1 - 4 * t * (*bp)) / 2;
+}
+
+static int uses_velu_sqrt(const param_set *ps, uint32_t l) {
+    return ps->velu_sqrt_min_l != 0 && l >= ps->velu_sqrt_min_l && l >= 5;
+}
+
+static int uses_velu_pair(const param_set *ps, uint32_t l) {
+    return !uses_velu_sqrt(ps, l) && ps->velu_pair_min_l != 0 && l >= ps->velu_pair_min_l && l >= 5;
+}
+
+// √élu 的乘法次数（与 src/edwards256.c 的 sqrt_poly_product / sqrt_multieval 的划分相同）：
+// n 个 c 项因子的平衡乘积树，以及在 n 个叶子的首一乘积树上对 k0、k1 项的两个多项式取余
+static double velu_sqrt_product_mul(uint32_t n, uint32_t c) {
+    if (n == 1) return 0;
+    uint32_t m = n >> 1;
+    return velu_sqrt_product_mul(m, c) + velu_sqrt_product_mul(n - m, c) +
+           (double)(m * (c - 1) + 1) * ((n - m) * (c - 1) + 1);
+}
+
+static double velu_sqrt_multieval_mul(uint32_t k0, uint32_t k1, uint32_t n) {
+    double r = (k0 > n ? (double)(k0 - n) * n : 0) + (k1 > n ? (double)(k1 - n) * n : 0);
+    if (n == 1) return r;
+    k0 = k0 < n ? k0 : n;
+    k1 = k1 < n ? k1 : n;
+    uint32_t m = n >> 1;
+    return r + velu_sqrt_multieval_mul(k0, k1, m) + velu_sqrt_multieval_mul(k0, k1, n - m);
+}
+
+// 单个点的 yEVAL（s = (l - 1) / 2）、yEVAL_pair（每一对 5M，K 中每个点 4M）
+// 或 yEVAL_sqrt（每个 J 5M，E_J 的乘积树，余式树，每个 I 3M，K 中每个点 4M）
+static uint32_t strategy_eval_cost(const param_set *ps, uint32_t l) {
+    uint32_t s = l >> 1;
+    if (uses_velu_sqrt(ps, l)) {
+        uint32_t b, bp, nk;
+        velu_pair_sizes(l, &b, &bp, &nk);
+        double m = 5.0 * b + velu_sqrt_product_mul(b, 3) + velu_sqrt_multieval_mul(b + 1, b, bp) + 3.0 * bp;
+        return strategy_cost(ps, m + 4.0 * nk + 6, 4, m + 2.0 * bp + 2.0 * nk + 9);
+    }
+    if (uses_velu_pair(ps, l)) {
+        uint32_t b, bp, nk;
+        velu_pair_sizes(l, &b, &bp, &nk);
+        return strategy_cost(ps, 5.0 * b * bp + 4.0 * nk + 3, 4, 3.0 * b * bp + 2.0 * nk + 9);
+    }
+    return strategy_cost(ps, 4.0 * s, 2, 2.0 * s + 4);
+}
+
+// primes 按处理顺序排列；strategy 得到先序排列的 mid - lo（n - 1 项），返回总代价
+static uint64_t optimal_strategy(uint8_t *strategy, const uint32_t *mul, const uint32_t *eval, int n) {
+    static uint64_t cost[MAX_PRIMES + 1][MAX_PRIMES + 1];
+    static uint8_t split[MAX_PRIMES + 1][MAX_PRIMES + 1];
+    for (int len = 2; len <= n; len++) {
+        for (int lo = 0; lo + len <= n; lo++) {
+            int hi = lo + len;
+            uint64_t best = UINT64_MAX, right = 0, left = 0;
+            for (int u = lo + 1; u < hi; u++) right += mul[u];
+            for (int mid = lo + 1; mid < hi; mid++) {
+                left += 2 * (uint64_t)eval[mid - 1] + mul[mid - 1];
+                uint64_t c = ((mid - lo == 1) ? 1 : 2) * right + left + cost[lo][mid] + cost[mid][hi];
+                if (c < best) {
+                    best = c;
+                    split[lo][hi] = (uint8_t)(mid - lo);
+                }
+                right -= mul[mid];
+            }
+            cost[lo][hi] = best;
+        }
+    }
+    // 先序展开：[lo, hi) 的 split，然后左半 [lo, mid)，然后右半 [mid, hi)
+    int stack_lo[MAX_PRIMES], stack_hi[MAX_PRIMES], top = 0, k = 0;
+    stack_lo[0] = 0;
+    stack_hi[0] = n;
+    while (top >= 0) {
+        int lo = stack_lo[top], hi = stack_hi[top--];
+        if (hi - lo < 2) continue;
+        int mid = lo + split[lo][hi];
+        strategy[k++] = split[lo][hi];
+        stack_lo[++top] = mid;
+        stack_hi[top] = hi;
+        stack_lo[++top] = lo;
+        stack_hi[top] = mid;
+    }
+    return n > 1 ? cost[0][n] : 0;
+}
+
+// ==================== 参数解析 ====================
+
+static int parse_hex_prime(uint64_t p[LIMBS], const char *s) {
+    if (s[0] == '0' && (s[1] == 'x' || s[1] == 'X')) s += 2;
+    size_t len = strlen(s);
+    if (len == 0 || len > 16 * LIMBS) return 0;
+    memset(p, 0, LIMBS * sizeof(uint64_t));
+    for (size_t i = 0; i < len; i++) {
+        char ch = s[len - 1 - i];
+        uint64_t d;
+        if (ch >= '0' && ch <= '9') d = (uint64_t)(ch - '0');
+        else if (ch >= 'a' && ch <= 'f') d = (uint64_t)(ch - 'a' + 10);
+        else if (ch >= 'A' && ch <= 'F') d = (uint64_t)(ch - 'A' + 10);
+        else return 0;
+        p[i / 16] |= d << (4 * (i % 16));
+    }
+    return 1;
+}
+
+// 逗号分隔的整数列表，返回个数（出错返回 -1）
+static int parse_list(long *out, int max, const char *s) {
+    int n = 0;
+    while (*s) {
+        char *end;
+        long v = strtol(s, &end, 10);
+        if (end == s || n >= max) return -1;
+        out[n++] = v;
+        s = end;
+        if (*s == ',') s++;
+        else if (*s) return -1;
+    }
+    return n;
+}
+
+static int cmp_desc(const void *x, const void *y) {
+    uint32_t a = *(const uint32_t *)x, b = *(const uint32_t *)y;
+    return (a < b) - (a > b);
+}
+
+static int is_small_prime(uint32_t l) {
+    if (l < 3 || (l & 1) == 0) return 0;
+    for (uint32_t d = 3; d * d <= l; d += 2) {
+        if (l % d == 0) return 0;
+    }
+    return 1;
+}
+
+// q = (p + 1) / 4
+static void p_plus_1_quarter(uint64_t q[LIMBS], const uint64_t p[LIMBS]) {
+    uint64_t carry = 1;
+    for (int i = 0; i < LIMBS; i++) {
+        q[i] = p[i] + carry;
+        carry = (q[i] < carry);
+    }
+    for (int i = 0; i < LIMBS; i++) {
+        uint64_t next = (i + 1 < LIMBS) ? q[i + 1] : carry;
+        q[i] = (q[i] >> 2) | (next << 62);
+    }
+}
+
+// q = q / l，返回余数
+static uint32_t div_small(uint64_t q[LIMBS], uint32_t l) {
+    unsigned __int128 r = 0;
+    for (int i = LIMBS - 1; i >= 0; i--) {
+        r = (r << 64) | q[i];
+        q[i] = (uint64_t)(r / l);
+        r %= l;
+    }
+    return (uint32_t)r;
+}
+
+// ((p + 1) / 4) mod l
+static uint32_t p_plus_1_quarter_mod(const uint64_t p[LIMBS], uint32_t l) {
+    uint64_t q[LIMBS];
+    p_plus_1_quarter(q, p);
+    return div_small(q, l);
+}
+
+static int bit_length(uint64_t x) {
+    int n = 0;
+    while (x) {
+        n++;
+        x >>= 1;
+    }
+    return n;
+}
+
+static int prime_bits(const uint64_t p[LIMBS]) {
+    for (int i = LIMBS - 1; i >= 0; i--) {
+        if (p[i]) return 64 * i + bit_length(p[i]);
+    }
+    return 0;
+}
+
+// ==================== 输出 ====================
+
+static void emit_u32_table(FILE *f, const char *decl, const uint32_t *v, int n, const char *fmt) {
+    fprintf(f, "%s = {\n", decl);
+    for (int i = 0; i < n; i++) {
+        if (i % 8 == 0) fprintf(f, "    ");
+        fprintf(f, fmt, v[i]);
+        fprintf(f, "%s", (i + 1 == n) ? "\n" : (i % 8 == 7) ? ",\n" : ", ");
+    }
+    fprintf(f, "};\n");
+}
+
+static FILE *open_output(char *path, size_t size, const char *dir, const char *name) {
+    snprintf(path, size, "%s/%s", dir, name);
+    FILE *f = fopen(path, "w");
+    if (f == NULL) perror(path);
+    return f;
+}
+
+static int write_params_h(const param_set *ps, int n_bad) {
+    char path[1024];
+    FILE *f = open_output(path, sizeof(path), ps->out_dir, "params.h");
+    if (f == NULL) return 0;
+
+    fprintf(f, "#ifndef PARAMS_H\n#define PARAMS_H\n\n#include <stdint.h>\n\n");
+    fprintf(f, "// 由 tools/gen_csidh_params.c 生成（make params），修改参数请重新运行生成器\n\n");
+    fprintf(f, "// CSIDH-256 参数（比 512 简单很多）\n#define LIMBS 4  // 256 / 64 = 4\n\n");
+    fprintf(f, "typedef struct {\n    uint64_t limbs[LIMBS];\n} bigint256;\n\n");
+    fprintf(f, "// ============================================================================\n");
+    fprintf(f, "// 自定义CSIDH-256 素数 p（非官方标准参数）\n");
+    fprintf(f, "// ============================================================================\n");
+    fprintf(f, "// 警告：此素数p是自定义选择，不是官方CSIDH标准素数\n");
+    fprintf(f, "//\n");
+    fprintf(f, "// 官方CSIDH使用经过充分验证的素数，满足严格的安全要求\n");
+    if (n_bad == 0) {
+        fprintf(f, "// 此自定义素数p满足基本条件：p+1能被所有小素数l_i整除\n");
+    } else {
+        fprintf(f, "// 注意：此素数p不满足 l_i | (p+1)/4（%d个l_i不满足，见 csidh256_params.h）\n", n_bad);
+    }
+    fprintf(f, "// 但未经过完整的安全验证，不建议用于生产环境\n");
+    fprintf(f, "//\n");
+    fprintf(f, "// 如需标准CSIDH参数，请参考官方实现\n");
+    fprintf(f, "// ============================================================================\n");
+    fprintf(f, "static const uint64_t CSIDH256_P[4] = {\n");
+    for (int i = 0; i < LIMBS; i++) {
+        fprintf(f, "    0x%016llX%s\n", (unsigned long long)ps->p[i], (i + 1 < LIMBS) ? "," : "");
+    }
+    fprintf(f, "};\n\n");
+    fprintf(f, "// 验证函数：检查p+1是否能被l整除\n");
+    fprintf(f, "// 这个函数在运行时验证参数的正确性\n\n");
+    fprintf(f, "// 小素数列表（%d个，升序）\n#define NUM_PRIMES %d\n", ps->n, ps->n);
+    fprintf(f, "static const int PRIMES[NUM_PRIMES] = {\n");
+    for (int i = 0; i < ps->n; i++) {
+        if (i % 15 == 0) fprintf(f, "    ");
+        fprintf(f, "%u", ps->l[ps->n - 1 - i]);
+        fprintf(f, "%s", (i + 1 == ps->n) ? "\n" : (i % 15 == 14) ? ",\n" : ", ");
+    }
+    fprintf(f, "};\n\n#endif\n");
+    return fclose(f) == 0;
+}
+
+// 根式同源（和 CSURF 的 l = 2）处理的 l_i 是 L 末尾（最小）的若干个，只有前 ns 个进 SIMBA 批次
+static int simba_primes(const param_set *ps) {
+    int ns = ps->n;
+    while (ns > 0 && (ps->l[ns - 1] <= ps->radical_max_l || ps->l[ns - 1] == 2)) ns--;
+    return ns;
+}
+
+static int has_csurf(const param_set *ps) {
+    return ps->n > 0 && ps->l[ps->n - 1] == 2;
+}
+
+static int write_csidh_params_h(const param_set *ps, const uint32_t *bad_l, int n_bad) {
+    const int n = ps->n, m = ps->batches, ns = simba_primes(ps), csurf = has_csurf(ps);
+    uint32_t bits_of_l[MAX_PRIMES], chain[MAX_PRIMES], chain_len[MAX_PRIMES], bounds[MAX_PRIMES];
+    int total_chain = 0;
+    for (int i = 0; i < n; i++) {
+        int len;
+        bits_of_l[i] = (uint32_t)bit_length(ps->l[i]);
+        bounds[i] = (uint32_t)ps->b[i];
+        // l = 2 没有差分加法链（链从 [3]P 开始），也用不到：它不在任何批次和补集中
+        if (ps->l[i] == 2) {
+            chain[i] = 0;
+            chain_len[i] = 0;
+            continue;
+        }
+        if (!shortest_chain(ps->l[i], &chain[i], &len) || chain_value(chain[i], len) != ps->l[i]) {
+            fprintf(stderr, "gen_csidh_params: l = %u 没有长度 <= %d 的差分加法链\n", ps->l[i], MAX_CHAIN_LENGTH);
+            return 0;
+        }
+        chain_len[i] = (uint32_t)len;
+        total_chain += len;
+    }
+
+    int log2_n1 = 0;
+    while ((1 << log2_n1) < n + 1) log2_n1++;
+    // 4 * sqrt(p) 的位数：floor(2 + log2(p) / 2) + 1
+    int pbits = prime_bits(ps->p);
+    double top = (double)ps->p[(pbits - 1) / 64] * ldexp(1.0, 64 * ((pbits - 1) / 64));
+    int bits_4sqrt = (int)floor(2.0 + 0.5 * log2(top)) + 1;
+    uint32_t number_of_isogenies = 0;
+    for (int i = 0; i < ns; i++) number_of_isogenies += (uint32_t)ps->b[i];
+
+    char path[1024];
+    FILE *f = open_output(path, sizeof(path), ps->out_dir, "csidh256_params.h");
+    if (f == NULL) return 0;
+
+    fprintf(f, "#ifndef CSIDH256_PARAMS_H\n#define CSIDH256_PARAMS_H\n\n");
+    fprintf(f, "#include \"params.h\"\n#include <stdint.h>\n\n");
+    fprintf(f, "// ============================================================================\n");
+    fprintf(f, "// 自定义CSIDH参数定义（非官方标准参数）\n");
+    fprintf(f, "// 由 tools/gen_csidh_params.c 生成（make params），不要手工修改\n");
+    fprintf(f, "// ============================================================================\n");
+    fprintf(f, "// 警告：此实现使用自定义参数集，不是官方CSIDH标准参数\n");
+    fprintf(f, "// 安全性未经过充分验证，建议在生产环境使用前进行安全审计\n");
+    if (n_bad > 0) {
+        fprintf(f, "//\n// 注意：p 不满足 l_i | (p+1)/4 的小素数（%d个）：", n_bad);
+        for (int i = 0; i < n_bad; i++) {
+            fprintf(f, "%s%u", i ? ", " : "", bad_l[i]);
+        }
+        fprintf(f, "\n// 对这些 l_i 群作用没有意义，双方的共享密钥不会一致\n");
+    }
+    fprintf(f, "// ============================================================================\n\n");
+
+    fprintf(f, "#define N %d  // Number of small primes l_i such that l_i | [(p+1)/4]\n", n);
+    fprintf(f, "#define NUMBER_OF_WORDS 4  // 256 / 64 = 4 words\n");
+    fprintf(f, "#define LOG2_OF_N_PLUS_ONE %d\n\n", log2_n1);
+
+    fprintf(f, "// 小素数列表 L（%d个，按降序排列）\n", n);
+    emit_u32_table(f, "static const uint32_t L[]", ps->l, n, "%3u");
+    fprintf(f, "\n// 边界 B（每个l_i对应的最大指数）\n");
+    emit_u32_table(f, "static const int8_t B[]", bounds, n, "%2u");
+    fprintf(f, "\n// 每个l_i的位数\n");
+    emit_u32_table(f, "static const uint16_t BITS_OF_L[]", bits_of_l, n, "%u");
+
+    fprintf(f, "\n#define BITS_OF_4SQRT_OF_P %d  // 4*sqrt(p) 的位数\n", bits_4sqrt);
+    fprintf(f, "#define LARGE_L %u  // 最大的l_i\n\n", ps->l[0]);
+    // 余因子：Elligator 点的阶整除 p + 1 = 4 * ∏ l_i * k，只乘 4 和 l_i 的补集时还剩 k-部分，
+    // 核点的阶就不是 l_i；群作用、多缓冲群作用和预计算扭点都用 yMUL_cofactor 再乘以 k
+    fprintf(f, "// 余因子 k = (p+1) / (4 * ∏ l_i)：扭点乘以 4 和补集后还要乘以 k（yMUL_cofactor，k = 1 时不乘）\n");
+    fprintf(f, "#define COFACTOR_BITS %d\n", prime_bits(ps->cofactor));
+    fprintf(f, "static const uint64_t COFACTOR[NUMBER_OF_WORDS] = { ");
+    for (int i = 0; i < LIMBS; i++) {
+        fprintf(f, "%s0x%llX", i ? ", " : "", (unsigned long long)ps->cofactor[i]);
+    }
+    fprintf(f, " };\n\n");
+
+    fprintf(f, "// 最短差分加法链（yMUL 从 (P, [2]P, [3]P) 开始逐位读取，低位在前，见 tools/gen_csidh_params.c）\n");
+    fprintf(f, "// 共 %d 步，每个 [l_i]P 需要 1 次 yDBL + (长度 + 1) 次 yADD\n", total_chain);
+    fprintf(f, "static const uint64_t ADDITION_CHAIN[] = {\n");
+    for (int i = 0; i < n; i++) {
+        if (i % 8 == 0) fprintf(f, "    ");
+        char word[24];
+        snprintf(word, sizeof(word), "0x%X", chain[i]);
+        fprintf(f, "%s", word);
+        if (i + 1 == n) fprintf(f, "\n");
+        else if (i % 8 == 7) fprintf(f, ",\n");
+        else fprintf(f, ",%*s", (int)(7 - strlen(word)), "");
+    }
+    fprintf(f, "};\n\n");
+    fprintf(f, "// 每个加法链的长度\n");
+    emit_u32_table(f, "static const uint8_t ADDITION_CHAIN_LENGTH[]", chain_len, n, "%2u");
+
+    // 像曲线的 l 次幂：每个 l_i 一条固定的加法链，和 FOR_EACH_L 一起用来展开逐 l_i 特化的同源
+    int pow_total = 0, pow_binary = 0;
+    fprintf(f, "\n// 像曲线中 a^l_i、d^l_i 的最短加法链（见 tools/gen_csidh_params.c）：POW_CHAIN_<l>(STEP) 展开为\n");
+    fprintf(f, "// STEP(k, j)，即 t_k = t_{k-1} * t_j（j = k - 1 时是平方），t_0 为底数，结果是 t_{POW_CHAIN_LENGTH_<l>}\n");
+    for (int i = 0; i < n; i++) {
+        uint8_t step[MAX_POW_CHAIN_LENGTH];
+        int len = pow_chain(ps->l[i], step);
+        if (len < 0) {
+            fprintf(stderr, "gen_csidh_params: l = %u 没有长度 <= %d 的加法链\n", ps->l[i], MAX_POW_CHAIN_LENGTH);
+            fclose(f);
+            return 0;
+        }
+        int ones = 0;
+        for (uint32_t x = ps->l[i]; x; x >>= 1) ones += x & 1;
+        pow_total += len;
+        pow_binary += bit_length(ps->l[i]) - 1 + ones - 1;
+        fprintf(f, "#define POW_CHAIN_LENGTH_%u %d\n#define POW_CHAIN_%u(STEP)", ps->l[i], len, ps->l[i]);
+        for (int t = 0; t < len; t++) {
+            fprintf(f, " STEP(%d, %u)", t + 1, step[t]);
+        }
+        fprintf(f, "\n");
+    }
+    fprintf(f, "// 共 %d 步（二进制方法为 %d 步）\n\n", pow_total, pow_binary);
+    fprintf(f, "// 逐 l_i 展开 X(下标, l_i)：src/edwards256.c 用它生成 l 为编译期常量的同源函数与分派表\n");
+    fprintf(f, "#define FOR_EACH_L(X)");
+    for (int i = 0; i < n; i++) {
+        fprintf(f, "%s X(%d, %u)", (i % 8 == 0) ? " \\\n   " : "", i, ps->l[i]);
+    }
+    fprintf(f, "\n");
+
+    // SIMBA：第 j 个 l_i 放进第 j mod m 个批次，批次0最大；根式同源的 l_i（j >= ns）不进批次，
+    // 但在每个批次的补集里（扭点总要乘掉它们）；l = 2 不在补集里，由每轮开头的倍点乘掉
+    fprintf(f, "\n// SIMBA参数（用于批处理同源计算）\n");
+    fprintf(f, "#define NUMBER_OF_BATCHES %d\n#define MY %d\n\n", m, ps->my);
+    fprintf(f, "// 批处理配置\n");
+    int size[MAX_PRIMES];
+    for (int k = 0; k < m; k++) {
+        size[k] = 0;
+        fprintf(f, "static const uint8_t BATCH_%d[] = { ", k);
+        for (int j = k; j < ns; j += m) {
+            fprintf(f, "%s%d", size[k] ? ", " : "", j);
+            size[k]++;
+        }
+        fprintf(f, " };\n");
+    }
+    fprintf(f, "\nstatic const uint8_t SIZE_OF_EACH_BATCH[NUMBER_OF_BATCHES] = {");
+    for (int k = 0; k < m; k++) fprintf(f, "%s%d", k ? ", " : "", size[k]);
+    fprintf(f, "};\nstatic const uint8_t *BATCHES[NUMBER_OF_BATCHES] = { ");
+    for (int k = 0; k < m; k++) fprintf(f, "%sBATCH_%d", k ? ", " : "", k);
+    fprintf(f, " };\n\n");
+    fprintf(f, "static const uint8_t LAST_ISOGENY[NUMBER_OF_BATCHES] = { ");
+    for (int k = 0; k < m; k++) fprintf(f, "%s%d", k ? ", " : "", k + m * (size[k] - 1));
+    fprintf(f, " };\n");
+    fprintf(f, "static const uint16_t NUMBER_OF_ISOGENIES = %u;  // sum of all B[i]%s\n\n", number_of_isogenies,
+            ns < n ? "（不含根式同源的 l_i）" : "");
+
+    fprintf(f, "// 每个批次的补集（不在该批次中的l_i）\n");
+    fprintf(f, "static const uint8_t SIZE_OF_EACH_COMPLEMENT_BATCH[NUMBER_OF_BATCHES] = {");
+    for (int k = 0; k < m; k++) fprintf(f, "%s%d", k ? ", " : "", n - size[k] - csurf);
+    fprintf(f, "};\n");
+    fprintf(f, "static const uint8_t COMPLEMENT_OF_EACH_BATCH[NUMBER_OF_BATCHES][N] = {\n");
+    for (int k = 0; k < m; k++) {
+        fprintf(f, "    // BATCH_%d的补集\n    {", k);
+        int col = 0;
+        for (int j = 0; j < n; j++) {
+            if ((j % m == k && j < ns) || ps->l[j] == 2) continue;
+            fprintf(f, "%s%s%d", col ? "," : "", (col && col % 24 == 0) ? "\n      " : " ", j);
+            col++;
+        }
+        for (int j = col; j < n; j++) {
+            fprintf(f, "%s%sN", col ? "," : "", (col && col % 24 == 0) ? "\n      " : " ");
+            col++;
+        }
+        fprintf(f, " }%s\n", (k + 1 < m) ? "," : "");
+    }
+    fprintf(f, "};\n\n");
+
+    // 初始补集的分组余因子链；之后补集末尾追加的（已做完的）l_i 仍用 yMUL 逐个乘
+    static cofactor_group groups[MAX_PRIMES][MAX_PRIMES];
+    int n_groups[MAX_PRIMES];
+    fprintf(f, "// 初始补集的分组余因子乘法：乘积的最短差分加法链（yMUL_chain），见 tools/gen_csidh_params.c\n");
+    for (int k = 0; k < m; k++) {
+        uint8_t comp[MAX_PRIMES];
+        int nc = 0, single = 0, grouped = 0;
+        for (int j = 0; j < n; j++) {
+            if ((j % m != k || j >= ns) && ps->l[j] != 2) {
+                comp[nc++] = (uint8_t)j;
+                single += (int)chain_len[j] + 2;
+            }
+        }
+        n_groups[k] = group_complement(groups[k], ps, comp, nc);
+        if (n_groups[k] < 0) {
+            fprintf(stderr, "gen_csidh_params: 补集 %d 的分组失败\n", k);
+            fclose(f);
+            return 0;
+        }
+        fprintf(f, "// BATCH_%d的补集：", k);
+        int printed = 0;
+        for (int t = 0; t < n_groups[k]; t++) {
+            grouped += groups[k][t].len + 2;
+            if (groups[k][t].n < 2) continue;
+            fprintf(f, "%s", printed++ ? ", " : "");
+            for (int u = 0; u < groups[k][t].n; u++) {
+                fprintf(f, "%s%u", u ? "*" : "", ps->l[groups[k][t].idx[u]]);
+            }
+        }
+        fprintf(f, "%s，%d 次点运算（逐个 l_i 为 %d 次）\n", printed ? "" : "不分组", grouped, single);
+    }
+    fprintf(f, "static const uint8_t NUMBER_OF_COFACTOR_CHAINS[NUMBER_OF_BATCHES] = {");
+    for (int k = 0; k < m; k++) fprintf(f, "%s%d", k ? ", " : "", n_groups[k]);
+    fprintf(f, "};\n");
+    fprintf(f, "static const uint32_t COFACTOR_CHAIN[NUMBER_OF_BATCHES][N] = {\n");
+    for (int k = 0; k < m; k++) {
+        fprintf(f, "    {");
+        for (int t = 0; t < n; t++) {
+            fprintf(f, "%s%s0x%X", t ? "," : "", (t && t % 8 == 0) ? "\n      " : " ",
+                    t < n_groups[k] ? groups[k][t].chain : 0);
+        }
+        fprintf(f, " }%s\n", (k + 1 < m) ? "," : "");
+    }
+    fprintf(f, "};\n");
+    fprintf(f, "static const uint8_t COFACTOR_CHAIN_LENGTH[NUMBER_OF_BATCHES][N] = {\n");
+    for (int k = 0; k < m; k++) {
+        fprintf(f, "    {");
+        for (int t = 0; t < n; t++) {
+            fprintf(f, "%s%s%d", t ? "," : "", (t && t % 24 == 0) ? "\n      " : " ",
+                    t < n_groups[k] ? groups[k][t].len : 0);
+        }
+        fprintf(f, " }%s\n", (k + 1 < m) ? "," : "");
+    }
+    fprintf(f, "};\n\n");
+
+    // 成对 Vélu：交叉点以上的 l_i 用 yISOG_pair / yEVAL2_pair
+    uint32_t velu_pair[MAX_PRIMES] = {0};
+    for (int i = 0; i < n; i++) velu_pair[i] = (uint32_t)uses_velu_pair(ps, ps->l[i]);
+    fprintf(f, "// 成对 Vélu（见 src/edwards256.c）：l_i >= VELU_PAIR_MIN_L 时用 yISOG_pair / yEVAL2_pair 代替 Vélu，\n");
+    fprintf(f, "// 交叉点由 make run-velu-pair-benchmark 测出（0 表示全部用 Vélu）\n");
+    fprintf(f, "#define VELU_PAIR_MIN_L %u\n", ps->velu_pair_min_l);
+    emit_u32_table(f, "static const uint8_t VELU_PAIR[]", velu_pair, n, "%u");
+    fprintf(f, "\n");
+
+    // √élu：交叉点以上的 l_i 用 yISOG_sqrt / yEVAL2_sqrt；VELU_SQRT_MAX_B 是全部 l_i >= 5 中 |I|、|J| 的最大值
+    uint32_t velu_sqrt[MAX_PRIMES] = {0}, max_b = 1;
+    for (int i = 0; i < n; i++) {
+        velu_sqrt[i] = (uint32_t)uses_velu_sqrt(ps, ps->l[i]);
+        if (ps->l[i] >= 5) {
+            uint32_t b, bp, nk;
+            velu_pair_sizes(ps->l[i], &b, &bp, &nk);
+            if (b > max_b) max_b = b;
+            if (bp > max_b) max_b = bp;
+        }
+    }
+    fprintf(f, "// √élu（见 src/edwards256.c）：l_i >= VELU_SQRT_MIN_L 时用 yISOG_sqrt / yEVAL2_sqrt，优先于成对 Vélu，\n");
+    fprintf(f, "// 交叉点由 make run-velu-pair-benchmark 测出（0 表示不用）\n");
+    fprintf(f, "#define VELU_SQRT_MIN_L %u\n", ps->velu_sqrt_min_l);
+    fprintf(f, "#define VELU_SQRT_MAX_B %u\n", max_b);
+    emit_u32_table(f, "static const uint8_t VELU_SQRT[]", velu_sqrt, n, "%u");
+    fprintf(f, "\n");
+
+    // 根式同源：l_i <= RADICAL_MAX_L 的 l_i 不进批次，群作用最后逐个用根式同源链处理
+    uint32_t radical[MAX_PRIMES] = {0};
+    for (int i = ns; i < n; i++) radical[i] = 1;
+    fprintf(f, "// 根式同源（见 src/edwards256.c）：l_i <= RADICAL_MAX_L 的 l_i 不参与 SIMBA 批次，\n");
+    fprintf(f, "// 由 action_radical 在群作用最后用 B[i] 次 l 次方根处理（0 表示不用）\n");
+    fprintf(f, "#define RADICAL_MAX_L %u\n", ns < n - csurf ? ps->radical_max_l : 0);
+    emit_u32_table(f, "static const uint8_t RADICAL[]", radical, n, "%u");
+    fprintf(f, "\n// CSURF（见 src/edwards256.c）：L 的最后一项是 2（p = 7 mod 8），action_radical 在曲面上\n");
+    fprintf(f, "// 用平方根走 2-同源；扭点的2-部分是 8，每轮开头多做一次倍点（0 表示不用）\n");
+    fprintf(f, "#define CSURF %d\n\n", csurf);
+
+    // 群作用策略：代价表供运行时为部分完成的批次重新求策略，完整批次的策略预先算好
+    uint32_t mul_cost[MAX_PRIMES], eval_cost[MAX_PRIMES];
+    for (int i = 0; i < n; i++) {
+        mul_cost[i] = strategy_mul_cost(ps, chain_len[i]);
+        eval_cost[i] = strategy_eval_cost(ps, ps->l[i]);
+    }
+    fprintf(f, "// 群作用的最优策略（见 tools/gen_csidh_params.c），代价模型 M : S : a = 1 : %.2f : %.2f，单位 0.01M\n",
+            ps->cost_s / ps->cost_m, ps->cost_a / ps->cost_m);
+    fprintf(f, "// 单个点的 yMUL 与 yEVAL 的代价\n");
+    emit_u32_table(f, "static const uint32_t STRATEGY_MUL_COST[]", mul_cost, n, "%5u");
+    emit_u32_table(f, "static const uint32_t STRATEGY_EVAL_COST[]", eval_cost, n, "%5u");
+    fprintf(f, "\n// 完整批次（l_i 从小到大处理）的策略：先序排列的左半大小\n");
+    uint8_t strategies[MAX_PRIMES][MAX_PRIMES];
+    for (int k = 0; k < m; k++) {
+        uint32_t mul[MAX_PRIMES], eval[MAX_PRIMES];
+        int t = 0;
+        for (int j = k + m * (size[k] - 1); j >= 0; j -= m) {
+            mul[t] = mul_cost[j];
+            eval[t] = eval_cost[j];
+            t++;
+        }
+        // 对照：原来的线性做法（l_i 从大到小，每个核点从 T± 重新乘）
+        uint64_t linear = 0;
+        for (int u = 0; u + 1 < size[k]; u++) {
+            uint64_t tail = 0;
+            for (int v = 0; v < size[k] - 1 - u; v++) tail += mul[v];
+            linear += tail + 2 * (uint64_t)eval[size[k] - 1 - u] + mul[size[k] - 1 - u];
+        }
+        uint64_t best = optimal_strategy(strategies[k], mul, eval, size[k]);
+        fprintf(f, "// BATCH_%d：%llu（从大到小的线性做法为 %llu）\n", k,
+                (unsigned long long)best, (unsigned long long)linear);
+    }
+    fprintf(f, "static const uint8_t STRATEGY_OF_EACH_BATCH[NUMBER_OF_BATCHES][N] = {\n");
+    for (int k = 0; k < m; k++) {
+        fprintf(f, "    {");
+        for (int t = 0; t < n; t++) {
+            fprintf(f, "%s%s%d", t ? "," : "", (t && t % 24 == 0) ? "\n      " : " ",
+                    t < size[k] - 1 ? strategies[k][t] : 0);
+        }
+        fprintf(f, " }%s\n", (k + 1 < m) ? "," : "");
+    }
+    fprintf(f, "};\n\n#endif // CSIDH256_PARAMS_H\n");
+    return fclose(f) == 0;
+}
+
+// ==================== 主程序 ====================
+
+static void usage(const char *prog) {
+    fprintf(stderr,
+            "用法: %s [-p 十六进制p] [-l l1,l2,...] [-b 边界 | -b b1,b2,...] [-m 批次数] [-y MY] [-c M,S,a] [-v l] [-s l] [-r l] [-o 输出目录]\n"
+            "  默认使用 src/params.h 中的 p 和 PRIMES，边界 5，3 个批次，MY = 8，代价 1,0.8,0.15，成对 Vélu 交叉点 %u，\n"
+            "  不用 √élu 和根式同源，输出到 src/；l 列表包含 2 时用 CSURF 走2-同源\n",
+            prog, DEFAULT_VELU_PAIR_MIN_L);
+}
+
+int main(int argc, char *argv[]) {
+    static param_set ps;
+    memcpy(ps.p, CSIDH256_P, sizeof(ps.p));
+    ps.n = NUM_PRIMES;
+    for (int i = 0; i < NUM_PRIMES; i++) ps.l[i] = (uint32_t)PRIMES[i];
+    ps.batches = 3;
+    ps.my = 8;
+    // 默认代价：make run-sqr-benchmark 在 c 后端测得 S/M ≈ 0.86、a/M ≈ 0.14，汇编后端 0.74 / 0.15
+    ps.cost_m = 1.0;
+    ps.cost_s = 0.8;
+    ps.cost_a = 0.15;
+    ps.velu_pair_min_l = DEFAULT_VELU_PAIR_MIN_L;
+    ps.out_dir = "src";
+    long bounds[MAX_PRIMES];
+    int n_bounds = 1;
+    bounds[0] = 5;
+
+    for (int i = 1; i < argc; i++) {
+        const char *arg = argv[i];
+        if (arg[0] != '-' || arg[1] == '\0' || arg[2] != '\0' || i + 1 >= argc) {
+            usage(argv[0]);
+            return 1;
+        }
+        const char *val = argv[++i];
+        long tmp[MAX_PRIMES];
+        int cnt;
+        switch (arg[1]) {
+        case 'p':
+            if (!parse_hex_prime(ps.p, val)) {
+                fprintf(stderr, "gen_csidh_params: 无效的 p: %s\n", val);
+                return 1;
+            }
+            break;
+        case 'l':
+            cnt = parse_list(tmp, MAX_PRIMES, val);
+            if (cnt <= 0) {
+                fprintf(stderr, "gen_csidh_params: 无效的 l 列表\n");
+                return 1;
+            }
+            ps.n = cnt;
+            for (int k = 0; k < cnt; k++) {
+                if (tmp[k] <= 0 || tmp[k] > 0xFFFF || (tmp[k] != 2 && !is_small_prime((uint32_t)tmp[k]))) {
+                    fprintf(stderr, "gen_csidh_params: l = %ld 不是素数\n", tmp[k]);
+                    return 1;
+                }
+                ps.l[k] = (uint32_t)tmp[k];
+            }
+            break;
+        case 'b':
+            n_bounds = parse_list(bounds, MAX_PRIMES, val);
+            if (n_bounds <= 0) {
+                fprintf(stderr, "gen_csidh_params: 无效的边界列表\n");
+                return 1;
+            }
+            break;
+        case 'm':
+            ps.batches = atoi(val);
+            break;
+        case 'y':
+            ps.my = atoi(val);
+            break;
+        case 'c':
+            if (sscanf(val, "%lf,%lf,%lf", &ps.cost_m, &ps.cost_s, &ps.cost_a) != 3 ||
+                ps.cost_m <= 0 || ps.cost_s <= 0 || ps.cost_a <= 0) {
+                fprintf(stderr, "gen_csidh_params: 无效的代价模型 %s（格式 M,S,a）\n", val);
+                return 1;
+            }
+            break;
+        case 'v':
+            ps.velu_pair_min_l = (uint32_t)strtoul(val, NULL, 10);
+            break;
+        case 's':
+            ps.velu_sqrt_min_l = (uint32_t)strtoul(val, NULL, 10);
+            break;
+        case 'r':
+            ps.radical_max_l = (uint32_t)strtoul(val, NULL, 10);
+            break;
+        case 'o':
+            ps.out_dir = val;
+            break;
+        default:
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    // L 按降序排列，不允许重复
+    qsort(ps.l, (size_t)ps.n, sizeof(ps.l[0]), cmp_desc);
+    for (int i = 1; i < ps.n; i++) {
+        if (ps.l[i] == ps.l[i - 1]) {
+            fprintf(stderr, "gen_csidh_params: l = %u 重复\n", ps.l[i]);
+            return 1;
+        }
+    }
+    if (n_bounds != 1 && n_bounds != ps.n) {
+        fprintf(stderr, "gen_csidh_params: 边界个数 (%d) 与 l 的个数 (%d) 不一致\n", n_bounds, ps.n);
+        return 1;
+    }
+    // 边界列表与降序排列后的 L 一一对应
+    for (int i = 0; i < ps.n; i++) {
+        long b = bounds[n_bounds == 1 ? 0 : i];
+        if (b < 0 || b > 127) {
+            fprintf(stderr, "gen_csidh_params: 边界 %ld 超出范围 [0, 127]\n", b);
+            return 1;
+        }
+        ps.b[i] = (int8_t)b;
+    }
+    if (ps.radical_max_l > 7) {
+        fprintf(stderr, "gen_csidh_params: 根式同源只支持 l = 3, 5, 7（-r 须 <= 7）\n");
+        return 1;
+    }
+    int ns = simba_primes(&ps);
+    if (ps.batches < 1 || ps.batches > ns || ps.my < 1) {
+        fprintf(stderr, "gen_csidh_params: 批次数须在 [1, N]（不含根式同源的 l_i），MY 须为正数\n");
+        return 1;
+    }
+
+    // 域运算要求 p = 3 mod 4 且 4p < 2^256（冗余表示和乘积和的余量）
+    int pbits = prime_bits(ps.p);
+    if ((ps.p[0] & 3) != 3 || pbits > 254 || pbits < 64) {
+        fprintf(stderr, "gen_csidh_params: 要求 p = 3 mod 4 且 p < 2^254（当前 %d 位）\n", pbits);
+        return 1;
+    }
+
+    uint32_t bad_l[MAX_PRIMES];
+    int n_bad = 0;
+    for (int i = 0; i < ps.n; i++) {
+        if (p_plus_1_quarter_mod(ps.p, ps.l[i]) != 0) bad_l[n_bad++] = ps.l[i];
+    }
+    if (n_bad > 0) {
+        fprintf(stderr, "gen_csidh_params: 警告：%d 个 l_i 不整除 (p+1)/4（已写入头文件注释）\n", n_bad);
+    }
+
+    // 余因子 k：(p+1)/4 除去每个整除它的 l_i（各一次）
+    p_plus_1_quarter(ps.cofactor, ps.p);
+    for (int i = 0; i < ps.n; i++) {
+        uint64_t q[LIMBS];
+        memcpy(q, ps.cofactor, sizeof(q));
+        if (div_small(q, ps.l[i]) == 0) memcpy(ps.cofactor, q, sizeof(q));
+    }
+
+    // CSURF：曲面上的2-同源要求有理的2-挠点全部存在、扭点的2-部分是 8，即 p = 7 mod 8
+    int csurf = has_csurf(&ps);
+    if (csurf && ((ps.p[0] & 7) != 7 || ps.radical_max_l > 0)) {
+        fprintf(stderr, "gen_csidh_params: l = 2（CSURF）要求 p = 7 mod 8，且不能与 -r 同用\n");
+        return 1;
+    }
+
+    // 根式同源：l 次方根唯一要求 l | p + 1；从 Tate 正规形换回 Montgomery 形时要在 F_p 中解三次方程
+    // （唯一的立方根要求 3 | p + 1）并取唯一的有理2-挠点（p = 3 mod 8）
+    if (ns < ps.n - csurf) {
+        for (int i = ns; i < ps.n; i++) {
+            if (p_plus_1_quarter_mod(ps.p, ps.l[i]) != 0) {
+                fprintf(stderr, "gen_csidh_params: 根式同源要求 l = %u 整除 (p+1)/4\n", ps.l[i]);
+                return 1;
+            }
+        }
+        if (p_plus_1_quarter_mod(ps.p, 3) != 0 || (ps.p[0] & 7) != 3) {
+            fprintf(stderr, "gen_csidh_params: 根式同源要求 3 | (p+1)/4 且 p = 3 mod 8\n");
+            return 1;
+        }
+    }
+
+    if (!write_params_h(&ps, n_bad) || !write_csidh_params_h(&ps, bad_l, n_bad)) {
+        return 1;
+    }
+    printf("已生成 %s/params.h 和 %s/csidh256_params.h（N = %d，p 为 %d 位，余因子 k 为 %d 位）\n",
+           ps.out_dir, ps.out_dir, ps.n, pbits, prime_bits(ps.cofactor));
+    return 0;
+}
@@ -0,0 +1,364 @@
+// 域常量生成器：由 src/params.h 中的素数 p 计算库用到的全部常量，
+// 写成 src/fp256_constants.h 中的初始化宏，库本身不再需要运行时初始化。
+// 用法: make src/fp256_constants.h（params.h 改变时自动重新生成）
+//       gen_fp256_constants.exe <输出文件>
+//
+// R、R^2 按定义用模加倍得到（2^256 mod p、2^512 mod p），不经过Montgomery约简。
+
+#include "mont_field.h"
+#include "fp256_chain.h"
+#include <stdio.h>
+#include <string.h>
+
+#define M62 (UINT64_MAX >> 2)
+#define M52 ((1ULL << 52) - 1)
+
+// Montgomery形式的小整数 0..FP256_MONT_SMALL_COUNT-1
+#define MONT_SMALL_COUNT 16
+
+// a = 2a mod p
+static void double_mod(bigint256 *a, const bigint256 *p) {
+    bigint256 t;
+    bigint_add(&t, a, a);
+    if (bigint_compare(&t, p) >= 0) {
+        bigint_sub(&t, &t, p, p);
+    }
+    *a = t;
+}
+
+// a = a + b mod p（a, b < p）
+static void add_mod(bigint256 *a, const bigint256 *b, const bigint256 *p) {
+    bigint256 t;
+    bigint_add(&t, a, b);
+    if (bigint_compare(&t, p) >= 0) {
+        bigint_sub(&t, &t, p, p);
+    }
+    *a = t;
+}
+
+// 2^k mod p
+static void pow2_mod(bigint256 *r, int k, const bigint256 *p) {
+    memset(r, 0, sizeof(*r));
+    r->limbs[0] = 1;
+    for (int i = 0; i < k; i++) {
+        double_mod(r, p);
+    }
+}
+
+static void shift_right(bigint256 *r, const bigint256 *a, int s) {
+    for (int i = 0; i < LIMBS; i++) {
+        uint64_t next = (i + 1 < LIMBS) ? a->limbs[i + 1] : 0;
+        r->limbs[i] = (a->limbs[i] >> s) | (s ? next << (64 - s) : 0);
+    }
+}
+
+// Barrett 常数 mu = floor(2^512 / p)：逐位长除法（p > 2^192 时 mu 不超过5个字）
+static int barrett_mu(uint64_t mu[5], const bigint256 *p) {
+    uint64_t q[9] = {0};
+    bigint256 r;
+    memset(&r, 0, sizeof(r));
+    for (int i = 512; i >= 0; i--) {
+        bigint_add(&r, &r, &r);
+        r.limbs[0] |= (i == 512);
+        if (bigint_compare(&r, p) >= 0) {
+            bigint_sub(&r, &r, p, p);
+            q[i / 64] |= 1ULL << (i % 64);
+        }
+    }
+    for (int i = 5; i < 9; i++) {
+        if (q[i] != 0) return 0;
+    }
+    memcpy(mu, q, 5 * sizeof(uint64_t));
+    return 1;
+}
+
+static void split52(uint64_t w[5], const bigint256 *x) {
+    w[0] = x->limbs[0] & M52;
+    w[1] = ((x->limbs[0] >> 52) | (x->limbs[1] << 12)) & M52;
+    w[2] = ((x->limbs[1] >> 40) | (x->limbs[2] << 24)) & M52;
+    w[3] = ((x->limbs[2] >> 28) | (x->limbs[3] << 36)) & M52;
+    w[4] = x->limbs[3] >> 16;
+}
+
+static void emit_words(FILE *f, const uint64_t *w, int n) {
+    for (int i = 0; i < n; i++) {
+        fprintf(f, "%s0x%016llXULL", i ? ", " : "", (unsigned long long)w[i]);
+    }
+}
+
+static void emit_fp(FILE *f, const char *name, const char *comment, const bigint256 *x) {
+    fprintf(f, "// %s\n#define %s \\\n    {{ ", comment, name);
+    emit_words(f, x->limbs, LIMBS);
+    fprintf(f, " }}\n\n");
+}
+
+static void emit_words_macro(FILE *f, const char *name, const char *comment, const uint64_t *w, int n) {
+    fprintf(f, "// %s\n#define %s \\\n    { ", comment, name);
+    emit_words(f, w, n);
+    fprintf(f, " }\n\n");
+}
+
+// 汇编 .quad 用的字列表（不带 ULL 后缀，也不带花括号）
+static void emit_quads(FILE *f, const char *name, const char *comment, const uint64_t *w, int n) {
+    fprintf(f, "// %s\n#define %s \\\n    ", comment, name);
+    for (int i = 0; i < n; i++) {
+        fprintf(f, "%s0x%016llx", i ? ", " : "", (unsigned long long)w[i]);
+    }
+    fprintf(f, "\n\n");
+}
+
+static void emit_mb(FILE *f, const char *name, const char *comment, const bigint256 *x) {
+    uint64_t w[5];
+    split52(w, x);
+    emit_words_macro(f, name, comment, w, 5);
+}
+
+// 小 l 的 l 次方根指数：l 不整除 p - 1 时 x -> x^l 是双射，x^(1/l) = x^e，e = l^(-1) mod (p - 1)，
+// 即 k(p - 1) + 1 (k = 1..l-1) 中能被 l 整除的那个除以 l。p < 2^254，k(p - 1) + 1 不会溢出。
+// l 整除 p - 1 时返回 0（l 次方根不唯一）
+static int root_exponent(bigint256 *e, const bigint256 *p, uint32_t l) {
+    for (uint32_t k = 1; k < l; k++) {
+        uint64_t t[LIMBS];
+        __uint128_t carry = 1;  // k(p - 1) + 1 = kp - (k - 1)
+        for (int i = 0; i < LIMBS; i++) {
+            carry += (__uint128_t)p->limbs[i] * k;
+            t[i] = (uint64_t)carry;
+            carry >>= 64;
+        }
+        __uint128_t borrow = k;
+        for (int i = 0; i < LIMBS; i++) {
+            __uint128_t d = (__uint128_t)t[i] - borrow;
+            t[i] = (uint64_t)d;
+            borrow = (d >> 64) & 1;
+        }
+        __uint128_t rem = 0;
+        for (int i = LIMBS - 1; i >= 0; i--) {
+            __uint128_t cur = (rem << 64) | t[i];
+            e->limbs[i] = (uint64_t)(cur / l);
+            rem = cur % l;
+        }
+        if (rem == 0) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static int emit_chain(FILE *f, const char *name, const char *comment, const bigint256 *e) {
+    static fp_exp_chain chain;
+    if (!fp_exp_chain_build(&chain, e)) {
+        fprintf(stderr, "gen_fp256_constants: 加法链超出上限 (%s)\n", name);
+        return 0;
+    }
+    fprintf(f, "// %s：%d 次平方 + %d 次乘法\n", comment, chain.n_sqr, chain.n_mul);
+    fprintf(f, "#define %s { \\\n", name);
+    fprintf(f, "    .n_table = %d, .n_steps = %d, .result = %d, .n_mul = %d, .n_sqr = %d, \\\n",
+            chain.n_table, chain.n_steps, chain.result, chain.n_mul, chain.n_sqr);
+    fprintf(f, "    .steps = { \\\n");
+    for (int i = 0; i < chain.n_steps; i++) {
+        const fp_exp_step *st = &chain.steps[i];
+        fprintf(f, "        { %d, %d, %d, %d }, \\\n", st->dst, st->src, st->mul, st->sq);
+    }
+    fprintf(f, "    } }\n\n");
+    return 1;
+}
+
+int main(int argc, char *argv[]) {
+    if (argc != 2) {
+        fprintf(stderr, "用法: %s <输出文件>\n", argv[0]);
+        return 1;
+    }
+
+    mont_field mf;
+    mont_field_init(&mf);
+    const bigint256 *p = &mf.p;
+    if ((p->limbs[0] & 3) != 3) {
+        fprintf(stderr, "gen_fp256_constants: 要求 p = 3 mod 4\n");
+        return 1;
+    }
+
+    bigint256 two_p, R, R2, r_cubed, pm1h, e_inv, e_sqrt, one, two;
+    memset(&one, 0, sizeof(one));
+    one.limbs[0] = 1;
+    memset(&two, 0, sizeof(two));
+    two.limbs[0] = 2;
+
+    bigint_add(&two_p, p, p);
+    pow2_mod(&R, 256, p);
+    pow2_mod(&R2, 512, p);
+    shift_right(&pm1h, p, 1);
+    bigint_sub(&e_inv, p, &two, &two);
+    bigint_add(&e_sqrt, p, &one);
+    shift_right(&e_sqrt, &e_sqrt, 2);
+
+    // safegcd：p 的有符号62位字表示、p^(-1) mod 2^62、R^3 mod p
+    int64_t p62[5];
+    p62[0] = (int64_t)(p->limbs[0] & M62);
+    p62[1] = (int64_t)(((p->limbs[0] >> 62) | (p->limbs[1] << 2)) & M62);
+    p62[2] = (int64_t)(((p->limbs[1] >> 60) | (p->limbs[2] << 4)) & M62);
+    p62[3] = (int64_t)(((p->limbs[2] >> 58) | (p->limbs[3] << 6)) & M62);
+    p62[4] = (int64_t)(p->limbs[3] >> 56);
+    uint64_t inv = p->limbs[0];
+    for (int i = 0; i < 6; i++) {
+        inv *= 2 - p->limbs[0] * inv;
+    }
+    r_cubed = R;
+    for (int i = 0; i < 512; i++) {
+        double_mod(&r_cubed, p);
+    }
+
+    uint64_t mu[5];
+    if (!barrett_mu(mu, p)) {
+        fprintf(stderr, "gen_fp256_constants: 要求 p > 2^192（Barrett 常数超过5个字）\n");
+        return 1;
+    }
+
+    // 公共曲线E：y^2 = x^3 + x（Montgomery系数 A = 0）对应 Edwards 的 a = 1, d = -1，
+    // 即 (a, a - d) = (1, 2)（d = 0 时曲线奇异），乘 R^2 mod p 转入Montgomery域
+    bigint256 e_a, e_c;
+    mont_mul(&e_a, &one, &R2, &mf);
+    mont_mul(&e_c, &two, &R2, &mf);
+
+    bigint256 small[MONT_SMALL_COUNT];
+    memset(&small[0], 0, sizeof(small[0]));
+    for (int k = 1; k < MONT_SMALL_COUNT; k++) {
+        small[k] = small[k - 1];
+        add_mod(&small[k], &R, p);
+    }
+
+    bigint256 pow2_260, pow2_264, pow2_520;
+    pow2_mod(&pow2_260, 260, p);
+    pow2_mod(&pow2_264, 264, p);
+    pow2_mod(&pow2_520, 520, p);
+
+    // 先写临时文件，全部成功后再改名，避免留下半个头文件
+    char tmp_path[1024];
+    snprintf(tmp_path, sizeof(tmp_path), "%s.tmp", argv[1]);
+    FILE *f = fopen(tmp_path, "w");
+    if (f == NULL) {
+        perror(tmp_path);
+        return 1;
+    }
+
+    fprintf(f, "// 由 tools/gen_fp256_constants.c 根据 src/params.h 中的 p 生成，不要手工修改。\n");
+    fprintf(f, "// 重新生成: make src/fp256_constants.h\n");
+    fprintf(f, "#ifndef FP256_CONSTANTS_H\n#define FP256_CONSTANTS_H\n\n");
+
+    fprintf(f, "// ==================== 模数与Montgomery参数 ====================\n\n");
+    emit_fp(f, "FP256_CONST_P", "p", p);
+    emit_fp(f, "FP256_CONST_TWO_P", "2p", &two_p);
+    fprintf(f, "// mont_field（与 mont_field_init 的结果相同）\n");
+    fprintf(f, "#define FP256_CONST_MONT_FIELD { \\\n");
+    fprintf(f, "    .p = {{ ");
+    emit_words(f, mf.p.limbs, LIMBS);
+    fprintf(f, " }}, \\\n    .p_inv = {{ ");
+    emit_words(f, mf.p_inv.limbs, LIMBS);
+    fprintf(f, " }}, \\\n    .r_squared = {{ ");
+    emit_words(f, mf.r_squared.limbs, LIMBS);
+    fprintf(f, " }}, \\\n    .redc_type = %s, \\\n",
+            mf.redc_type == MONT_REDC_PSEUDO_MERSENNE ? "MONT_REDC_PSEUDO_MERSENNE" : "MONT_REDC_GENERIC");
+    fprintf(f, "    .pm_k = %u, \\\n    .pm_c = 0x%llXULL, \\\n", mf.pm_k, (unsigned long long)mf.pm_c);
+    fprintf(f, "    .p_squared_x4 = { ");
+    emit_words(f, mf.p_squared_x4, 4);
+    fprintf(f, ", \\\n                      ");
+    emit_words(f, mf.p_squared_x4 + 4, 4);
+    fprintf(f, " } }\n\n");
+    emit_fp(f, "FP256_CONST_R_MOD_P", "R = 2^256 mod p（Montgomery域中的1）", &R);
+    emit_fp(f, "FP256_CONST_R_SQUARED_MOD_P", "R^2 = 2^512 mod p（to_mont 的乘数）", &R2);
+    emit_fp(f, "FP256_CONST_P_MINUS_1_HALVES", "(p - 1) / 2", &pm1h);
+    emit_fp(f, "FP256_CONST_P_PLUS_1_QUARTERS", "(p + 1) / 4", &e_sqrt);
+
+    fprintf(f, "// Montgomery形式的小整数：FP256_CONST_MONT_SMALL[k] = k * R mod p\n");
+    fprintf(f, "#define FP256_MONT_SMALL_COUNT %d\n", MONT_SMALL_COUNT);
+    fprintf(f, "#define FP256_CONST_MONT_SMALL { \\\n");
+    for (int k = 0; k < MONT_SMALL_COUNT; k++) {
+        fprintf(f, "    {{ ");
+        emit_words(f, small[k].limbs, LIMBS);
+        fprintf(f, " }}, \\\n");
+    }
+    fprintf(f, "}\n\n");
+
+    emit_words_macro(f, "FP256_CONST_BARRETT_MU", "Barrett 常数 floor(2^512 / p)（传统模乘后端，src/traditional_mul.c）", mu, 5);
+
+    fprintf(f, "// ==================== 公共曲线E ====================\n\n");
+    fprintf(f, "// E = (a, a - d) = (1, 2)，即 y^2 = x^3 + x，Montgomery表示\n");
+    fprintf(f, "#define FP256_CONST_E { \\\n    {{ ");
+    emit_words(f, e_a.limbs, LIMBS);
+    fprintf(f, " }}, \\\n    {{ ");
+    emit_words(f, e_c.limbs, LIMBS);
+    fprintf(f, " }} }\n\n");
+
+    fprintf(f, "// ==================== 加法链（fp_inv_fermat / fp_issquare_euler / fp_sqrt）====================\n\n");
+    if (!emit_chain(f, "FP256_CONST_CHAIN_INV", "p - 2", &e_inv) ||
+        !emit_chain(f, "FP256_CONST_CHAIN_LEGENDRE", "(p - 1) / 2", &pm1h) ||
+        !emit_chain(f, "FP256_CONST_CHAIN_SQRT", "(p + 1) / 4", &e_sqrt)) {
+        fclose(f);
+        remove(tmp_path);
+        return 1;
+    }
+
+    // 根式同源（src/edwards256.c）的 l 次方根：只在 l 次方根唯一时生成，
+    // 没有生成的宏表示这个 p 不能对该 l 使用根式同源
+    fprintf(f, "// ==================== l 次方根（fp_root3 / fp_root5 / fp_root7）====================\n\n");
+    static const uint32_t ROOT_L[] = { 3, 5, 7 };
+    for (int k = 0; k < 3; k++) {
+        bigint256 e_root;
+        char name[64], comment[64];
+        if (!root_exponent(&e_root, p, ROOT_L[k])) {
+            fprintf(f, "// %u 整除 p - 1，%u 次方根不唯一，不生成 FP256_CONST_CHAIN_ROOT%u\n\n",
+                    ROOT_L[k], ROOT_L[k], ROOT_L[k]);
+            continue;
+        }
+        snprintf(name, sizeof(name), "FP256_CONST_CHAIN_ROOT%u", ROOT_L[k]);
+        snprintf(comment, sizeof(comment), "%u^(-1) mod (p - 1)", ROOT_L[k]);
+        if (!emit_chain(f, name, comment, &e_root)) {
+            fclose(f);
+            remove(tmp_path);
+            return 1;
+        }
+    }
+
+    fprintf(f, "// ==================== safegcd ====================\n\n");
+    fprintf(f, "// p 的有符号62位字表示\n#define FP256_CONST_SAFEGCD_MODULUS62 \\\n    {{ ");
+    for (int i = 0; i < 5; i++) {
+        fprintf(f, "%s%lldLL", i ? ", " : "", (long long)p62[i]);
+    }
+    fprintf(f, " }}\n\n");
+    fprintf(f, "// p^(-1) mod 2^62\n#define FP256_CONST_SAFEGCD_MODULUS_INV62 0x%016llXULL\n\n",
+            (unsigned long long)(inv & M62));
+    emit_fp(f, "FP256_CONST_SAFEGCD_R_CUBED", "R^3 mod p（普通表示）", &r_cubed);
+
+    fprintf(f, "// ==================== 多缓冲（2^52进制，5个字）====================\n\n");
+    uint64_t w[5];
+    split52(w, p);
+    emit_words_macro(f, "FP256_CONST_MB_P52", "p", w, 5);
+    split52(w, &two_p);
+    emit_words_macro(f, "FP256_CONST_MB_2P52", "2p", w, 5);
+    fprintf(f, "// -p^(-1) mod 2^52\n#define FP256_CONST_MB_PINV52 0x%013llXULL\n\n",
+            (unsigned long long)((0 - inv) & M52));
+    emit_mb(f, "FP256_CONST_MB_POW2_260", "2^260 mod p（多缓冲Montgomery域中的1）", &pow2_260);
+    emit_mb(f, "FP256_CONST_MB_POW2_264", "2^264 mod p（Montgomery标量表示 -> 多缓冲表示）", &pow2_264);
+    emit_mb(f, "FP256_CONST_MB_POW2_520", "2^520 mod p（传统标量表示 -> 多缓冲表示）", &pow2_520);
+    emit_mb(f, "FP256_CONST_MB_POW2_256", "2^256 mod p（多缓冲表示 -> Montgomery标量表示）", &R);
+    emit_mb(f, "FP256_CONST_MB_POW2_0", "1（多缓冲表示 -> 传统标量表示）", &one);
+
+    // src/fp256.S 用 C 预处理器包含本文件，这一节只能有宏
+    fprintf(f, "// ==================== 汇编后端（src/fp256.S 的 .quad 列表）====================\n\n");
+    emit_quads(f, "FP256_ASM_P", "p", p->limbs, LIMBS);
+    emit_quads(f, "FP256_ASM_2P", "2p", two_p.limbs, LIMBS);
+    emit_quads(f, "FP256_ASM_4P2", "4p^2", mf.p_squared_x4, 8);
+    emit_quads(f, "FP256_ASM_PINV", "-p^(-1) mod 2^64", mf.p_inv.limbs, 1);
+
+    fprintf(f, "#endif // FP256_CONSTANTS_H\n");
+    if (fclose(f) != 0) {
+        perror(tmp_path);
+        remove(tmp_path);
+        return 1;
+    }
+    remove(argv[1]);
+    if (rename(tmp_path, argv[1]) != 0) {
+        perror(argv[1]);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,133 @@
+// 公共曲线E的预计算扭点生成器：对每个 SIMBA 批次 m，在E上取一对 Elligator 点 T+ / T-，
+// 乘以 4、余因子 k 和该批次补集中的所有 l_i，写成 src/edwards256_torsion.h。
+// 群作用从E出发时第一轮直接使用这些点，省掉 Elligator（随机数 + 平方判定）和补集的 yMUL。
+//
+// 用法: make torsion（make params 之后自动执行）
+//       gen_torsion_points.exe <输出文件>
+//
+// 点坐标是射影的 (X : Z)，两个坐标在任何后端中都带有相同的表示因子（Montgomery 的 R 或传统的 1），
+// 所以同一张表对 c / asm / trad 后端和冗余表示都适用。
+// 随机数使用固定种子的确定性 DRBG，表是可复现的；每个批次优先选择对批次中所有 l_i
+// 都有完整阶的点（否则那一轮会跳过这些 l_i）。
+
+#include "../src/edwards256.h"
+#include "../src/rng.h"
+#include <stdio.h>
+#include <string.h>
+
+#define MAX_ATTEMPTS 256
+
+// T 乘以批次 m 中除第 skip 个以外的所有 l_i 后是否仍不是无穷远点（即 T 的阶含有 l_skip）
+static int has_full_order(const proj T, uint8_t m, int skip) {
+    proj Q;
+    point_copy(Q, T);
+    for (int j = 0; j < SIZE_OF_EACH_BATCH[m]; j++) {
+        if (j != skip) yMUL(Q, Q, E, BATCHES[m][j]);
+    }
+    return isinfinity(Q) != 1;
+}
+
+static void emit_fp(FILE *f, const fp *v) {
+    fp x_canonical;
+    const fp *x = &x_canonical;
+    fp_copy(&x_canonical, v);
+    fp_canonicalize(&x_canonical);
+    fprintf(f, "{{ 0x%016llXULL, 0x%016llXULL, 0x%016llXULL, 0x%016llXULL }}",
+            (unsigned long long)x->limbs[0], (unsigned long long)x->limbs[1],
+            (unsigned long long)x->limbs[2], (unsigned long long)x->limbs[3]);
+}
+
+int main(int argc, char *argv[]) {
+    if (argc != 2) {
+        fprintf(stderr, "用法: %s <输出文件>\n", argv[0]);
+        return 1;
+    }
+
+    uint8_t seed[RNG_SEED_BYTES];
+    memset(seed, 0, sizeof(seed));
+    memcpy(seed, "edwards256 torsion", 18);
+    rng_seed(seed);
+
+    proj table[NUMBER_OF_BATCHES][2];
+    int full[NUMBER_OF_BATCHES];
+    for (uint8_t m = 0; m < NUMBER_OF_BATCHES; m++) {
+        int best = -1;
+        for (int attempt = 0; attempt < MAX_ATTEMPTS && best < 2 * SIZE_OF_EACH_BATCH[m]; attempt++) {
+            proj T[2];
+            // 与 action_evaluation 的第一轮相同：elligator，乘以 4（CSURF 时乘以 8）和余因子 k，再乘以补集中的 l_i
+            elligator(T[1], T[0], E);
+            for (int s = 0; s < 2; s++) {
+                yDBL(T[s], T[s], E);
+                yDBL(T[s], T[s], E);
+#if CSURF
+                yDBL(T[s], T[s], E);
+#endif
+                yMUL_cofactor(T[s], T[s], E);
+                for (int i = 0; i < SIZE_OF_EACH_COMPLEMENT_BATCH[m]; i++) {
+                    yMUL(T[s], T[s], E, COMPLEMENT_OF_EACH_BATCH[m][i]);
+                }
+            }
+            int score = 0;
+            for (int s = 0; s < 2; s++) {
+                for (int j = 0; j < SIZE_OF_EACH_BATCH[m]; j++) {
+                    score += has_full_order(T[s], m, j);
+                }
+            }
+            if (score > best) {
+                best = score;
+                point_copy(table[m][0], T[0]);
+                point_copy(table[m][1], T[1]);
+            }
+        }
+        full[m] = best;
+        if (best < 2 * SIZE_OF_EACH_BATCH[m]) {
+            fprintf(stderr, "gen_torsion_points: 批次 %d 只找到 %d/%d 个完整阶的 (点, l_i) 组合\n",
+                    m, best, 2 * SIZE_OF_EACH_BATCH[m]);
+        }
+    }
+
+    char tmp_path[1024];
+    snprintf(tmp_path, sizeof(tmp_path), "%s.tmp", argv[1]);
+    FILE *f = fopen(tmp_path, "w");
+    if (f == NULL) {
+        perror(tmp_path);
+        return 1;
+    }
+
+    fprintf(f, "// 自动生成：tools/gen_torsion_points.c（make torsion），请勿手工修改\n");
+    fprintf(f, "// 公共曲线E上的预计算扭点：每个 SIMBA 批次一对 T- / T+（射影 (X : Z)），\n");
+    fprintf(f, "// 已乘以 4、余因子 k 和该批次补集中的所有 l_i，群作用从E出发时代替第一轮的 Elligator\n");
+    fprintf(f, "#ifndef EDWARDS256_TORSION_H\n#define EDWARDS256_TORSION_H\n\n");
+    fprintf(f, "// 生成时的参数：与当前参数集不一致时表不会被使用\n");
+    fprintf(f, "#define EDWARDS256_TORSION_N %d\n", N);
+    fprintf(f, "#define EDWARDS256_TORSION_BATCHES %d\n", NUMBER_OF_BATCHES);
+    fprintf(f, "static const uint64_t EDWARDS256_TORSION_P[4] = { 0x%016llXULL, 0x%016llXULL, 0x%016llXULL, 0x%016llXULL };\n\n",
+            (unsigned long long)p.limbs[0], (unsigned long long)p.limbs[1],
+            (unsigned long long)p.limbs[2], (unsigned long long)p.limbs[3]);
+    fprintf(f, "static const proj EDWARDS256_TORSION[EDWARDS256_TORSION_BATCHES][2] = {\n");
+    for (int m = 0; m < NUMBER_OF_BATCHES; m++) {
+        fprintf(f, "    // 批次 %d：完整阶的 (点, l_i) 组合 %d/%d\n", m, full[m], 2 * SIZE_OF_EACH_BATCH[m]);
+        fprintf(f, "    {\n");
+        for (int s = 0; s < 2; s++) {
+            fprintf(f, "        { ");
+            emit_fp(f, &table[m][s][0]);
+            fprintf(f, ",\n          ");
+            emit_fp(f, &table[m][s][1]);
+            fprintf(f, " }%s\n", s ? "" : ",");
+        }
+        fprintf(f, "    }%s\n", (m + 1 < NUMBER_OF_BATCHES) ? "," : "");
+    }
+    fprintf(f, "};\n\n#endif // EDWARDS256_TORSION_H\n");
+
+    if (fclose(f) != 0) {
+        perror(tmp_path);
+        remove(tmp_path);
+        return 1;
+    }
+    remove(argv[1]);
+    if (rename(tmp_path, argv[1]) != 0) {
+        perror(argv[1]);
+        return 1;
+    }
+    return 0;
+}
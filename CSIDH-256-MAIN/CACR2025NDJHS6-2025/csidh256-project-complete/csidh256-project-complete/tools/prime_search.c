@@ -0,0 +1,324 @@
+// 多线程CSIDH素数搜索：p = 4 * l_1 * ... * l_n * k - 1
+// 每个线程从共享计数器领取一块候选 k，先用小素数筛（src/prime_search.c），
+// 幸存者再做 BPSW（项目自己的4字Montgomery运算）。找到的素数按 k 排序输出，
+// 同时报告适合快速约简的形状（p+1 的2-adic阶、p 的位数余量）和吞吐量（候选数/秒/核）。
+//
+// 用法: make run-prime-search PRIME_SEARCH_ARGS="..."
+//       prime_search.exe [-l l1,l2,...] [-b 位数] [-w w] [-n 个数] [-j 线程数] [-k 起始k] [-s 秒]
+// 不给参数时使用 src/params.h 中的 PRIMES，搜索 253 位、p ≡ 3 (mod 8) 的前 8 个素数。
+// 找到的 p 可以直接交给参数集生成器：make params PARAMS_ARGS="-p <十六进制p>"。
+// k 就是参数集的余因子（csidh256_params.h 的 COFACTOR）：k > 1 时群作用每轮要把两个扭点
+// 各乘一次 k（yMUL_cofactor，每位 1 次 yDBL + 1 次 yADD），所以输出里同时报告 k 的位数。
+
+#include "../src/prime_search.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+#define MAX_PRIMES 255
+#define MAX_THREADS 256
+#define MAX_RESULTS 4096
+
+typedef struct {
+    uint64_t k;
+    bigint256 p;
+} search_result;
+
+typedef struct {
+    prime_sieve sieve;
+    uint64_t k_first;           // 第一块的起始 k（已对齐到 k_step 的剩余类）
+    uint64_t k_limit;           // m*k - 1 仍为 bits 位的最大 k + 1
+    int target;                 // 找到这么多个素数后停止（0：只按时间）
+    double deadline;            // 截止时间（0：不限）
+
+    atomic_uint_fast64_t next_block;
+    atomic_int stop;
+    atomic_uint_fast64_t candidates;    // 已检查的 k 个数
+    atomic_uint_fast64_t survivors;     // 筛后做 BPSW 的个数
+
+    pthread_mutex_t lock;
+    search_result results[MAX_RESULTS];
+    int n_results;
+} search_state;
+
+static double wall_seconds(void) {
+#ifdef _WIN32
+    LARGE_INTEGER freq, now;
+    QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&now);
+    return (double)now.QuadPart / (double)freq.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + 1e-9 * (double)ts.tv_nsec;
+#endif
+}
+
+static int num_cpus(void) {
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    int n = (int)info.dwNumberOfProcessors;
+#else
+    int n = (int)sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+    return (n > 0) ? n : 1;
+}
+
+static void *search_worker(void *arg) {
+    search_state *st = (search_state *)arg;
+    static _Thread_local uint8_t alive[PRIME_SIEVE_BLOCK];
+    const uint64_t span = (uint64_t)PRIME_SIEVE_BLOCK * st->sieve.k_step;
+
+    while (!atomic_load_explicit(&st->stop, memory_order_relaxed)) {
+        uint64_t b = atomic_fetch_add_explicit(&st->next_block, 1, memory_order_relaxed);
+        uint64_t k0 = st->k_first + b * span;
+        if (k0 >= st->k_limit || k0 < st->k_first) {
+            atomic_store_explicit(&st->stop, 1, memory_order_relaxed);
+            break;
+        }
+        int count = PRIME_SIEVE_BLOCK;
+        if ((st->k_limit - k0 + st->sieve.k_step - 1) / st->sieve.k_step < (uint64_t)count) {
+            count = (int)((st->k_limit - k0 + st->sieve.k_step - 1) / st->sieve.k_step);
+        }
+
+        prime_sieve_block(&st->sieve, k0, alive, count);
+        uint64_t tested = 0;
+        for (int i = 0; i < count; i++) {
+            if (!alive[i]) continue;
+            uint64_t k = k0 + (uint64_t)i * st->sieve.k_step;
+            bigint256 p;
+            if (!prime_sieve_candidate(&st->sieve, k, &p)) continue;
+            tested++;
+            if (!bigint_is_probable_prime(&p)) continue;
+
+            pthread_mutex_lock(&st->lock);
+            if (st->n_results < MAX_RESULTS) {
+                st->results[st->n_results].k = k;
+                st->results[st->n_results].p = p;
+                st->n_results++;
+            }
+            if (st->target > 0 && st->n_results >= st->target) {
+                atomic_store_explicit(&st->stop, 1, memory_order_relaxed);
+            }
+            pthread_mutex_unlock(&st->lock);
+        }
+        atomic_fetch_add_explicit(&st->candidates, (uint64_t)count, memory_order_relaxed);
+        atomic_fetch_add_explicit(&st->survivors, tested, memory_order_relaxed);
+        if (st->deadline > 0 && wall_seconds() >= st->deadline) {
+            atomic_store_explicit(&st->stop, 1, memory_order_relaxed);
+        }
+    }
+    return NULL;
+}
+
+static int cmp_result(const void *a, const void *b) {
+    uint64_t x = ((const search_result *)a)->k, y = ((const search_result *)b)->k;
+    return (x > y) - (x < y);
+}
+
+static int bit_length(const bigint256 *a) {
+    for (int i = LIMBS - 1; i >= 0; i--) {
+        if (a->limbs[i] != 0) return 64 * i + 64 - __builtin_clzll(a->limbs[i]);
+    }
+    return 0;
+}
+
+// p+1 的2-adic阶：p ≡ -1 (mod 2^w) 时 -p^(-1) ≡ 1 (mod 2^w)，Montgomery约简的商更便宜
+static int trailing_ones(const bigint256 *p) {
+    int w = 0;
+    for (int i = 0; i < LIMBS; i++) {
+        if (p->limbs[i] == ~0ULL) {
+            w += 64;
+            continue;
+        }
+        return w + __builtin_ctzll(~p->limbs[i]);
+    }
+    return w;
+}
+
+static void print_hex(const bigint256 *p) {
+    int started = 0;
+    for (int i = LIMBS - 1; i >= 0; i--) {
+        if (started) {
+            printf("%016llX", (unsigned long long)p->limbs[i]);
+        } else if (p->limbs[i] != 0 || i == 0) {
+            printf("%llX", (unsigned long long)p->limbs[i]);
+            started = 1;
+        }
+    }
+}
+
+// 逗号分隔的整数列表，返回个数（出错返回 -1）
+static int parse_list(long *out, int max, const char *s) {
+    int n = 0;
+    while (*s) {
+        char *end;
+        long v = strtol(s, &end, 10);
+        if (end == s || n >= max) return -1;
+        out[n++] = v;
+        s = end;
+        if (*s == ',') s++;
+        else if (*s) return -1;
+    }
+    return n;
+}
+
+static void usage(const char *prog) {
+    fprintf(stderr,
+            "用法: %s [-l l1,l2,...] [-b 位数] [-w w] [-n 个数] [-j 线程数] [-k 起始k] [-s 秒]\n"
+            "  -b  p 的位数（<= 255；默认 253，FP_LAZY 需要 p < 2^253）\n"
+            "  -w  要求 p+1 的2-adic阶恰为 w（p ≡ 2^w - 1 mod 2^(w+1)）；默认 2 即 p ≡ 3 (mod 8)，\n"
+            "      w = 3 给出 CSURF 需要的 p ≡ 7 (mod 8)，更大的 w 使 p 的低位全为1\n"
+            "  -n  找到这么多个素数后停止（默认 8；0 表示只按 -s 的时间运行，用于测吞吐量）\n"
+            "  -s  运行时间上限（秒）\n",
+            prog);
+}
+
+int main(int argc, char *argv[]) {
+    static search_state st;
+    static uint32_t l[MAX_PRIMES];
+    int n = NUM_PRIMES;
+    for (int i = 0; i < NUM_PRIMES; i++) l[i] = (uint32_t)PRIMES[i];
+    int bits = 253, w = 2, threads = num_cpus(), custom_l = 0;
+    uint64_t k_start = 0;
+    double seconds = 0;
+    st.target = 8;
+
+    for (int i = 1; i < argc; i++) {
+        const char *arg = argv[i];
+        if (arg[0] != '-' || arg[1] == '\0' || arg[2] != '\0' || i + 1 >= argc) {
+            usage(argv[0]);
+            return 1;
+        }
+        const char *val = argv[++i];
+        long tmp[MAX_PRIMES];
+        switch (arg[1]) {
+        case 'l':
+            n = parse_list(tmp, MAX_PRIMES, val);
+            if (n <= 0) {
+                fprintf(stderr, "prime_search: 无效的 l 列表\n");
+                return 1;
+            }
+            for (int k = 0; k < n; k++) {
+                if (tmp[k] < 3 || tmp[k] > 0xFFFF) {
+                    fprintf(stderr, "prime_search: 无效的 l = %ld\n", tmp[k]);
+                    return 1;
+                }
+                l[k] = (uint32_t)tmp[k];
+            }
+            custom_l = 1;
+            break;
+        case 'b': bits = atoi(val); break;
+        case 'w': w = atoi(val); break;
+        case 'n': st.target = atoi(val); break;
+        case 'j': threads = atoi(val); break;
+        case 'k': k_start = strtoull(val, NULL, 0); break;
+        case 's': seconds = atof(val); break;
+        default:
+            usage(argv[0]);
+            return 1;
+        }
+    }
+    if (bits < 16 || bits > 255 || w < 2 || w > 60 || st.target < 0 || st.target > MAX_RESULTS ||
+        (st.target == 0 && seconds <= 0)) {
+        usage(argv[0]);
+        return 1;
+    }
+    if (threads < 1) threads = 1;
+    if (threads > MAX_THREADS) threads = MAX_THREADS;
+
+    // k = 2^(w-2) * 奇数：步长 2^(w-1)，起点 ≡ 2^(w-2) (mod 2^(w-1))
+    uint64_t k_step = 1ULL << (w - 1);
+    uint64_t k_res = 1ULL << (w - 2);
+    if (!prime_sieve_init(&st.sieve, l, n, k_step)) {
+        fprintf(stderr, "prime_search: l_i 必须是奇数，且 4 * l_1 * ... * l_n 不超过 256 位\n");
+        return 1;
+    }
+    uint64_t k_lo = prime_sieve_first_k(&st.sieve, bits);
+    st.k_limit = prime_sieve_first_k(&st.sieve, bits + 1);
+    if (k_start > k_lo) k_lo = k_start;
+    st.k_first = k_lo + ((k_res - k_lo % k_step) & (k_step - 1));
+    if (st.k_first >= st.k_limit) {
+        fprintf(stderr, "prime_search: %d 位中没有满足条件的候选 k（l_i 的乘积太大或 w 太大）\n", bits);
+        return 1;
+    }
+    pthread_mutex_init(&st.lock, NULL);
+
+    printf("=== CSIDH Prime Search: p = 4 * l_1 * ... * l_%d * k - 1 ===\n\n", n);
+    printf("Target:       %d-bit p, p+1 = 2^%d * odd (p = 2^%d - 1 mod 2^%d)\n", bits, w, w, w + 1);
+    printf("k range:      [%llu, %llu), step %llu\n", (unsigned long long)st.k_first,
+           (unsigned long long)st.k_limit, (unsigned long long)k_step);
+    printf("Sieve:        %d small primes up to %u, block %d\n", st.sieve.nq,
+           st.sieve.q[st.sieve.nq - 1], PRIME_SIEVE_BLOCK);
+    printf("Threads:      %d\n\n", threads);
+
+    pthread_t tid[MAX_THREADS];
+    double t0 = wall_seconds();
+    st.deadline = (seconds > 0) ? t0 + seconds : 0;
+    int created = 0;
+    for (; created < threads; created++) {
+        if (pthread_create(&tid[created], NULL, search_worker, &st) != 0) break;
+    }
+    if (created == 0) {
+        search_worker(&st);
+    }
+    for (int i = 0; i < created; i++) pthread_join(tid[i], NULL);
+    double sec = wall_seconds() - t0;
+    if (created == 0) created = 1;
+
+    qsort(st.results, (size_t)st.n_results, sizeof(st.results[0]), cmp_result);
+    int shown = (st.target > 0 && st.n_results > st.target) ? st.target : st.n_results;
+    for (int i = 0; i < shown; i++) {
+        const bigint256 *p = &st.results[i].p;
+        int pb = bit_length(p);
+        printf("[%d] k = %llu\n    p = 0x", i, (unsigned long long)st.results[i].k);
+        print_hex(p);
+        printf("\n    %d bits, p = %d mod 8, p+1 = 2^%d * odd, headroom %d bits%s\n", pb,
+               (int)(p->limbs[0] & 7), trailing_ones(p), 256 - pb,
+               (pb <= 253) ? " (FP_LAZY / 2^52 multi-buffer ok)" : "");
+        printf("    cofactor k: %d bits%s\n", 64 - __builtin_clzll(st.results[i].k),
+               (st.results[i].k > 1) ? " (Elligator points are multiplied by k every round)" : "");
+    }
+
+    uint64_t cand = atomic_load(&st.candidates);
+    uint64_t surv = atomic_load(&st.survivors);
+    printf("\nFound %d prime(s) in %.3f s\n", shown, sec);
+    if (st.n_results > shown) {
+        printf("  (%d more in the sieve blocks already being tested when the search stopped, not shown)\n", st.n_results - shown);
+    }
+    printf("  candidates k        %12llu  (%.1f%% survive the sieve)\n", (unsigned long long)cand,
+           cand ? 100.0 * (double)surv / (double)cand : 0.0);
+    printf("  BPSW tests          %12llu\n", (unsigned long long)surv);
+    printf("  candidates/s        %12.0f  (%.0f per core)\n", (double)cand / sec,
+           (double)cand / sec / created);
+    printf("  BPSW tests/s        %12.0f  (%.0f per core)\n", (double)surv / sec,
+           (double)surv / sec / created);
+
+    if (shown > 0) {
+        printf("\n生成参数集: make params PARAMS_ARGS=\"-p ");
+        print_hex(&st.results[0].p);
+        if (custom_l) {
+            printf(" -l ");
+            for (int i = 0; i < n; i++) printf("%s%u", i ? "," : "", l[i]);
+        }
+        printf("\"\n");
+        if (st.results[0].k > 1) {
+            printf("注意：余因子 k = %llu（%d 位）> 1，make params 会生成 COFACTOR，群作用每轮多做两次 %d 位的梯子；\n"
+                   "      k = 1 要求 4 * l_1 * ... * l_n - 1 本身是素数（调整 -l 或 -b）\n",
+                   (unsigned long long)st.results[0].k, 64 - __builtin_clzll(st.results[0].k),
+                   64 - __builtin_clzll(st.results[0].k));
+        }
+    }
+    pthread_mutex_destroy(&st.lock);
+    return (st.target > 0 && st.n_results == 0) ? 1 : 0;
+}